@@ -0,0 +1,205 @@
+/**
+ * channelbench - moves the same stream of integers over one
+ * SPSC ring three ways: through the FIFO (virtual calls, and
+ * output[ "0" ] by name in the graph), through a port_handle,
+ * and through a channel. First on a bare ring from a single
+ * thread, filling and draining it in turn so nothing blocks and
+ * only the cost of the calls is measured, then in a graph with
+ * one item per run() call, which on a machine with fewer cores
+ * than kernels is mostly the cost of switching between them.
+ * Usage: channelbench [items] [repeats]
+ */
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <raft>
+
+using item_t = std::int64_t;
+
+enum class access { by_name, handle, channel };
+
+template < access A > class producer : public raft::kernel
+{
+public:
+   producer( const item_t count ) : raft::kernel(),
+                                    count( count )
+   {
+      output.addPort< item_t >( "0" );
+      h  = output.handle< item_t >( "0" );
+      ch = output.channel< item_t, Type::SPSC >( "0" );
+   }
+
+   virtual raft::kstatus run()
+   {
+      switch( A )
+      {
+         case( access::by_name ):
+            output[ "0" ].push( next );
+            break;
+         case( access::handle ):
+            h.push( next );
+            break;
+         case( access::channel ):
+            ch.push( next );
+            break;
+      }
+      next++;
+      return( next == count ? raft::stop : raft::proceed );
+   }
+
+private:
+   const item_t                           count;
+   item_t                                 next = 0;
+   raft::port_handle< item_t >            h;
+   raft::channel< item_t, Type::SPSC >    ch;
+};
+
+template < access A > class consumer : public raft::kernel
+{
+public:
+   consumer() : raft::kernel()
+   {
+      input.addPort< item_t >( "0" );
+      h  = input.handle< item_t >( "0" );
+      ch = input.channel< item_t, Type::SPSC >( "0" );
+   }
+
+   virtual raft::kstatus run()
+   {
+      item_t v( 0 );
+      switch( A )
+      {
+         case( access::by_name ):
+            input[ "0" ].pop( v );
+            break;
+         case( access::handle ):
+            h.pop( v );
+            break;
+         case( access::channel ):
+            ch.pop( v );
+            break;
+      }
+      sum += v;
+      return( raft::proceed );
+   }
+
+   item_t                                 sum = 0;
+
+private:
+   raft::port_handle< item_t >            h;
+   raft::channel< item_t, Type::SPSC >    ch;
+};
+
+/** ring - seconds to push and pop count items on a bare ring **/
+template < access A > double ring( const item_t count )
+{
+   const std::size_t cap( 1024 );
+   std::unique_ptr< FIFO > fifo( 
+      RingBuffer< item_t, Type::SPSC, false >::make_new_fifo( cap, 64, nullptr ) );
+   PortInfo pi( typeid( item_t ) );
+   pi.setFIFO( fifo.get() );
+   raft::port_handle< item_t >         h( &pi );
+   raft::channel< item_t, Type::SPSC > ch( &pi );
+   item_t sum( 0 );
+   const auto start( std::chrono::steady_clock::now() );
+   for( item_t base( 0 ); base < count; base += cap )
+   {
+      const auto n( std::min( static_cast< item_t >( cap ), count - base ) );
+      for( item_t i( 0 ); i < n; i++ )
+      {
+         switch( A )
+         {
+            case( access::by_name ):
+               fifo->push( base + i );
+               break;
+            case( access::handle ):
+               h.push( base + i );
+               break;
+            case( access::channel ):
+               ch.push( base + i );
+               break;
+         }
+      }
+      for( item_t i( 0 ); i < n; i++ )
+      {
+         item_t v( 0 );
+         switch( A )
+         {
+            case( access::by_name ):
+               fifo->pop( v );
+               break;
+            case( access::handle ):
+               h.pop( v );
+               break;
+            case( access::channel ):
+               ch.pop( v );
+               break;
+         }
+         sum += v;
+      }
+   }
+   const std::chrono::duration< double > elapsed(
+      std::chrono::steady_clock::now() - start );
+   if( sum != count * ( count - 1 ) / 2 )
+   {
+      std::cerr << "items lost\n";
+      exit( EXIT_FAILURE );
+   }
+   return( elapsed.count() );
+}
+
+/** graph - seconds to move count items between two kernels **/
+template < access A > double graph( const item_t count )
+{
+   producer< A > p( count );
+   consumer< A > c;
+   raft::map m;
+   m.link< raft::order::in, Type::SPSC >( &p, &c );
+   const auto start( std::chrono::steady_clock::now() );
+   m.exe();
+   const std::chrono::duration< double > elapsed(
+      std::chrono::steady_clock::now() - start );
+   if( c.sum != count * ( count - 1 ) / 2 )
+   {
+      std::cerr << "items lost\n";
+      exit( EXIT_FAILURE );
+   }
+   return( elapsed.count() );
+}
+
+template < double (*F)( const item_t ) > void report( const char * const name,
+                                                      const item_t count,
+                                                      const int repeats )
+{
+   double best( 1e30 );
+   for( int i( 0 ); i < repeats; i++ )
+   {
+      best = std::min( best, F( count ) );
+   }
+   std::cout << std::setw( 10 ) << name << ": " << std::fixed <<
+      std::setprecision( 2 ) << ( count / best ) / 1e6 << " Mitems/s, " <<
+      ( best * 1e9 ) / count << " ns/item (best of " << repeats << ")\n";
+}
+
+int
+main( int argc, char **argv )
+{
+   const item_t count( argc > 1 ? std::stoll( argv[ 1 ] ) : 10000000 );
+   const int repeats( argc > 2 ? std::stoi( argv[ 2 ] ) : 3 );
+   std::cout << "bare ring, one thread\n";
+   report< ring< access::by_name > >( "fifo",    count, repeats );
+   report< ring< access::handle  > >( "handle",  count, repeats );
+   report< ring< access::channel > >( "channel", count, repeats );
+   /** a context switch per item on one core, keep it short **/
+   const item_t graph_count( std::min( count, static_cast< item_t >( 1000000 ) ) );
+   std::cout << "graph, producer -> consumer\n";
+   report< graph< access::by_name > >( "by name", graph_count, repeats );
+   report< graph< access::handle  > >( "handle",  graph_count, repeats );
+   report< graph< access::channel > >( "channel", graph_count, repeats );
+   return( EXIT_SUCCESS );
+}
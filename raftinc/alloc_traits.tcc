@@ -3,6 +3,8 @@
 #include <cstdint>
 #include <type_traits>
 #include <typeinfo>
+#include <iterator>
+#include <vector>
 
 #ifndef ALLOC_TRAITS
 #define ALLOC_TRAITS 1
@@ -81,8 +83,32 @@ struct ext_alloc : std::integral_constant< bool,
          ext_mem_alloc< T >::value >{};
 
 
+/**
+ * bulk_copy_alloc - in line items that can be copied as raw
+ * bytes, ranges of these go in and out of the heap queues
+ * with memcpy rather than one at a time.
+ */
+template < class T >
+struct bulk_copy_alloc : std::integral_constant< bool,
+         inline_alloc< T >::value &&
+         std::is_trivially_copyable< T >::value >{};
 
 /**
  * NOW FOR MOVE/PUSH CHECKS
  */
+
+/**
+ * contiguous_iterator - true for iterators over trivially 
+ * copyable items that sit one after another in memory (raw
+ * pointers and std::vector iterators, not std::vector< bool >),
+ * insert hands these to the queue as a pointer and a length.
+ */
+template < class It,
+           class V = typename std::iterator_traits< It >::value_type >
+struct contiguous_iterator : std::integral_constant< bool,
+         std::is_trivially_copyable< V >::value &&
+         ! std::is_same< V, bool >::value &&
+         ( std::is_pointer< It >::value ||
+           std::is_same< It, typename std::vector< V >::iterator >::value ||
+           std::is_same< It, typename std::vector< V >::const_iterator >::value ) >{};
 #endif
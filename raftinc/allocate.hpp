@@ -84,7 +84,26 @@ public:
     */
    void waitTillReady() ;
 
-   
+   /**
+    * footprint - bytes held by the FIFOs of the map as last
+    * seen by the allocator, 0 if it doesn't keep track.
+    * @return std::size_t
+    */
+   virtual std::size_t footprint() const noexcept
+   {
+      return( 0 );
+   }
+
+   /**
+    * peak_footprint - largest footprint() seen while the map
+    * ran, 0 if the allocator doesn't keep track.
+    * @return std::size_t
+    */
+   virtual std::size_t peak_footprint() const noexcept
+   {
+      return( 0 );
+   }
+
 protected:
    /**
     * initialize - internal method to be used within the run method
@@ -101,9 +120,73 @@ protected:
                     PortInfo * const dst, 
                     FIFO * const fifo );
 
+
+   /**
+    * fan_in - initialize for a Type::FanIn edge, fifo is
+    * the ring of the producer (src), it is added to the 
+    * FanIn on dst, which is built by the first edge to get
+    * here.
+    * @param   src - PortInfo*, producer
+    * @param   dst - PortInfo*, consumer
+    * @param   fifo - FIFO*, ring for this producer
+    * @throws  PortDoubleInitializeException - if dst already has 
+    *          a FIFO that isn't a FanIn.
+    */
+   void fan_in( PortInfo * const src,
+                PortInfo * const dst,
+                FIFO * const fifo );
+
+   /**
+    * broadcast - initialize for a Type::Broadcast edge, fifo
+    * is the shared store which is set on src the first time
+    * and must be the same one for every destination after
+    * that, dst gets a reader of its own.
+    * @param   src - PortInfo*, producer
+    * @param   dst - PortInfo*, one of the consumers
+    * @param   fifo - FIFO*, store for the producer
+    * @throws  PortDoubleInitializeException - if either port
+    *          already has some other FIFO.
+    */
+   void broadcast( PortInfo * const src,
+                   PortInfo * const dst,
+                   FIFO * const fifo );
+
+   /**
+    * set_batch - hands the raft::batch of the edge to fifo, 
+    * if it's on, both kernels are marked so the scheduler 
+    * flushes their ports (see batch.hpp).
+    * @param   src - PortInfo*, producer
+    * @param   dst - PortInfo*, consumer
+    * @param   fifo - FIFO*
+    */
+   void set_batch( PortInfo * const src,
+                   PortInfo * const dst,
+                   FIFO * const fifo );
+   
+   /**
+    * set_placement - hands the raft::placement of the edge to 
+    * fifo, with raft::numa::consumer resolved to the node of
+    * the core dst's kernel is assigned to (see placement.hpp).
+    * @param   src - PortInfo*, producer
+    * @param   dst - PortInfo*, consumer
+    * @param   fifo - FIFO*
+    */
+   void set_placement( PortInfo * const src,
+                       PortInfo * const dst,
+                       FIFO * const fifo );
    
    virtual void allocate( PortInfo &a, PortInfo &b, void *data );
 
+   /**
+    * capacity_for - returns n rounded up to the next power
+    * of two. The ring buffer indices are masked rather than
+    * taken modulo the capacity when it is a power of two, so
+    * all allocators should pass their sizes through here.
+    * @param   n - const std::size_t, requested number of items
+    * @return  std::size_t
+    */
+   static std::size_t capacity_for( const std::size_t n ) noexcept;
+
    /**
     * setReady - call within the implemented run function to signal
     * that the initial allocations have been completed.
@@ -126,6 +209,9 @@ protected:
     * is exited.
     */
    volatile bool &exit_alloc;
+
+   /** wait strategy for FIFOs whose ports didn't pick one **/
+   const raft::wait::strategy default_wait;
 private:
    volatile bool ready = false;
    friend class basic_parallel;
@@ -109,17 +109,21 @@ private:
 template < class T > class autorelease< T, peekrange > : public autoreleasebase
 {
 public:
+   /** externally allocated objects are held by pointer in the store **/
+   using store_t = typename std::conditional< ext_alloc< T >::value, T*, T >::type;
+
    autorelease( FIFO             &fifo, 
-                   T * const      queue,
+                store_t * const   queue,
                 Buffer::Signal   * const sig,
                 const std::size_t curr_read_ptr,
-                const std::size_t n_items ) : autoreleasebase(),
-                                              fifo( fifo ),
-                                              queue( queue ),
-                                              signal( sig ),
-                                              crp  ( curr_read_ptr ),
-                                              n_items( n_items ),
-                                              queue_size( fifo.capacity() )
+                const std::size_t n_items,
+                const std::size_t queue_size ) : autoreleasebase(),
+                                                 fifo( fifo ),
+                                                 queue( queue ),
+                                                 signal( sig ),
+                                                 crp  ( curr_read_ptr ),
+                                                 n_items( n_items ),
+                                                 queue_size( queue_size )
    {
       
    }
@@ -156,7 +160,7 @@ public:
       else
       {
          std::size_t ptr_val( (index + crp) % queue_size );
-         return( std::move( autopair< T >( queue[ ptr_val ], signal[ ptr_val ] ) ) );
+         return( std::move( autopair< T >( item( queue[ ptr_val ] ), signal[ ptr_val ] ) ) );
       }
    }
 
@@ -167,7 +171,7 @@ public:
     */
    std::size_t getindex() noexcept
    {
-      return( signal[ 0 ] .getindex() );
+      return( signal[ crp ].getindex() );
    }
 
    std::size_t size() noexcept
@@ -177,8 +181,18 @@ public:
 
    /** TODO, build iterator for this **/
 private:
+   static T& item( T &slot ) noexcept
+   {
+      return( slot );
+   }
+
+   static T& item( T * const slot ) noexcept
+   {
+      return( *slot );
+   }
+
    FIFO             &fifo;
-   T  *  const            queue;
+   store_t  *  const      queue;
    Buffer::Signal * const signal;
    /** current read pointer **/
    const std::size_t crp;
@@ -0,0 +1,78 @@
+/**
+ * batch.hpp - per edge setting for batched index publication.
+ * Normally the producer moves the shared write index after
+ * every item and the consumer moves the shared read index
+ * after every item, i.e., one store to a line the other end is
+ * reading for each item. With batching on an edge each end
+ * keeps a private count and only publishes it every "items"
+ * items, when the other end is seen to be out of work (empty
+ * for the consumer, full for the producer), when it is about
+ * to wait itself, when its kernel goes idle or finishes, when
+ * flush() is called on the output port, or when the oldest
+ * unpublished item is older than "latency".
+ * @author: agent
+ * @version: Fri Oct 16 23:34:51 2026
+ *
+ * Copyright 2026 agent
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at:
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef RAFTBATCH_HPP
+#define RAFTBATCH_HPP  1
+#include <chrono>
+#include <cstddef>
+
+/**
+ * BATCH_LATENCY_US - default bound on how long an item can
+ * sit written but unpublished on a batched edge.
+ */
+#ifndef BATCH_LATENCY_US
+#define BATCH_LATENCY_US 100
+#endif
+
+/**
+ * BATCH_POLL_STRIDE - the latency bound is checked by the
+ * scheduler between runs of the producer, reading the clock
+ * once every this many runs.
+ */
+#ifndef BATCH_POLL_STRIDE
+#define BATCH_POLL_STRIDE 8
+#endif
+
+namespace raft
+{
+
+struct batch
+{
+   batch() = default;
+
+   /**
+    * batch - publish the indices every items items,
+    * zero (the default) publishes after every item.
+    * @param   items - const std::size_t
+    * @param   latency - const std::chrono::microseconds
+    */
+   explicit batch( const std::size_t items,
+          const std::chrono::microseconds latency =
+            std::chrono::microseconds( BATCH_LATENCY_US ) ) : items( items ),
+                                                                       latency( latency )
+   {
+   }
+
+   std::size_t                items   = 0;
+   std::chrono::microseconds  latency =
+      std::chrono::microseconds( BATCH_LATENCY_US );
+};
+
+} /** end namespace raft **/
+#endif /* END RAFTBATCH_HPP */
@@ -0,0 +1,940 @@
+/**
+ * broadcast.tcc - Type::Broadcast edges, one output port linked
+ * to several input ports where every consumer sees every item.
+ * There is a single store, written once by the producer, each
+ * consumer's port gets a BroadcastReader with its own read
+ * cursor into it. A slot is only reused (and its item destroyed)
+ * once the slowest reader has moved past it, so there is one
+ * copy of each item no matter how many readers there are, as
+ * opposed to a split kernel and one queue per branch.
+ * @author: agent
+ * @version: Fri Oct 16 23:07:19 2026
+ *
+ * Copyright 2026 agent
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at:
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef RAFTBROADCAST_TCC
+#define RAFTBROADCAST_TCC  1
+#include <atomic>
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <limits>
+#include <list>
+#include <new>
+#include <type_traits>
+#include <vector>
+#include "fifo.hpp"
+#include "alloc_traits.tcc"
+#include "slabpool.tcc"
+#include "signal.hpp"
+#include "ringspan.hpp"
+#include "waitstrategy.hpp"
+#include "portexception.hpp"
+#include "internaldefs.hpp"
+#include "defs.hpp"
+
+/**
+ * BroadcastBase - lets the allocator add readers without
+ * knowing the item type.
+ */
+class BroadcastBase : public FIFO
+{
+public:
+   BroadcastBase() = default;
+   virtual ~BroadcastBase() = default;
+
+   /**
+    * add_reader - returns the FIFO for one more consumer, must
+    * be called before any items are written. The returned FIFO
+    * is owned (and deleted) by this one.
+    * @return  FIFO*
+    */
+   virtual FIFO* add_reader() = 0;
+};
+
+template < class T > class BroadcastReader;
+
+template < class T > class Broadcast : public BroadcastBase
+{
+   /** same layout as the heap ring, big items live outside **/
+   using slot_t = typename std::conditional< ext_alloc< T >::value,
+                                             T*,
+                                             T >::type;
+public:
+   Broadcast( const std::size_t n, const std::size_t align ) :
+      BroadcastBase(),
+      cap( n ),
+      mask( n - 1 )
+   {
+      /** allocators hand out powers of two, see capacity_for **/
+      assert( n != 0 && ( n & ( n - 1 ) ) == 0 );
+      const auto length( sizeof( slot_t ) * n );
+      if( posix_memalign( (void**)&store,
+                          std::max( align, sizeof( void* ) ),
+                          length ) != 0 )
+      {
+         std::cerr << "Failed to allocate broadcast store!\n";
+         exit( EXIT_FAILURE );
+      }
+      signal = (Buffer::Signal*) calloc( n, sizeof( Buffer::Signal ) );
+      if( signal == nullptr )
+      {
+         perror( "Failed to allocate signal queue!" );
+         exit( EXIT_FAILURE );
+      }
+   }
+
+   virtual ~Broadcast()
+   {
+      for( auto *r : readers )
+      {
+         delete( r );
+      }
+      /** readers are gone, everything still here is ours **/
+      const auto end( write.load( std::memory_order_relaxed ) );
+      for( ; reclaimed < end; reclaimed++ )
+      {
+         destroy( reclaimed & mask );
+      }
+      free( store );
+      free( signal );
+      for( auto *c : cursors )
+      {
+         delete( c );
+      }
+   }
+
+   static FIFO* make_new_fifo( const std::size_t n_items,
+                               const std::size_t align,
+                               void * const data )
+   {
+      assert( data == nullptr );
+      UNUSED( data );
+      return( new Broadcast< T >( n_items, align ) );
+   }
+
+   virtual FIFO* add_reader()
+   {
+      assert( write.load( std::memory_order_relaxed ) == 0 );
+      cursors.emplace_back( new cursor() );
+      readers.emplace_back( new BroadcastReader< T >( *this, *cursors.back() ) );
+      return( readers.back() );
+   }
+
+   /**
+    * size - items the slowest reader still has to get through.
+    * @return  std::size_t
+    */
+   virtual std::size_t size()
+   {
+      return( static_cast< std::size_t >(
+         write.load( std::memory_order_relaxed ) - slowest() ) );
+   }
+
+   virtual std::size_t space_avail()
+   {
+      return( cap - std::min( size(), cap ) );
+   }
+
+   virtual std::size_t capacity()
+   {
+      return( cap );
+   }
+
+   virtual void deallocate()
+   {
+      if( ! allocate_called )
+      {
+         return;
+      }
+      for( std::size_t i( 0 ); i < n_allocated; i++ )
+      {
+         destroy( ( write.load( std::memory_order_relaxed ) + i ) & mask );
+      }
+      allocate_called = false;
+      n_allocated     = 0;
+   }
+
+   virtual void send( const raft::signal sig = raft::none )
+   {
+      if( R_UNLIKELY( ! allocate_called ) )
+      {
+         return;
+      }
+      publish( 1, sig );
+   }
+
+   virtual void send_range( const raft::signal sig = raft::none )
+   {
+      if( ! allocate_called )
+      {
+         return;
+      }
+      publish( n_allocated, sig );
+   }
+
+   /** consumer side calls, readers get their own FIFO **/
+   virtual void unpeek()
+   {
+      assert( false );
+   }
+
+   /** the store is fixed, readers hold pointers into it **/
+   virtual void resize( const std::size_t n_items,
+                        const std::size_t align,
+                        volatile bool &exit_alloc )
+   {
+      UNUSED( n_items );
+      UNUSED( align );
+      UNUSED( exit_alloc );
+   }
+
+   virtual float get_frac_write_blocked()
+   {
+      return( 0.0 );
+   }
+
+   virtual std::size_t get_suggested_count()
+   {
+      return( 0 );
+   }
+
+   virtual std::size_t footprint()
+   {
+      return( cap * ( sizeof( slot_t ) + sizeof( Buffer::Signal ) ) );
+   }
+
+   virtual void invalidate()
+   {
+      invalid.store( true, std::memory_order_release );
+      data_ready.wake();
+   }
+
+   virtual bool is_invalid()
+   {
+      return( invalid.load( std::memory_order_acquire ) );
+   }
+
+   virtual void set_wait_strategy( const raft::wait::strategy s )
+   {
+      assert( s != raft::wait::inherit );
+      wait_strategy = s;
+   }
+
+protected:
+   virtual raft::signal signal_peek()
+   {
+      assert( false );
+      return( raft::none );
+   }
+
+   virtual void signal_pop()
+   {
+      assert( false );
+   }
+
+   virtual void inline_signal_send( const raft::signal sig )
+   {
+      local_push( nullptr, sig );
+   }
+
+   virtual void local_allocate( void **ptr )
+   {
+      wait_space( 1 );
+      *ptr = (void*) &store[ write.load( std::memory_order_relaxed ) & mask ];
+      allocate_called = true;
+      n_allocated     = 1;
+   }
+
+   virtual void local_allocate_n( void *ptr, const std::size_t n )
+   {
+      wait_space( n );
+      auto *container(
+         reinterpret_cast< std::vector< std::reference_wrapper< T > >* >( ptr ) );
+      const auto start( write.load( std::memory_order_relaxed ) );
+      for( std::size_t i( 0 ); i < n; i++ )
+      {
+         container->emplace_back( construct( ( start + i ) & mask ) );
+      }
+      allocate_called = true;
+      n_allocated     = n;
+   }
+
+   virtual void local_allocate_span( void *range, const std::size_t n )
+   {
+      wait_space( n );
+      *reinterpret_cast< raft::span_pair< slot_t >* >( range ) =
+         raft::span_pair< slot_t >( store,
+                                    cap,
+                                    write.load( std::memory_order_relaxed ) & mask,
+                                    n );
+      allocate_called = true;
+      n_allocated     = n;
+   }
+
+   virtual void local_push( void *ptr, const raft::signal &sig )
+   {
+      wait_space( 1 );
+      const auto index( write.load( std::memory_order_relaxed ) & mask );
+      if( ptr != nullptr )
+      {
+         copy( index, *reinterpret_cast< T* >( ptr ) );
+      }
+      else
+      {
+         construct( index );
+      }
+      publish( 1, sig );
+   }
+
+   virtual void local_push_move( void *ptr, const raft::signal &sig )
+   {
+      assert( ptr != nullptr );
+      wait_space( 1 );
+      move_in( write.load( std::memory_order_relaxed ) & mask,
+               *reinterpret_cast< T* >( ptr ) );
+      publish( 1, sig );
+   }
+
+   virtual void local_insert( void *begin_ptr,
+                              void *end_ptr,
+                              const raft::signal &sig,
+                              const std::size_t iterator_type )
+   {
+      using it_list = typename std::list< T >::iterator;
+      using it_vec  = typename std::vector< T >::iterator;
+      if( iterator_type == typeid( it_list ).hash_code() )
+      {
+         insert_helper( *reinterpret_cast< it_list* >( begin_ptr ),
+                        *reinterpret_cast< it_list* >( end_ptr ),
+                        sig );
+      }
+      else if( iterator_type == typeid( it_vec ).hash_code() )
+      {
+         insert_helper( *reinterpret_cast< it_vec* >( begin_ptr ),
+                        *reinterpret_cast< it_vec* >( end_ptr ),
+                        sig );
+      }
+      else
+      {
+         throw PortTypeMismatchException( 
+            "insert with an iterator type this FIFO doesn't take, only "
+            "std::list and std::vector iterators of the port type are" );
+      }
+   }
+
+   virtual void local_pop( void *ptr, raft::signal *sig )
+   {
+      UNUSED( ptr );
+      UNUSED( sig );
+      assert( false );
+   }
+
+   virtual void local_pop_range( void *ptr_data, const std::size_t n_items )
+   {
+      UNUSED( ptr_data );
+      UNUSED( n_items );
+      assert( false );
+   }
+
+   virtual void local_peek( void **ptr, raft::signal *sig )
+   {
+      UNUSED( ptr );
+      UNUSED( sig );
+      assert( false );
+   }
+
+   virtual void local_peek_range( void **ptr,
+                                  void **sig,
+                                  const std::size_t n_items,
+                                  std::size_t &curr_pointer_loc ,
+                                  std::size_t &queue_size )
+   {
+      UNUSED( ptr );
+      UNUSED( sig );
+      UNUSED( n_items );
+      UNUSED( curr_pointer_loc );
+      UNUSED( queue_size );
+      assert( false );
+   }
+
+   virtual void local_peek_span( void *range, const std::size_t n )
+   {
+      UNUSED( range );
+      UNUSED( n );
+      assert( false );
+   }
+
+   virtual void local_recycle( std::size_t range )
+   {
+      UNUSED( range );
+      assert( false );
+   }
+
+private:
+   /**
+    * cursor - count of items one reader is done with, set to
+    * detached once the reader closes its end so that it no
+    * longer holds the producer back.
+    */
+   struct ALIGN( L1D_CACHE_LINE_SIZE ) cursor
+   {
+      std::atomic< std::uint64_t > pos = { 0 };
+   };
+
+   static constexpr std::uint64_t detached =
+      std::numeric_limits< std::uint64_t >::max();
+
+   /**
+    * slowest - position of the slowest reader, or the write
+    * position if every reader has detached.
+    * @return  std::uint64_t
+    */
+   std::uint64_t slowest() const noexcept
+   {
+      std::uint64_t min( write.load( std::memory_order_relaxed ) );
+      for( const auto *c : cursors )
+      {
+         min = std::min( min, c->pos.load( std::memory_order_acquire ) );
+      }
+      return( min );
+   }
+
+   /**
+    * wait_space - blocks till n slots past the write position
+    * are free, destroying whatever the readers are all done
+    * with on the way.
+    * @param   n - const std::size_t
+    */
+   void wait_space( const std::size_t n )
+   {
+      assert( n <= cap );
+      const auto end( write.load( std::memory_order_relaxed ) + n );
+      if( R_LIKELY( end <= limit ) )
+      {
+         return;
+      }
+      raft::wait::backoff wait( wait_strategy, space_ready );
+      for(;;)
+      {
+         const auto min( slowest() );
+         for( ; reclaimed < min; reclaimed++ )
+         {
+            destroy( reclaimed & mask );
+         }
+         limit = min + cap;
+         if( end <= limit )
+         {
+            return;
+         }
+         wait.idle( [&]{ return( end <= slowest() + cap ); } );
+      }
+   }
+
+   /**
+    * publish - hand the next n slots to the readers, the
+    * signal goes with the last of them.
+    * @param   n - const std::size_t
+    * @param   sig - const raft::signal
+    */
+   void publish( const std::size_t n, const raft::signal sig )
+   {
+      if( n == 0 )
+      {
+         allocate_called = false;
+         return;
+      }
+      const auto start( write.load( std::memory_order_relaxed ) );
+      for( std::size_t i( 0 ); i < n; i++ )
+      {
+         signal[ ( start + i ) & mask ].sig = raft::none;
+      }
+      signal[ ( start + n - 1 ) & mask ].sig = sig;
+      write.store( start + n, std::memory_order_release );
+      allocate_called = false;
+      n_allocated     = 0;
+      if( R_UNLIKELY( wait_strategy == raft::wait::park ) )
+      {
+         data_ready.notify();
+      }
+   }
+
+   template < class iterator_type >
+   void insert_helper( iterator_type begin,
+                       iterator_type end,
+                       const raft::signal &sig )
+   {
+      while( begin != end )
+      {
+         auto curr( begin++ );
+         local_push( (void*) &(*curr), begin == end ? sig : raft::none );
+      }
+   }
+
+   /** item lifetime, three versions for the three kinds of T **/
+   template < class U = T,
+              typename std::enable_if< inline_nonclass_alloc< U >::value >::type* = nullptr >
+   T& construct( const std::size_t index )
+   {
+      return( store[ index ] );
+   }
+
+   template < class U = T,
+              typename std::enable_if< inline_class_alloc< U >::value &&
+                                       std::is_default_constructible< U >::value >::type* = nullptr >
+   T& construct( const std::size_t index )
+   {
+      return( *( new ( &store[ index ] ) T() ) );
+   }
+
+   template < class U = T,
+              typename std::enable_if< ext_alloc< U >::value &&
+                                       std::is_default_constructible< U >::value >::type* = nullptr >
+   T& construct( const std::size_t index )
+   {
+      store[ index ] = raft::slab_pool< T >::make();
+      return( *store[ index ] );
+   }
+
+   /** allocate_range and signal only pushes need a default ctor **/
+   template < class U = T,
+              typename std::enable_if< std::is_class< U >::value &&
+                                       ! std::is_default_constructible< U >::value >::type* = nullptr >
+   T& construct( const std::size_t index )
+   {
+      assert( false );
+      return( *reinterpret_cast< T* >( &store[ index ] ) );
+   }
+
+   template < class U = T,
+              typename std::enable_if< inline_nonclass_alloc< U >::value >::type* = nullptr >
+   void copy( const std::size_t index, const T &item )
+   {
+      store[ index ] = item;
+   }
+
+   template < class U = T,
+              typename std::enable_if< inline_class_alloc< U >::value >::type* = nullptr >
+   void copy( const std::size_t index, const T &item )
+   {
+      new ( &store[ index ] ) T( item );
+   }
+
+   template < class U = T,
+              typename std::enable_if< ext_alloc< U >::value >::type* = nullptr >
+   void copy( const std::size_t index, const T &item )
+   {
+      store[ index ] = raft::slab_pool< T >::make( item );
+   }
+
+   template < class U = T,
+              typename std::enable_if< inline_nonclass_alloc< U >::value >::type* = nullptr >
+   void move_in( const std::size_t index, T &item )
+   {
+      store[ index ] = item;
+   }
+
+   template < class U = T,
+              typename std::enable_if< inline_class_alloc< U >::value >::type* = nullptr >
+   void move_in( const std::size_t index, T &item )
+   {
+      new ( &store[ index ] ) T( std::move( item ) );
+   }
+
+   template < class U = T,
+              typename std::enable_if< ext_alloc< U >::value >::type* = nullptr >
+   void move_in( const std::size_t index, T &item )
+   {
+      store[ index ] = raft::slab_pool< T >::make( std::move( item ) );
+   }
+
+   template < class U = T,
+              typename std::enable_if< inline_nonclass_alloc< U >::value >::type* = nullptr >
+   void destroy( const std::size_t index )
+   {
+      UNUSED( index );
+   }
+
+   template < class U = T,
+              typename std::enable_if< inline_class_alloc< U >::value >::type* = nullptr >
+   void destroy( const std::size_t index )
+   {
+      store[ index ].~T();
+   }
+
+   template < class U = T,
+              typename std::enable_if< ext_alloc< U >::value >::type* = nullptr >
+   void destroy( const std::size_t index )
+   {
+      raft::slab_pool< T >::destroy( store[ index ] );
+   }
+
+   slot_t                           *store    = nullptr;
+   Buffer::Signal                   *signal   = nullptr;
+   const std::size_t                 cap;
+   const std::size_t                 mask;
+   std::vector< cursor* >            cursors;
+   std::vector< FIFO* >              readers;
+
+   /** published items, only written by the producer **/
+   ALIGN( L1D_CACHE_LINE_SIZE )
+   std::atomic< std::uint64_t >      write    = { 0 };
+   std::atomic< bool >               invalid  = { false };
+
+   /** producer private from here down **/
+   ALIGN( L1D_CACHE_LINE_SIZE )
+   std::uint64_t                     reclaimed = 0;
+   /** write may run up to here without checking the readers **/
+   std::uint64_t                     limit     = 0;
+   bool                              allocate_called = false;
+   std::size_t                       n_allocated     = 0;
+   raft::wait::strategy              wait_strategy   = raft::wait::spin_yield;
+
+   /** readers park here **/
+   raft::wait::spot                  data_ready;
+   /** producer parks here **/
+   raft::wait::spot                  space_ready;
+
+   friend class BroadcastReader< T >;
+};
+
+template < class T >
+constexpr std::uint64_t Broadcast< T >::detached;
+
+/**
+ * BroadcastReader - the consumer end of a Type::Broadcast edge,
+ * items are shared with the other readers so pop copies out
+ * and peeked items are left where they are (a downstream push
+ * of one copies it rather than taking it over).
+ */
+template < class T > class BroadcastReader : public FIFO
+{
+   using owner_t  = Broadcast< T >;
+   using cursor_t = typename owner_t::cursor;
+   using slot_t   = typename owner_t::slot_t;
+public:
+   BroadcastReader( owner_t &owner, cursor_t &me ) : FIFO(),
+                                                     owner( owner ),
+                                                     me( me )
+   {
+   }
+
+   virtual ~BroadcastReader() = default;
+
+   virtual std::size_t size()
+   {
+      if( R_UNLIKELY( detached ) )
+      {
+         return( 0 );
+      }
+      return( static_cast< std::size_t >(
+         owner.write.load( std::memory_order_acquire ) - pos ) );
+   }
+
+   virtual std::size_t space_avail()
+   {
+      return( owner.space_avail() );
+   }
+
+   virtual std::size_t capacity()
+   {
+      return( owner.cap );
+   }
+
+   /** producer side calls **/
+   virtual void deallocate()
+   {
+      assert( false );
+   }
+
+   virtual void send( const raft::signal sig = raft::none )
+   {
+      UNUSED( sig );
+      assert( false );
+   }
+
+   virtual void send_range( const raft::signal sig = raft::none )
+   {
+      UNUSED( sig );
+      assert( false );
+   }
+
+   /** nothing to do, the slots stay put till we move past them **/
+   virtual void unpeek()
+   {
+   }
+
+   virtual void resize( const std::size_t n_items,
+                        const std::size_t align,
+                        volatile bool &exit_alloc )
+   {
+      UNUSED( n_items );
+      UNUSED( align );
+      UNUSED( exit_alloc );
+   }
+
+   virtual float get_frac_write_blocked()
+   {
+      return( 0.0 );
+   }
+
+   virtual std::size_t get_suggested_count()
+   {
+      return( 0 );
+   }
+
+   /** counted once, on the producer **/
+   virtual std::size_t footprint()
+   {
+      return( 0 );
+   }
+
+   /**
+    * invalidate - called when our consumer quits early (term
+    * signal), drop out of the slowest reader calculation so the
+    * others keep going.
+    */
+   virtual void invalidate()
+   {
+      detached = true;
+      me.pos.store( owner_t::detached, std::memory_order_release );
+      owner.space_ready.wake();
+   }
+
+   virtual bool is_invalid()
+   {
+      return( detached || owner.is_invalid() );
+   }
+
+   /** the store's wait strategy is used for both ends **/
+   virtual void set_wait_strategy( const raft::wait::strategy s )
+   {
+      UNUSED( s );
+   }
+
+protected:
+   virtual raft::signal signal_peek()
+   {
+      return( owner.signal[ pos & owner.mask ] );
+   }
+
+   virtual void signal_pop()
+   {
+      advance( 1 );
+   }
+
+   virtual void inline_signal_send( const raft::signal sig )
+   {
+      UNUSED( sig );
+      assert( false );
+   }
+
+   virtual void local_allocate( void **ptr )
+   {
+      UNUSED( ptr );
+      assert( false );
+   }
+
+   virtual void local_allocate_n( void *ptr, const std::size_t n )
+   {
+      UNUSED( ptr );
+      UNUSED( n );
+      assert( false );
+   }
+
+   virtual void local_allocate_span( void *range, const std::size_t n )
+   {
+      UNUSED( range );
+      UNUSED( n );
+      assert( false );
+   }
+
+   virtual void local_push( void *ptr, const raft::signal &sig )
+   {
+      UNUSED( ptr );
+      UNUSED( sig );
+      assert( false );
+   }
+
+   virtual void local_insert( void *begin_ptr,
+                              void *end_ptr,
+                              const raft::signal &sig,
+                              const std::size_t iterator_type )
+   {
+      UNUSED( begin_ptr );
+      UNUSED( end_ptr );
+      UNUSED( sig );
+      UNUSED( iterator_type );
+      assert( false );
+   }
+
+   virtual void local_pop( void *ptr, raft::signal *sig )
+   {
+      if( ! wait_items( 1 ) )
+      {
+         throw ClosedPortAccessException(
+            "Accessing closed port with pop call, exiting!!" );
+      }
+      const auto index( pos & owner.mask );
+      if( sig != nullptr )
+      {
+         *sig = owner.signal[ index ];
+      }
+      assert( ptr != nullptr );
+      *reinterpret_cast< T* >( ptr ) = item( index );
+      advance( 1 );
+   }
+
+   virtual void local_pop_range( void *ptr_data, const std::size_t n_items )
+   {
+      assert( ptr_data != nullptr );
+      auto *items(
+         reinterpret_cast< std::vector< std::pair< T, raft::signal > >* >( ptr_data ) );
+      assert( items->size() == n_items );
+      UNUSED( n_items );
+      for( auto &pair : (*items) )
+      {
+         local_pop( (void*) &pair.first, &pair.second );
+      }
+   }
+
+   virtual void local_peek( void **ptr, raft::signal *sig )
+   {
+      if( ! wait_items( 1 ) )
+      {
+         throw ClosedPortAccessException(
+            "Accessing closed port with local_peek call, exiting!!" );
+      }
+      const auto index( pos & owner.mask );
+      if( sig != nullptr )
+      {
+         *sig = owner.signal[ index ];
+      }
+      /** T* for inline items, T** for external ones **/
+      *ptr = (void*) &owner.store[ index ];
+   }
+
+   virtual void local_peek_range( void **ptr,
+                                  void **sig,
+                                  const std::size_t n,
+                                  std::size_t &curr_pointer_loc ,
+                                  std::size_t &queue_size )
+   {
+      if( ! wait_items( n ) )
+      {
+         if( size() == 0 )
+         {
+            throw ClosedPortAccessException(
+               "Accessing closed port with local_peek_range call, exiting!!" );
+         }
+         throw NoMoreDataException(
+            "Too few items left on closed port, kernel exiting" );
+      }
+      curr_pointer_loc = pos & owner.mask;
+      queue_size       = owner.mask + 1;
+      *sig = (void*) owner.signal;
+      *ptr = (void*) owner.store;
+   }
+
+   virtual void local_peek_span( void *range, const std::size_t n )
+   {
+      if( ! wait_items( n ) )
+      {
+         throw NoMoreDataException(
+            "Too few items left on closed port, kernel exiting" );
+      }
+      *reinterpret_cast< raft::span_pair< slot_t >* >( range ) =
+         raft::span_pair< slot_t >( owner.store,
+                                    owner.cap,
+                                    pos & owner.mask,
+                                    n );
+   }
+
+   virtual void local_recycle( std::size_t range )
+   {
+      while( range > 0 )
+      {
+         if( ! wait_items( 1 ) )
+         {
+            return;
+         }
+         const auto n( std::min( range, size() ) );
+         advance( n );
+         range -= n;
+      }
+   }
+
+private:
+   /**
+    * wait_items - blocks till n items are ready to read,
+    * returns false if the producer is done and there will
+    * never be n.
+    * @param   n - const std::size_t
+    * @return  bool
+    */
+   bool wait_items( const std::size_t n )
+   {
+      raft::wait::backoff wait( owner.wait_strategy, owner.data_ready );
+      for(;;)
+      {
+         /** check closed first, the last items go in before it's set **/
+         const bool closed( is_invalid() );
+         if( size() >= n )
+         {
+            return( true );
+         }
+         if( closed )
+         {
+            return( false );
+         }
+         wait.idle( [&]{ return( size() >= n || is_invalid() ); } );
+      }
+   }
+
+   void advance( const std::size_t n )
+   {
+      pos += n;
+      me.pos.store( pos, std::memory_order_release );
+      if( R_UNLIKELY( owner.wait_strategy == raft::wait::park ) )
+      {
+         owner.space_ready.notify();
+      }
+   }
+
+   template < class U = T,
+              typename std::enable_if< ! ext_alloc< U >::value >::type* = nullptr >
+   const T& item( const std::size_t index )
+   {
+      return( owner.store[ index ] );
+   }
+
+   template < class U = T,
+              typename std::enable_if< ext_alloc< U >::value >::type* = nullptr >
+   const T& item( const std::size_t index )
+   {
+      return( *owner.store[ index ] );
+   }
+
+   owner_t          &owner;
+   cursor_t         &me;
+   /** private copy of me.pos **/
+   std::uint64_t     pos      = 0;
+   bool              detached = false;
+};
+
+#endif /* END RAFTBROADCAST_TCC */
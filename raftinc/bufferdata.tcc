@@ -27,6 +27,8 @@
 #include <cinttypes>
 #include <iostream>
 #include <type_traits>
+#include <atomic>
+#include <algorithm>
 #if defined __APPLE__ || defined __linux
 #include <sys/mman.h>
 #include <shm>
@@ -36,6 +38,8 @@
 #include "ringbuffertypes.hpp"
 #include "signal.hpp"
 #include "database.tcc"
+#include "mirrormem.hpp"
+#include "ringspan.hpp"
 
 #include "alloc_traits.tcc"
 #include "defs.hpp"
@@ -85,44 +89,41 @@ template < class T > struct Data< T,
 
 
    Data( const std::size_t max_cap , 
-         const std::size_t align = 16 ) : DataBase< T >( max_cap )
+         const std::size_t align = 16,
+         const raft::placement &place = raft::placement() ) : DataBase< T >( max_cap )
    {
-
-#if (defined __linux ) || (defined __APPLE__ )
-      int ret_val( 0 );
-      ret_val = posix_memalign( (void**)&((this)->store), 
-                                 align, 
-                                (this)->length_store );
-      if( ret_val != 0 )
+      /** huge pages and/or a NUMA node asked for, see placement.hpp **/
+      if( ! (this)->map_store( place ) )
       {
-         std::cerr << "posix_memalign returned error code (" << ret_val << ")";
-         std::cerr << " with message: \n" << strerror( ret_val ) << "\n";
-         exit( EXIT_FAILURE );
-      }
+#if (defined __linux ) || (defined __APPLE__ )
+         int ret_val( 0 );
+         ret_val = posix_memalign( (void**)&((this)->store), 
+                                    align, 
+                                   (this)->length_store );
+         if( ret_val != 0 )
+         {
+            std::cerr << "posix_memalign returned error code (" << ret_val << ")";
+            std::cerr << " with message: \n" << strerror( ret_val ) << "\n";
+            exit( EXIT_FAILURE );
+         }
 #elif (defined _WIN64 ) || (defined _WIN32) 
-      (this)->store = reinterpret_cast< T* >(  _aligned_malloc( (this)->length_store, align ) );
+         (this)->store = reinterpret_cast< T* >(  _aligned_malloc( (this)->length_store, align ) );
 #else
-      /** 
-       * would use the array allocate, but well...we'd have to 
-       * figure out how to free it
-       */
-      (this)->store = reinterpret_cast< T* >( malloc( (this)->length_store ) );
+         /** 
+          * would use the array allocate, but well...we'd have to 
+          * figure out how to free it
+          */
+         (this)->store = reinterpret_cast< T* >( malloc( (this)->length_store ) );
 #endif
-      //FIXME - this should be an exception 
-      assert( (this)->store != nullptr );
+         //FIXME - this should be an exception 
+         assert( (this)->store != nullptr );
 #if (defined __linux ) || (defined __APPLE__ )
-      posix_madvise( (this)->store, 
-                     (this)->length_store,  
-                     POSIX_MADV_SEQUENTIAL );
+         posix_madvise( (this)->store, 
+                        (this)->length_store,  
+                        POSIX_MADV_SEQUENTIAL );
 #endif
-      (this)->signal = (Signal*)       calloc( (this)->max_cap,
-                                               sizeof( Signal ) );
-      if( (this)->signal == nullptr )
-      {
-         //FIXME - this should be an exception too
-         perror( "Failed to allocate signal queue!" );
-         exit( EXIT_FAILURE );
       }
+      /** signal slots are only allocated if needed, see slots() **/
       /** allocate read and write pointers **/
       /** TODO, see if there are optimizations to be made with sizing and alignment **/
       new ( &(this)->read_pt ) Pointer( max_cap );
@@ -138,8 +139,10 @@ template < class T > struct Data< T,
     * "other" unless you are very certain how the implementation
     * works as very bad things might happen.
     * @param other - DataBase< T >*, to be copied
+    * @param copied - positions below this are already copied
     */
-   virtual void copyFrom( DataBase< T > *other )
+   virtual void copyFrom( DataBase< T > *other, 
+                          const std::uint64_t copied )
    {
         if( other->external_alloc )
         {
@@ -155,24 +158,17 @@ template < class T > struct Data< T,
         UNUSED( ptr );
         (this)->is_valid = other->is_valid;
 
-        /** buffer is already alloc'd, copy **/
-        std::memcpy( (void*)(this)->store /* dst */,
-                     (void*)other->store  /* src */,
-                     other->length_store );
-        
-        /** copy signal buff **/
-        std::memcpy( (void*)(this)->signal /* dst */,
-                     (void*)other->signal  /* src */,
-                     other->length_signal );
+        /** buffer is already alloc'd, copy whatever is left **/
+        const auto rpt( Pointer::position( (this)->read_pt  ) );
+        const auto wpt( Pointer::position( (this)->write_pt ) );
+        (this)->copyItems( other, std::max( rpt, copied ), wpt );
+        (this)->copySignals( other, rpt, wpt );
         /** stats objects are still valid, copy the ptrs over **/
         
         (this)->read_stats  = other->read_stats; 
         (this)->write_stats = other->write_stats;
         /** since we might use this as a min size, make persistent **/
         (this)->force_resize = other->force_resize;
-        /** everything should be put back together now **/
-        (this)->thread_access[ 0 ] = other->thread_access[ 0 ]; 
-        (this)->thread_access[ 1 ] = other->thread_access[ 1 ];
    }
 
 
@@ -181,11 +177,7 @@ template < class T > struct Data< T,
       //FREE USED HERE
       if( ! (this)->external_alloc )
       {
-#if (defined _WIN64 ) || (defined _WIN32)
-		 _aligned_free( (this)->store );
-#else
-         free( (this)->store );
-#endif
+         (this)->release_store( (this)->store, (this)->length_mapped );
       }
       free( (this)->signal );
    }
@@ -229,44 +221,41 @@ template < class T >
 
 
    Data( const std::size_t max_cap , 
-         const std::size_t align = 16 ) : ourtype_t( max_cap )
+         const std::size_t align = 16,
+         const raft::placement &place = raft::placement() ) : ourtype_t( max_cap )
    {
-
-#if (defined __linux ) || (defined __APPLE__ )
-      const auto ret_val = posix_memalign( (void**)&((this)->store), 
-                                           align, 
-                                           (this)->length_store );
-      if( ret_val != 0 )
+      /** huge pages and/or a NUMA node asked for, see placement.hpp **/
+      if( ! (this)->map_store( place ) )
       {
-         std::cerr << "posix_memalign returned error code (" << ret_val << ")";
-         std::cerr << " with message: \n" << strerror( ret_val ) << "\n";
-         exit( EXIT_FAILURE );
-      }
+#if (defined __linux ) || (defined __APPLE__ )
+         const auto ret_val = posix_memalign( (void**)&((this)->store), 
+                                              align, 
+                                              (this)->length_store );
+         if( ret_val != 0 )
+         {
+            std::cerr << "posix_memalign returned error code (" << ret_val << ")";
+            std::cerr << " with message: \n" << strerror( ret_val ) << "\n";
+            exit( EXIT_FAILURE );
+         }
 #elif (defined _WIN64 ) || (defined _WIN32) 
-      (this)->store = reinterpret_cast< type_t* >(  _aligned_malloc( (this)->length_store, align ) );
+         (this)->store = reinterpret_cast< type_t* >(  _aligned_malloc( (this)->length_store, align ) );
 #else
-      /** 
-       * would use the array allocate, but well...we'd have to 
-       * figure out how to free it
-       */
-      (this)->store = reinterpret_cast< type_t* >( malloc( (this)->length_store ) );
+         /** 
+          * would use the array allocate, but well...we'd have to 
+          * figure out how to free it
+          */
+         (this)->store = reinterpret_cast< type_t* >( malloc( (this)->length_store ) );
 #endif
-      //FIXME - this should be an exception 
-      assert( (this)->store != nullptr );
-      
+         //FIXME - this should be an exception 
+         assert( (this)->store != nullptr );
+         
 #if (defined __linux ) || (defined __APPLE__ )
-      posix_madvise( (this)->store, 
-                     (this)->length_store,  
-                     POSIX_MADV_SEQUENTIAL );
+         posix_madvise( (this)->store, 
+                        (this)->length_store,  
+                        POSIX_MADV_SEQUENTIAL );
 #endif
-        errno = 0;
-        (this)->signal = (Signal*)       calloc( (this)->max_cap,
-                                                 sizeof( Signal ) );
-        if( (this)->signal == nullptr )
-        {
-           perror( "Failed to allocate signal queue!" );
-           exit( EXIT_FAILURE );
-        }
+      }
+        /** signal slots are only allocated if needed, see slots() **/
         /** allocate read and write pointers **/
         new ( &(this)->read_pt ) Pointer( max_cap );
         new ( &(this)->write_pt) Pointer( max_cap ); 
@@ -274,7 +263,8 @@ template < class T >
         new ( &(this)->write_stats ) Blocked();
    }
    
-   virtual void copyFrom( ourtype_t *other )
+   virtual void copyFrom( ourtype_t *other, 
+                          const std::uint64_t copied )
    {
         if( other->external_alloc )
         {
@@ -289,21 +279,15 @@ template < class T >
                                            (this)->max_cap );
         (this)->is_valid = other->is_valid;
 
-        /** buffer is already alloc'd, copy **/
-        std::memcpy( (void*)(this)->store /* dst */,
-                     (void*)other->store  /* src */,
-                     other->length_store );
-        /** copy signal buff **/
-        std::memcpy( (void*)(this)->signal /* dst */,
-                     (void*)other->signal  /* src */,
-                     other->length_signal );
+        /** buffer is already alloc'd, copy whatever is left **/
+        const auto rpt( Pointer::position( (this)->read_pt  ) );
+        const auto wpt( Pointer::position( (this)->write_pt ) );
+        (this)->copyItems( other, std::max( rpt, copied ), wpt );
+        (this)->copySignals( other, rpt, wpt );
         //copy over block stats objects
         (this)->read_stats  = other->read_stats; 
         (this)->write_stats = other->write_stats;
         
-        (this)->thread_access[ 0 ] = other->thread_access[ 0 ]; 
-        (this)->thread_access[ 1 ] = other->thread_access[ 1 ];
-        /** everything should be put back together now **/
    }
 
 
@@ -312,17 +296,595 @@ template < class T >
       //FREE USED HERE
       if( ! (this)->external_alloc )
       {
-#if (defined _WIN64 ) || (defined _WIN32) 
-		 _aligned_free( (this)->store );
+         (this)->release_store( (this)->store, (this)->length_mapped );
+      }
+      free( (this)->signal );
+   }
+
+}; /** end heap > Line Size **/
+
+/**
+ * buffer structure for SPSC storage class, the layout is
+ * exactly that of the heap buffer, the difference is only
+ * in how the ring buffer reads the pointers.
+ */
+template < class T > struct Data< T, Type::SPSC > : public Data< T, Type::Heap >
+{
+   using Data< T, Type::Heap >::Data;
+
+   virtual ~Data() = default;
+}; /** end SPSC **/
+
+
+/**
+ * buffer structure for the mirrored storage class, same layout
+ * as the heap buffer except that the store is mapped twice back
+ * to back (see mirrormem.hpp) so that store[ max_cap + i ] is 
+ * store[ i ]. The capacity is rounded up so that the store fills
+ * whole pages, if the mapping can't be made we fall back to a 
+ * plain heap store and leave mirrored unset.
+ */
+template < class T > struct Data< T, Type::Mirrored > : 
+   public DataBase< typename std::conditional< ext_alloc< T >::value,
+                                               T*, T >::type >
+{
+   using type_t    = typename std::conditional< ext_alloc< T >::value, 
+                                                T*, T >::type;
+   using ourtype_t = DataBase< type_t >;
+
+   Data( T * const ptr, 
+         const std::size_t max_cap,
+         const std::size_t start_position ) : ourtype_t( max_cap )
+   {
+        /** user supplied memory, nothing to mirror **/
+        assert( ptr != nullptr );
+        (this)->store  = reinterpret_cast< type_t* >( ptr );
+        (this)->signal = (Signal*)       calloc( 1,
+                                                 sizeof( Signal ) );
+        if( (this)->signal == nullptr )
+        {
+           perror( "Failed to allocate signal queue!" );
+           exit( EXIT_FAILURE );
+        }
+        /** set index to be start_position **/
+        (this)->signal[ 0 ].index  = start_position; 
+        new ( &(this)->read_pt ) Pointer( max_cap );
+        new ( &(this)->write_pt) Pointer( max_cap, 1 ); 
+        new ( &(this)->read_stats ) Blocked();
+        new ( &(this)->write_stats ) Blocked();
+        (this)->external_alloc = true;
+   }
+
+   Data( const std::size_t max_cap , 
+         const std::size_t align = 16,
+         const raft::placement &place = raft::placement() ) : ourtype_t( mirror_cap( max_cap ) )
+   {
+      /** the mirror is a shared mapping, placement isn't applied **/
+      UNUSED( place );
+      (this)->store = reinterpret_cast< type_t* >( 
+         raft::mirror::alloc( (this)->length_store ) );
+      if( (this)->store != nullptr )
+      {
+         (this)->mirrored = true;
+      }
+      else
+      {
+#if (defined __linux ) || (defined __APPLE__ )
+         const auto ret_val = posix_memalign( (void**)&((this)->store), 
+                                              align, 
+                                              (this)->length_store );
+         if( ret_val != 0 )
+         {
+            std::cerr << "posix_memalign returned error code (" << ret_val << ")";
+            std::cerr << " with message: \n" << strerror( ret_val ) << "\n";
+            exit( EXIT_FAILURE );
+         }
 #else
-         free( (this)->store );
+         UNUSED( align );
+         (this)->store = reinterpret_cast< type_t* >( malloc( (this)->length_store ) );
 #endif
       }
+      //FIXME - this should be an exception 
+      assert( (this)->store != nullptr );
+      /** signal slots are only allocated if needed, see slots() **/
+      new ( &(this)->read_pt ) Pointer( (this)->max_cap );
+      new ( &(this)->write_pt ) Pointer( (this)->max_cap ); 
+      new ( &(this)->read_stats ) Blocked();
+      new ( &(this)->write_stats ) Blocked();
+   }
+
+   virtual void copyFrom( ourtype_t *other, 
+                          const std::uint64_t copied )
+   {
+        if( other->external_alloc )
+        {
+            //FIXME: throw rafterror that is synchronized
+            std::cerr << 
+                "FATAL: Attempting to resize a FIFO that is statically alloc'd\n";
+            exit( EXIT_FAILURE );
+        }
+        new ( &(this)->read_pt  ) Pointer( (other->read_pt),   
+                                           (this)->max_cap );
+        new ( &(this)->write_pt ) Pointer( (other->write_pt), 
+                                           (this)->max_cap );
+        (this)->is_valid = other->is_valid;
+
+        /** buffer is already alloc'd, copy whatever is left **/
+        const auto rpt( Pointer::position( (this)->read_pt  ) );
+        const auto wpt( Pointer::position( (this)->write_pt ) );
+        (this)->copyItems( other, std::max( rpt, copied ), wpt );
+        (this)->copySignals( other, rpt, wpt );
+        (this)->read_stats  = other->read_stats; 
+        (this)->write_stats = other->write_stats;
+        (this)->force_resize = other->force_resize;
+   }
+
+   virtual ~Data()
+   {
+      if( ! (this)->external_alloc )
+      {
+         if( (this)->mirrored )
+         {
+            raft::mirror::free( (this)->store, (this)->length_store );
+         }
+         else
+         {
+            (this)->release_store( (this)->store, (this)->length_mapped );
+         }
+      }
       free( (this)->signal );
    }
 
-}; /** end heap > Line Size **/
+   /**
+    * mirror_cap - smallest capacity >= n whose store is a 
+    * whole number of pages. The page size is a power of two
+    * so the rounding unit is too, i.e., a power of two n 
+    * stays a power of two.
+    * @param   n - const std::size_t, requested capacity
+    * @return  std::size_t
+    */
+   static std::size_t mirror_cap( const std::size_t n ) noexcept
+   {
+      const auto page( raft::mirror::granularity() );
+      if( page == 0 )
+      {
+         return( n );
+      }
+      /** gcd of a power of two and x is x's lowest set bit, capped **/
+      const std::size_t low_bit( sizeof( type_t ) & ( ~sizeof( type_t ) + 1 ) );
+      const std::size_t unit( page / std::min( page, low_bit ) );
+      return( ( ( n + unit - 1 ) / unit ) * unit );
+   }
+}; /** end Mirrored **/
+
+/**
+ * buffer structure for the unbounded (Type::Infinite) storage 
+ * class. Items live in a singly linked list of segments, each 
+ * cache line aligned with its items and signals in one block. 
+ * The producer appends at the tail and links in a new segment 
+ * when the current one fills, the consumer reads from the head 
+ * and hands segments it's done with back through a free list 
+ * that the producer takes from before going to the heap. Single
+ * producer, single consumer, the producer never blocks. max_cap
+ * is the number of items per segment, a range bigger than that 
+ * gets a segment of its own.
+ */
+template < class T > struct Data< T, Type::Infinite > : 
+   public DataBase< typename std::conditional< ext_alloc< T >::value,
+                                               T*, T >::type >
+{
+   using type_t    = typename std::conditional< ext_alloc< T >::value, 
+                                                T*, T >::type;
+   using ourtype_t = DataBase< type_t >;
+
+   struct ALIGN( L1D_CACHE_LINE_SIZE ) segment
+   {
+      segment( const std::size_t cap,
+               type_t * const items,
+               Signal * const signal ) : cap( cap ),
+                                         items( items ),
+                                         signal( signal ){}
+      /** next in the queue, or in the free list **/
+      std::atomic< segment* >  next = { nullptr };
+      const std::size_t        cap;
+      type_t * const           items;
+      Signal * const           signal;
+   };
+
+   Data( const std::size_t max_cap,
+         const std::size_t align = 16,
+         const raft::placement &place = raft::placement() ) : ourtype_t( std::max< std::size_t >( max_cap, 1 ) )
+   {
+      UNUSED( align );
+      UNUSED( place );
+      auto * const first( alloc_segment( (this)->max_cap ) );
+      producer.tail = first;
+      consumer.head = first;
+   }
+
+   /** never resized, see RingBuffer< T, Type::Infinite > **/
+   virtual void copyFrom( ourtype_t *other, 
+                          const std::uint64_t copied )
+   {
+      UNUSED( other );
+      UNUSED( copied );
+      assert( false );
+   }
+
+   virtual ~Data()
+   {
+      /** everything from the head on is still linked **/
+      auto *seg( consumer.head );
+      while( seg != nullptr )
+      {
+         auto * const next( seg->next.load( std::memory_order_relaxed ) );
+         free_segment( seg );
+         seg = next;
+      }
+      seg = free_list.load( std::memory_order_relaxed );
+      while( seg != nullptr )
+      {
+         auto * const next( seg->next.load( std::memory_order_relaxed ) );
+         free_segment( seg );
+         seg = next;
+      }
+   }
+
+   /**
+    * size - items published by the producer that the consumer
+    * hasn't released yet, read first so this can't go negative.
+    * @return std::size_t
+    */
+   std::size_t size() const noexcept
+   {
+      const auto rpt( consumer.read.load( std::memory_order_acquire ) );
+      const auto wpt( producer.written.load( std::memory_order_acquire ) );
+      return( static_cast< std::size_t >( wpt - rpt ) );
+   }
+
+   /**
+    * reserve - producer only, returns the next n free slots
+    * (and their signals) without publishing them. The range
+    * can cover the end of the tail segment and the start of
+    * one new segment, so it's at most two spans. Calling this
+    * again before commit just hands back the same slots.
+    * @param   n - const std::size_t
+    * @param   slots - raft::span_pair< type_t >&
+    * @param   sigs  - raft::span_pair< Signal >&
+    */
+   void reserve( const std::size_t n,
+                 raft::span_pair< type_t > &slots,
+                 raft::span_pair< Signal > &sigs )
+   {
+      auto &pd( producer );
+      if( pd.tail_idx == pd.tail->cap )
+      {
+         /** tail is full, start a new one **/
+         auto *next( pd.tail->next.load( std::memory_order_relaxed ) );
+         if( next == nullptr )
+         {
+            next = get_segment( (this)->max_cap );
+            pd.tail->next.store( next, std::memory_order_release );
+         }
+         pd.tail     = next;
+         pd.tail_idx = 0;
+         update_high_water();
+      }
+      const std::size_t avail( pd.tail->cap - pd.tail_idx );
+      if( n <= avail )
+      {
+         slots = raft::span_pair< type_t >( pd.tail->items, pd.tail->cap, 
+                                            pd.tail_idx, n );
+         sigs  = raft::span_pair< Signal >( pd.tail->signal, pd.tail->cap,
+                                            pd.tail_idx, n );
+         return;
+      }
+      const std::size_t rest( n - avail );
+      auto *next( pd.tail->next.load( std::memory_order_relaxed ) );
+      if( next != nullptr && next->cap < rest )
+      {
+         /** left over from a bigger reserve that wasn't committed **/
+         pd.tail->next.store( nullptr, std::memory_order_relaxed );
+         put_segment( next );
+         next = nullptr;
+      }
+      if( next == nullptr )
+      {
+         next = get_segment( std::max( (this)->max_cap, rest ) );
+         /** 
+          * safe to link before the items are published, the 
+          * consumer only follows next once written says there
+          * are items past the end of this segment.
+          */
+         pd.tail->next.store( next, std::memory_order_release );
+      }
+      slots.first  = raft::span< type_t >( pd.tail->items + pd.tail_idx, avail );
+      slots.second = raft::span< type_t >( next->items, rest );
+      sigs.first   = raft::span< Signal >( pd.tail->signal + pd.tail_idx, avail );
+      sigs.second  = raft::span< Signal >( next->signal, rest );
+   }
+
+   /**
+    * commit - producer only, publishes the n slots returned 
+    * by the last reserve call.
+    * @param   n - const std::size_t
+    */
+   void commit( const std::size_t n ) noexcept
+   {
+      auto &pd( producer );
+      const std::size_t avail( pd.tail->cap - pd.tail_idx );
+      if( n <= avail )
+      {
+         pd.tail_idx      += n;
+         pd.written_local += n;
+      }
+      else
+      {
+         pd.tail     = pd.tail->next.load( std::memory_order_relaxed );
+         pd.tail_idx = n - avail;
+         pd.written_local += n;
+         update_high_water();
+      }
+      pd.written.store( pd.written_local, std::memory_order_release );
+   }
+
+   /**
+    * front - consumer only, the n items at the head of the queue
+    * as at most two spans, n must be <= size(). Returns false if
+    * the items cover more than two segments.
+    * @param   n - const std::size_t
+    * @param   items - raft::span_pair< type_t >&
+    * @param   sigs  - raft::span_pair< Signal >&
+    * @return  bool
+    */
+   bool front( const std::size_t n,
+               raft::span_pair< type_t > &items,
+               raft::span_pair< Signal > &sigs ) noexcept
+   {
+      auto &cd( consumer );
+      if( n > 0 && cd.head_idx == cd.head->cap )
+      {
+         next_head();
+      }
+      const std::size_t avail( cd.head->cap - cd.head_idx );
+      if( n <= avail )
+      {
+         items = raft::span_pair< type_t >( cd.head->items, cd.head->cap,
+                                            cd.head_idx, n );
+         sigs  = raft::span_pair< Signal >( cd.head->signal, cd.head->cap,
+                                            cd.head_idx, n );
+         return( true );
+      }
+      auto * const next( cd.head->next.load( std::memory_order_acquire ) );
+      const std::size_t rest( n - avail );
+      if( next->cap < rest )
+      {
+         return( false );
+      }
+      items.first  = raft::span< type_t >( cd.head->items + cd.head_idx, avail );
+      items.second = raft::span< type_t >( next->items, rest );
+      sigs.first   = raft::span< Signal >( cd.head->signal + cd.head_idx, avail );
+      sigs.second  = raft::span< Signal >( next->signal, rest );
+      return( true );
+   }
+
+   /**
+    * visit - consumer only, calls f( items, sigs ) with a 
+    * raft::span for each run of contiguous items among the n
+    * at the head of the queue without releasing them, n must 
+    * be <= size().
+    * @param   n - std::size_t
+    * @param   f - F&&, void( raft::span< type_t >, raft::span< Signal > )
+    */
+   template < class F > void visit( std::size_t n, F &&f ) const
+   {
+      auto       *seg( consumer.head );
+      std::size_t idx( consumer.head_idx );
+      while( n > 0 )
+      {
+         if( idx == seg->cap )
+         {
+            seg = seg->next.load( std::memory_order_acquire );
+            idx = 0;
+         }
+         const std::size_t step( std::min( n, seg->cap - idx ) );
+         f( raft::span< type_t >( seg->items  + idx, step ),
+            raft::span< Signal >( seg->signal + idx, step ) );
+         idx += step;
+         n   -= step;
+      }
+   }
+
+   /**
+    * consume - consumer only, releases the n items at the 
+    * head of the queue, n must be <= size(). Items with a 
+    * destructor must already have been destroyed.
+    * @param   n - const std::size_t
+    */
+   void consume( std::size_t n ) noexcept
+   {
+      auto &cd( consumer );
+      const auto total( n );
+      while( n > 0 )
+      {
+         if( cd.head_idx == cd.head->cap )
+         {
+            next_head();
+         }
+         const std::size_t step( std::min( n, cd.head->cap - cd.head_idx ) );
+         cd.head_idx += step;
+         n           -= step;
+      }
+      cd.read_local += total;
+      cd.read.store( cd.read_local, std::memory_order_release );
+   }
+
+   /**
+    * high_water_mark - most items queued at once, sampled 
+    * each time the producer moves to a new segment so it's 
+    * accurate to within a segment.
+    * @return std::size_t
+    */
+   std::size_t high_water_mark() const noexcept
+   {
+      return( high_water.load( std::memory_order_relaxed ) );
+   }
+
+   /**
+    * bytes - memory currently held in segments, including the
+    * ones parked on the free list.
+    * @return std::size_t
+    */
+   std::size_t bytes() const noexcept
+   {
+      return( allocated_bytes.load( std::memory_order_relaxed ) );
+   }
+
+private:
+   static constexpr std::size_t round_line( const std::size_t n ) noexcept
+   {
+      return( ( n + L1D_CACHE_LINE_SIZE - 1 ) & ~( std::size_t( L1D_CACHE_LINE_SIZE ) - 1 ) );
+   }
+
+   static constexpr std::size_t segment_bytes( const std::size_t cap ) noexcept
+   {
+      return( round_line( sizeof( segment ) ) + 
+              round_line( sizeof( type_t ) * cap ) + 
+              sizeof( Signal ) * cap );
+   }
+
+   segment* alloc_segment( const std::size_t cap )
+   {
+      const auto length( segment_bytes( cap ) );
+      void *mem( nullptr );
+#if (defined __linux ) || (defined __APPLE__ )
+      if( posix_memalign( &mem, L1D_CACHE_LINE_SIZE, length ) != 0 )
+      {
+         mem = nullptr;
+      }
+#else
+      mem = malloc( length );
+#endif
+      if( mem == nullptr )
+      {
+         //FIXME - this should be an exception 
+         perror( "Failed to allocate FIFO segment!" );
+         exit( EXIT_FAILURE );
+      }
+      auto * const base( reinterpret_cast< std::uint8_t* >( mem ) );
+      auto * const items( reinterpret_cast< type_t* >( 
+         base + round_line( sizeof( segment ) ) ) );
+      auto * const sigs( reinterpret_cast< Signal* >( 
+         base + round_line( sizeof( segment ) ) + 
+                round_line( sizeof( type_t ) * cap ) ) );
+      /** all raft::none, as calloc would give **/
+      std::memset( (void*) sigs, 0, sizeof( Signal ) * cap );
+      allocated_bytes.fetch_add( length, std::memory_order_relaxed );
+      return( new (mem) segment( cap, items, sigs ) );
+   }
+
+   void free_segment( segment * const seg ) noexcept
+   {
+      allocated_bytes.fetch_sub( segment_bytes( seg->cap ), 
+                                 std::memory_order_relaxed );
+      seg->~segment();
+      free( seg );
+   }
+
+   /** 
+    * get_segment - producer side, standard sized segments come
+    * off the free list if there are any. Only the producer pops 
+    * so there's no ABA problem, a segment can't come back onto
+    * the list while we're looking at it.
+    */
+   segment* get_segment( const std::size_t cap )
+   {
+      if( cap == (this)->max_cap )
+      {
+         auto *seg( free_list.load( std::memory_order_acquire ) );
+         while( seg != nullptr && 
+                ! free_list.compare_exchange_weak( 
+                     seg, 
+                     seg->next.load( std::memory_order_relaxed ),
+                     std::memory_order_acquire,
+                     std::memory_order_acquire ) );
+         if( seg != nullptr )
+         {
+            free_count.fetch_sub( 1, std::memory_order_relaxed );
+            seg->next.store( nullptr, std::memory_order_relaxed );
+            return( seg );
+         }
+      }
+      return( alloc_segment( cap ) );
+   }
+
+   /** put_segment - consumer side, keep a few for the producer **/
+   void put_segment( segment * const seg ) noexcept
+   {
+      if( seg->cap != (this)->max_cap || 
+          free_count.load( std::memory_order_relaxed ) >= max_free_segments )
+      {
+         free_segment( seg );
+         return;
+      }
+      free_count.fetch_add( 1, std::memory_order_relaxed );
+      auto *head( free_list.load( std::memory_order_relaxed ) );
+      do
+      {
+         seg->next.store( head, std::memory_order_relaxed );
+      }while( ! free_list.compare_exchange_weak( head, 
+                                                 seg,
+                                                 std::memory_order_release,
+                                                 std::memory_order_relaxed ) );
+   }
+
+   /** consumer only, head is used up and there are more items **/
+   void next_head() noexcept
+   {
+      auto &cd( consumer );
+      auto * const next( cd.head->next.load( std::memory_order_acquire ) );
+      assert( next != nullptr );
+      put_segment( cd.head );
+      cd.head     = next;
+      cd.head_idx = 0;
+   }
+
+   void update_high_water() noexcept
+   {
+      const auto queued( static_cast< std::size_t >( 
+         producer.written_local - 
+            consumer.read.load( std::memory_order_relaxed ) ) );
+      if( queued > high_water.load( std::memory_order_relaxed ) )
+      {
+         high_water.store( queued, std::memory_order_relaxed );
+      }
+   }
+
+   /** segments kept on the free list, the rest go back to the heap **/
+   static constexpr std::size_t max_free_segments = 8;
+
+   struct ALIGN( L1D_CACHE_LINE_SIZE )
+   {
+      segment                      *tail          = nullptr;
+      std::size_t                   tail_idx      = 0;
+      std::uint64_t                 written_local = 0;
+      std::atomic< std::uint64_t >  written       = { 0 };
+   } producer;
+
+   struct ALIGN( L1D_CACHE_LINE_SIZE )
+   {
+      segment                      *head          = nullptr;
+      std::size_t                   head_idx      = 0;
+      std::uint64_t                 read_local    = 0;
+      std::atomic< std::uint64_t >  read          = { 0 };
+   } consumer;
 
+   ALIGN( L1D_CACHE_LINE_SIZE ) 
+      std::atomic< segment* >       free_list       = { nullptr };
+   std::atomic< std::size_t >       free_count      = { 0 };
+   std::atomic< std::size_t >       high_water      = { 0 };
+   std::atomic< std::size_t >       allocated_bytes = { 0 };
+}; /** end Infinite **/
 
 #if defined __APPLE__ || defined __linux
 
@@ -486,9 +1048,11 @@ template < class T > struct Data< T, Type::SharedMemory > :
                    true );
        }
 
-       virtual void copyFrom( DataBase< T > *other )
+       virtual void copyFrom( DataBase< T > *other, 
+                              const std::uint64_t copied )
        {
           UNUSED( other );
+          UNUSED( copied );
           assert( false );
           /** TODO, implement me **/
        }
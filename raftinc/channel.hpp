@@ -0,0 +1,307 @@
+/**
+ * channel.hpp - typed port access with the ring type known at
+ * compile time, returned by input.channel< T, type >( name ) /
+ * output.channel< T, type >( name ). Calls on a FIFO go through
+ * void* and a virtual call into RingBufferBase< T, type >, so
+ * the compiler can't inline any of it even where the kernel
+ * knows both the item type and what the link gives it. The
+ * calls here are plain member functions that cast the port's
+ * FIFO to RingBufferBase< T, type > once and then call its
+ * local_* functions by qualified name, which doesn't go through
+ * the vtable. For rings of plain types push and pop first try 
+ * the ring's try_push / try_pop, which are small enough to be
+ * inlined into run(), and only make the blocking call if the
+ * ring is full (empty) or being resized. channelbench shows 
+ * what that saves.
+ *
+ * The FIFO interface is unchanged and still what the schedulers,
+ * dynalloc and anything else that doesn't know the type use.
+ *
+ * Like port_handle (porthandle.hpp) the channel keeps the
+ * port's PortInfo and checks on each call that the FIFO is the
+ * one it cast last time, so it follows a resize (same FIFO) or
+ * the FIFO being swapped. type has to be what the link asked
+ * for, Type::Heap by default. Only the single ring types can
+ * be used, the first call throws PortTypeMismatchException if
+ * the port has a FanIn or Broadcast FIFO or a ring of another
+ * type, use the port or a port_handle for those.
+ * @author: agent
+ * @version: Sat Oct 17 00:35:05 2026
+ *
+ * Copyright 2026 agent
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at:
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef RAFTCHANNEL_HPP
+#define RAFTCHANNEL_HPP  1
+#include <cassert>
+#include <cstddef>
+#include <string>
+#include <typeinfo>
+#include <utility>
+#include "fifo.hpp"
+#include "port_info.hpp"
+#include "ringbuffertypes.hpp"
+#include "ringbufferbase.tcc"
+#include "alloc_traits.tcc"
+#include "slabpool.tcc"
+#include "portexception.hpp"
+#include "common.hpp"
+#include "defs.hpp"
+
+namespace raft
+{
+
+template < class T, Type::RingBufferType type = Type::Heap > class channel
+{
+   using ring_t = RingBufferBase< T, type >;
+public:
+   /** unbound, assign one from channel< T, type >() before use **/
+   channel() = default;
+
+   explicit channel( PortInfo * const info ) : info( info )
+   {
+      assert( info != nullptr );
+   }
+
+   /** fifo - the FIFO behind the port, for anything not below **/
+   FIFO& fifo()
+   {
+      return( *ring() );
+   }
+
+   std::size_t size()
+   {
+      return( ring()->ring_t::size() );
+   }
+
+   std::size_t space_avail()
+   {
+      return( ring()->ring_t::space_avail() );
+   }
+
+   std::size_t capacity()
+   {
+      return( ring()->ring_t::capacity() );
+   }
+
+   /** allocate / send / deallocate - as FIFO::allocate etc. **/
+   template < class... Args > T& allocate( Args&&... params )
+   {
+      void *ptr( nullptr );
+      ring()->ring_t::local_allocate( &ptr );
+      return( construct( ptr, std::forward< Args >( params )... ) );
+   }
+
+   void send( const raft::signal signal = raft::none )
+   {
+      ring()->ring_t::send( signal );
+   }
+
+   void deallocate()
+   {
+      ring()->ring_t::deallocate();
+   }
+
+   void push( const T &item, const raft::signal signal = raft::none )
+   {
+      fast_push( ring(), item, signal, 0 );
+   }
+
+   /** moves class types in, anything else is copied anyway **/
+   void push( T &&item, const raft::signal signal = raft::none )
+   {
+      if( inline_nonclass_alloc< T >::value )
+      {
+         fast_push( ring(), item, signal, 0 );
+      }
+      else
+      {
+         ring()->ring_t::local_push_move( (void*) &item, signal );
+      }
+   }
+
+   void insert( const T * const items,
+                const std::size_t n,
+                const raft::signal signal = raft::none )
+   {
+      ring()->ring_t::local_insert_n( (const void*) items, n, sizeof( T ), signal );
+   }
+
+   void pop( T &item, raft::signal *signal = nullptr )
+   {
+      fast_pop( ring(), item, signal, 0 );
+   }
+
+   void pop_range( T * const items,
+                   const std::size_t n,
+                   raft::signal * const signals = nullptr )
+   {
+      ring()->ring_t::local_pop_n( (void*) items, n, sizeof( T ), signals );
+   }
+
+   /** peek / unpeek / recycle - as FIFO::peek etc. **/
+   T& peek( raft::signal *signal = nullptr )
+   {
+      void *ptr( nullptr );
+      ring()->ring_t::local_peek( &ptr, signal );
+      return( deref( ptr ) );
+   }
+
+   void unpeek()
+   {
+      ring()->ring_t::unpeek();
+   }
+
+   void recycle( const std::size_t range = 1 )
+   {
+      ring()->ring_t::local_recycle( range );
+   }
+
+private:
+   /**
+    * ring - the port's FIFO as ring_t, only casts again if it
+    * isn't the FIFO from last time.
+    */
+   ring_t* ring()
+   {
+      assert( info != nullptr );
+      FIFO * const f( info->getFIFO() );
+      if( R_UNLIKELY( f != last ) )
+      {
+         bind( f );
+      }
+      return( typed );
+   }
+
+   /**
+    * fast_push / fast_pop - rings of plain items have an inline
+    * try_push / try_pop, the blocking local_* call is only made
+    * when they can't go ahead, the int / long argument picks 
+    * these over the plain versions below when both compile.
+    */
+   template < class R = ring_t >
+   static auto fast_push( R * const r, const T &item,
+                          const raft::signal signal, int )
+      -> decltype( r->R::try_push( item, signal ), void() )
+   {
+      if( R_UNLIKELY( ! r->R::try_push( item, signal ) ) )
+      {
+         r->R::local_push( (void*) &item, signal );
+      }
+   }
+
+   template < class R = ring_t >
+   static void fast_push( R * const r, const T &item,
+                          const raft::signal signal, long )
+   {
+      r->R::local_push( (void*) &item, signal );
+   }
+
+   template < class R = ring_t >
+   static auto fast_pop( R * const r, T &item,
+                         raft::signal * const signal, int )
+      -> decltype( r->R::try_pop( item, signal ), void() )
+   {
+      if( R_UNLIKELY( ! r->R::try_pop( item, signal ) ) )
+      {
+         r->R::local_pop( (void*) &item, signal );
+      }
+   }
+
+   template < class R = ring_t >
+   static void fast_pop( R * const r, T &item,
+                         raft::signal * const signal, long )
+   {
+      r->R::local_pop( (void*) &item, signal );
+   }
+
+   void bind( FIFO * const f )
+   {
+      auto * const r( dynamic_cast< ring_t* >( f ) );
+      if( r == nullptr )
+      {
+         throw PortTypeMismatchException( "channel< " +
+            common::printClassNameFromStr( typeid( T ).name() ) + ", " +
+            type_name() + " > used on port \"" +
+            info->my_name + "\" which doesn't have a ring of that type" );
+      }
+      last  = f;
+      typed = r;
+   }
+
+   static std::string type_name()
+   {
+      switch( type )
+      {
+         case( Type::Heap ):     return( "Type::Heap" );
+         case( Type::SPSC ):     return( "Type::SPSC" );
+         case( Type::Mirrored ): return( "Type::Mirrored" );
+         case( Type::Infinite ): return( "Type::Infinite" );
+         default:                return( std::to_string( type ) );
+      }
+   }
+
+   /** construct - what FIFO::allocate does with the slot **/
+   template < class... Args, class U = T,
+              typename std::enable_if<
+                 inline_nonclass_alloc< U >::value >::type* = nullptr >
+   static T& construct( void * const ptr, Args&&... params )
+   {
+      static_assert( sizeof...( Args ) == 0,
+                     "plain types are allocated without arguments" );
+      return( *reinterpret_cast< T* >( ptr ) );
+   }
+
+   template < class... Args, class U = T,
+              typename std::enable_if<
+                 inline_class_alloc< U >::value >::type* = nullptr >
+   static T& construct( void * const ptr, Args&&... params )
+   {
+      return( *( new (ptr) T( std::forward< Args >( params )... ) ) );
+   }
+
+   template < class... Args, class U = T,
+              typename std::enable_if<
+                 ext_alloc< U >::value >::type* = nullptr >
+   static T& construct( void * const ptr, Args&&... params )
+   {
+      T ** const slot( reinterpret_cast< T** >( ptr ) );
+      *slot = raft::slab_pool< T >::make( std::forward< Args >( params )... );
+      return( **slot );
+   }
+
+   /** deref - inline types are stored in place, ext as T* **/
+   template < class U = T,
+              typename std::enable_if<
+                 inline_alloc< U >::value >::type* = nullptr >
+   static T& deref( void * const ptr )
+   {
+      return( *reinterpret_cast< T* >( ptr ) );
+   }
+
+   template < class U = T,
+              typename std::enable_if<
+                 ext_alloc< U >::value >::type* = nullptr >
+   static T& deref( void * const ptr )
+   {
+      return( **reinterpret_cast< T** >( ptr ) );
+   }
+
+   PortInfo *info  = nullptr;
+   FIFO     *last  = nullptr;
+   ring_t   *typed = nullptr;
+};
+
+} /** end namespace raft **/
+#endif /* END RAFTCHANNEL_HPP */
@@ -23,8 +23,15 @@
 #include "pointer.hpp"
 #include "signal.hpp"
 #include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <algorithm>
 #include "blocked.hpp"
-#include "threadaccess.hpp"
+#include "internaldefs.hpp"
+#include "placement.hpp"
+#include "placemem.hpp"
 
 namespace raft
 {
@@ -43,9 +50,8 @@ template < class T > struct DataBase
 {
     DataBase( const std::size_t max_cap ) : max_cap ( max_cap ),
                                             length_store( sizeof( T ) * max_cap ),
-                                            length_signal( sizeof( T ) * max_cap ),
-                                            dynamic_alloc_size( length_store +
-                                                                length_signal )
+                                            length_signal( sizeof( Signal ) * max_cap ),
+                                            dynamic_alloc_size( length_store )
                                             {}
 
     /** 
@@ -55,9 +61,154 @@ template < class T > struct DataBase
      * in order to get all the data members you wish
      * to copy.
      * @param   other - struct to be copied
+     * @param   copied - items at positions below this were
+     *          already copied with copyItems()
      */
-    virtual void copyFrom( DataBase< T > *other ) = 0;
+    virtual void copyFrom( DataBase< T > *other, 
+                           const std::uint64_t copied ) = 0;
 
+    /**
+     * copyItems - copy the items at positions [begin, end) 
+     * from other into this buffer. Each buffer maps positions
+     * to its own indices, so this works no matter where either
+     * buffer wraps, it takes at most three memcpy calls.
+     * @param   other - DataBase< T >*, source
+     * @param   begin - first position to copy
+     * @param   end   - one past the last position to copy
+     */
+    void copyItems( DataBase< T > * const other, 
+                    std::uint64_t begin, 
+                    const std::uint64_t end ) noexcept
+    {
+        copyRange( other->store, store, other, begin, end );
+    }
+
+    /**
+     * copySignals - copyItems for the signal slots, nothing to
+     * do unless other had to allocate them (see slots()). Only
+     * once both ends are quiesced, the producer allocates them.
+     * @param   other - DataBase< T >*, source
+     * @param   begin - first position to copy
+     * @param   end   - one past the last position to copy
+     */
+    void copySignals( DataBase< T > * const other, 
+                      const std::uint64_t begin, 
+                      const std::uint64_t end ) noexcept
+    {
+        if( other->signal == nullptr )
+        {
+            return;
+        }
+        copyRange( other->signal, slots(), other, begin, end );
+    }
+
+    /**
+     * slots - the per slot signal array, only needed for the
+     * signals that don't fit in the ring's side queue (see 
+     * signalqueue.hpp) so it's allocated the first time one
+     * doesn't. Producer side (or the resize).
+     * @return  Signal*
+     */
+    Signal* slots() noexcept
+    {
+        if( R_UNLIKELY( signal == nullptr ) )
+        {
+            signal = (Signal*) calloc( max_cap, sizeof( Signal ) );
+            if( signal == nullptr )
+            {
+                perror( "Failed to allocate signal queue!" );
+                exit( EXIT_FAILURE );
+            }
+        }
+        return( signal );
+    }
+
+
+    /**
+     * map_store - try to map the store as given by place (see
+     * placement.hpp), keeps place so a resize does the same.
+     * @param   place - const raft::placement&
+     * @return  bool - false if the store should come from the
+     *          heap as usual, store is untouched then
+     */
+    bool map_store( const raft::placement &place ) noexcept
+    {
+        (this)->place = place;
+        if( place.is_default() )
+        {
+            return( false );
+        }
+        std::size_t mapped( 0 );
+        void * const ptr( raft::placemem::alloc( length_store, place, mapped ) );
+        if( ptr == nullptr )
+        {
+            return( false );
+        }
+        store         = reinterpret_cast< T* >( ptr );
+        length_mapped = mapped;
+        return( true );
+    }
+
+    /**
+     * replace_store - map_store for a buffer that already has a
+     * heap store, only while nothing has been written to it.
+     * @param   place - const raft::placement&
+     */
+    void replace_store( const raft::placement &place ) noexcept
+    {
+        if( external_alloc || mirrored )
+        {
+            return;
+        }
+        T * const old( store );
+        const auto old_mapped( length_mapped );
+        if( map_store( place ) )
+        {
+            release_store( old, old_mapped );
+        }
+    }
+
+    /**
+     * release_store - frees a store allocated by the heap
+     * buffers, either mapped by map_store or from the heap.
+     * @param   ptr - T*
+     * @param   mapped - const std::size_t, length_mapped
+     */
+    static void release_store( T * const ptr, const std::size_t mapped ) noexcept
+    {
+        if( mapped != 0 )
+        {
+            raft::placemem::free( ptr, mapped );
+            return;
+        }
+#if (defined _WIN64 ) || (defined _WIN32)
+        _aligned_free( ptr );
+#else
+        free( ptr );
+#endif
+    }
+
+
+    /** copyItems/copySignals, E is T or Signal **/
+    template < class E > void copyRange( const E * const from,
+                                         E * const to,
+                                         DataBase< T > * const other,
+                                         std::uint64_t begin,
+                                         const std::uint64_t end ) noexcept
+    {
+        while( begin < end )
+        {
+            const auto src( Pointer::index( other->read_pt, begin ) );
+            const auto dst( Pointer::index( read_pt, begin ) );
+            const std::size_t n( 
+                std::min< std::uint64_t >( end - begin, 
+                std::min( other->max_cap - src, max_cap - dst ) ) );
+            std::memcpy( (void*)&to[ dst ], 
+                         (const void*)&from[ src ], 
+                         n * sizeof( E ) );
+            begin += n;
+        }
+    }
 
     const std::size_t       max_cap;
     /** sizes, might need to define a local type **/
@@ -68,14 +219,10 @@ template < class T > struct DataBase
 
 
     /**
-     * read/write pointer. the thread_access is in 
-     * between as it's well accessed by both just
-     * as frequently as the pointers themselves, 
-     * so we get decent caching behavior out of 
-     * doing it this way. 
+     * read/write pointer, each is cache line aligned
+     * so the producer and consumer don't share a line. 
      */
     Pointer                 read_pt;
-    ThreadAccess            thread_access[ 2 ];
     Pointer                 write_pt;
     
     /** 
@@ -85,6 +232,15 @@ template < class T > struct DataBase
     T                       *store          = nullptr;
     Signal                  *signal         = nullptr;
     bool                    external_alloc  = false;
+    /** 
+     * true if store[ max_cap + i ] aliases store[ i ], only 
+     * ever set by Data< T, Type::Mirrored >
+     */
+    bool                    mirrored        = false;
+    /** how the store was placed, see placement.hpp **/
+    raft::placement         place;
+    /** non-zero if the store was mapped by map_store **/
+    std::size_t             length_mapped   = 0;
     /** variable set by scheduler, used for shutdown **/
     bool                    is_valid        = true;
     
@@ -25,9 +25,12 @@
 #include <thread>
 #include <atomic>
 #include <cstdint>
+#include <algorithm>
+#include <type_traits>
 
 #include "ringbuffertypes.hpp"
 #include "bufferdata.tcc"
+#include "threadaccess.hpp"
 #include "defs.hpp"
 
 
@@ -51,12 +54,21 @@ public:
       (this)->buffer = buffer;
       /** check to see if buffer is given is resizeable **/
       resizeable     = (  buffer->external_alloc ? false : true ); 
-      /** 
-       * need to set thread access structs, should be two of them, 
-       * one for producer anad other for the consumer. These are 
-       * kept as an array here so, only one ptr.
-       */
-      thread_access = buffer->thread_access;
+      /** lets cached copies of the buffer's indices know they're stale **/
+      generation++;
+   }
+
+   /**
+    * get_generation - returns a counter that is bumped each time
+    * a new buffer is set (i.e., on each resize). Used to tag
+    * copies of the buffer's indices cached by the producer or
+    * consumer, comparing pointers isn't enough since the new
+    * buffer could be allocated at the same address as the old.
+    * @return  std::uint64_t
+    */
+   std::uint64_t get_generation() const noexcept
+   {
+      return( generation );
    }
 
    inline bool is_resizeable() noexcept 
@@ -66,13 +78,32 @@ public:
 
    /**
     * resize - resize the buffer currently held by this
-    * object.  It is expected that the buffer passed in
-    * by the parameter is larger than the current buffer.
+    * object.  The buffer passed in can be larger or smaller
+    * than the current buffer, if it's smaller and can't hold
+    * the items currently queued the resize is abandoned.
     * a second param exit_buffer is also required and
     * should be available from the allocator object calling
     * this function.  When exit_buffer is set to exit, the
     * function returns without actually resizing the buffer
     * since the application has finished.
+    *
+    * The resize is epoch based (see threadaccess.hpp), we 
+    * publish a new epoch and wait for the threads currently 
+    * using each end of this FIFO to pass a safe point, i.e., 
+    * enter any FIFO without holding a reference to this one 
+    * from allocate or peek. Once they have, anyone touching 
+    * this FIFO waits in notResizing() until we're done.  If 
+    * that doesn't happen within a short window the resize is 
+    * completed without a swap so the endpoints can make 
+    * progress, then we try again. 
+    *
+    * Items keep their position across the resize, so the 
+    * buffer can be copied no matter where it is wrapped. Most
+    * of the copying is done before the endpoints are stopped
+    * (see precopy), once they are only the items written since
+    * the last pre-copy round are left. Items the consumer could
+    * change in place through peek() are all copied after the
+    * endpoints are stopped.
     * @param buffer, - Buffer::Data< T, B>
     * @param exit_alloc, - set to false initially, true
     * when the application is complete
@@ -80,53 +111,20 @@ public:
    void resize( Buffer::Data< T, B > *new_buffer, volatile bool &exit_buffer )
    {
       /**
-       * allclear - call this function to see
-       * if all fifo functions have completed
-       * their operations.
+       * fits - the new buffer can take everything that's
+       * currently in the old one, only ever false when 
+       * shrinking.
        */
-      auto allclear( []( ThreadAccess * const thread_access,
-                         std::atomic< std::uint64_t >  * checking_size ) noexcept -> bool
+      auto fits( [&]( Buffer::Data< T, B > * const buff_ptr ) noexcept -> bool
       {
-         assert( thread_access != nullptr );
-         assert( checking_size != nullptr );
-         for( int i( 0 ); i < 2; i++ )
-         {
-            if( thread_access[ i ].whole != 0 )
-            {
-               return( false );
-            }
-         }
-         if( checking_size->load( std::memory_order_relaxed ) != 0 )
-         {
-            return( false );
-         }
-         return( true );
-      } );
-
-      /**
-       * buffercondition - call to see if the 
-       * current buffer state is amenable to
-       * expanding.
-       */
-      auto buffercondition( []( Buffer::Data< T, B > * const buff_ptr ) noexcept -> bool
-      {
-         /** 
-          * there's only a few conditions that you can copy
-          * the ringbuffer in one contiguous section without
-          * having to re-order the elements which is far 
-          * more expensive in most cases than simply waiting.
-          * The only real case is when rpt < wpt.  This should
-          * happen quite a bit but we do have to make sure.  For
-          * other bad things that could happen, see the conditions
-          * in the size() function from the ringbufferheap.tcc 
-          * file.
-          */
-         const auto rpt( Pointer::val( buff_ptr->read_pt  ) );
-         const auto wpt( Pointer::val( buff_ptr->write_pt ) );
-         return( rpt < wpt );
+         const auto rpt( Pointer::position( buff_ptr->read_pt  ) );
+         const auto wpt( Pointer::position( buff_ptr->write_pt ) );
+         return( wpt + (this)->held_back() - rpt <= new_buffer->max_cap );
       } );
       
       auto *old_buffer( get() );
+      /** positions below this are already in new_buffer **/
+      std::uint64_t copied( 0 );
       for(;;)
       {
          /** check to see if program is done **/
@@ -135,43 +133,67 @@ public:
          {
             /** get rid of newly allocated buff, don't need **/
             delete( new_buffer );
-            resizing = false;
             std::this_thread::yield();
             return;
          }
-         /** set resizing global flag **/
-         resizing = true;
-         /** see if everybody is done with the current buffer **/
-         if( allclear( thread_access, &checking_size ) )
+         if( can_precopy )
+         {
+            copied = precopy( old_buffer, new_buffer, copied );
+         }
+         /** 
+          * flag this FIFO first, anybody that sees the new global
+          * epoch is guaranteed to see that this one is resizing.
+          */
+         const auto local_epoch( requested.load( std::memory_order_relaxed ) + 1 );
+         requested.store( local_epoch, std::memory_order_seq_cst );
+         if( (this)->quiesced( ThreadAccess::request() ) )
          {
-            /** check to see if the state of the buffer is good **/
-            if( buffercondition( old_buffer ) )
+            if( fits( old_buffer ) )
             {
                break;
             }
-
+            /** 
+             * shrinking and the queue has filled back up since
+             * the allocator decided to shrink it, forget it.
+             */
+            completed.store( local_epoch, std::memory_order_release );
+            delete( new_buffer );
+            return;
+         }
 #ifdef   PEEKTEST
-            std::cerr << "Peek Loop\n";
+         std::cerr << "Peek Loop\n";
 #endif
-         }
-         resizing = false;
+         /** let the endpoints go again **/
+         completed.store( local_epoch, std::memory_order_release );
          std::this_thread::yield();
       }
       /** 
-       * we can't do this with a simple copy constructor easily as 
-       * at the time of new buffer creation we don't know the state
-       * of the buffer at the time the conditions above were met, so
-       * we have to do it once the happen. 
-       * 
        * At this point nobody should have outstanding references to 
-       * the old buff, free to copy.
+       * the old buff, copy what's left and swap.
        */
-      new_buffer->copyFrom( old_buffer );
+      new_buffer->copyFrom( old_buffer, copied );
+      /** written on a batched edge but not published yet **/
+      const auto wpt( Pointer::position( new_buffer->write_pt ) );
+      new_buffer->copyItems( old_buffer, wpt, wpt + (this)->held_back() );
+      new_buffer->copySignals( old_buffer, wpt, wpt + (this)->held_back() );
       set( new_buffer );
       delete( old_buffer );
-      resizing = false;
+      completed.store( requested.load( std::memory_order_relaxed ), 
+                       std::memory_order_release );
    }
    
+   /**
+    * track_unpublished - pending is the producer's count of
+    * items written past the write pointer but not published
+    * yet (batched edges, see batch.hpp), a resize copies those
+    * too. Only read once the producer is quiesced.
+    * @param   pending - const std::size_t*
+    */
+   void track_unpublished( const std::size_t * const pending ) noexcept
+   {
+      unpublished = pending;
+   }
+
    /**
     * get - returns the current buffer object 
     * @return - Buffer< T, B >*
@@ -185,16 +207,41 @@ public:
    /**
     * enterBuffer - call from the function with the
     * appropriate access key to signal that the buffer
-    * will soon be in use.
+    * will soon be in use. With no resize pending this
+    * does no stores to shared memory, only the held 
+    * bit for allocate and peek on the caller's own 
+    * cache line. Callers must check notResizing() after
+    * this call before touching the buffer.
     * @param - key, dm::access_key
     */
    void enterBuffer( const dm::access_key key ) noexcept
    {
-      /** see lambda below **/
-      set_helper( key, 
-                  static_cast< dm::key_t >( 1 ),
-                  thread_access,
-                  &checking_size );
+      auto &thread( ThreadAccess::local() );
+      if( key == dm::size )
+      {
+         thread.quiesce();
+         /** size can be called from any thread, has to be atomic **/
+         checking_size.fetch_add( 1, std::memory_order_seq_cst );
+         return;
+      }
+      auto &ep( endpoint[ dm::side( key ) ] );
+      if( R_UNLIKELY( ep.owner.load( std::memory_order_relaxed ) != &thread ) )
+      {
+         /** 
+          * new thread for this end (first access or the kernel
+          * moved), has to be visible to a resizer before we 
+          * look at the resize flag in notResizing().
+          */
+         ep.owner.store( &thread, std::memory_order_seq_cst );
+         std::atomic_thread_fence( std::memory_order_seq_cst );
+      }
+      thread.quiesce();
+      if( dm::holds( key ) )
+      {
+         ep.held.store( ep.held.load( std::memory_order_relaxed ) | 
+                           ( 1 << key ), 
+                        std::memory_order_relaxed );
+      }
    }
 
    /**
@@ -205,93 +252,162 @@ public:
     */
    void exitBuffer( const dm::access_key key ) noexcept
    {
-      /** see lambda below **/
-      set_helper( key, 
-                  static_cast< dm::key_t >( 0 ),
-                  thread_access,
-                  &checking_size );
+      if( key == dm::size )
+      {
+         checking_size.fetch_sub( 1, std::memory_order_release );
+         return;
+      }
+      if( dm::holds( key ) )
+      {
+         auto &ep( endpoint[ dm::side( key ) ] );
+         ep.held.store( ep.held.load( std::memory_order_relaxed ) & 
+                           ~( 1 << key ), 
+                        std::memory_order_release );
+      }
+   }
+
+   /**
+    * bothEndsLocal - true if the calling thread was the last
+    * to use both ends of this FIFO.
+    * @return  bool
+    */
+   bool bothEndsLocal() noexcept
+   {
+      auto * const me( &ThreadAccess::local() );
+      return( endpoint[ 0 ].owner.load( std::memory_order_relaxed ) == me &&
+              endpoint[ 1 ].owner.load( std::memory_order_relaxed ) == me );
    }
 
    /**
     * notResizing - called by various fifo functions
-    * to check first entry flag before signalling enterBuffer()
+    * after enterBuffer() to check that the buffer is 
+    * safe to access. 
     * @return bool - currently not resizing 
     */
    bool notResizing() noexcept
    {
-      return( R_UNLIKELY( ! resizing ) ); 
+      return( R_LIKELY( completed.load( std::memory_order_acquire ) == 
+                        requested.load( std::memory_order_acquire ) ) ); 
    }
    
 
 private:
-   Buffer::Data< T, B > *buffer              = nullptr; 
-   volatile bool         resizing            =  false;
-
-   bool                  resizeable          = true;
-   
-   /** defined in threadaccess.hpp **/
-   ThreadAccess *thread_access = nullptr;
-  
-   std::atomic< std::uint64_t >  checking_size = { 0 };
-
-   static inline void set_helper( const dm::access_key key, 
-                                  const dm::key_t      val,
-                                  ThreadAccess *thread_access,
-                                  std::atomic< 
-                                    std::uint64_t > * const checking_size ) noexcept
+   /** held_back - see track_unpublished() **/
+   std::size_t held_back() const noexcept
    {
-      assert( thread_access != nullptr );
-      assert( checking_size != nullptr );
+      return( unpublished == nullptr ? 0 : *unpublished );
+   }
 
-      switch( key )
+   /**
+    * precopy - copy the items currently in old_buffer into 
+    * new_buffer while the producer and consumer keep going.
+    * Anything at a position >= the read position stays put
+    * in the old buffer (the producer can only overwrite it
+    * once the consumer has moved past), so these copies stay
+    * good as long as the item hasn't been consumed. Runs a 
+    * few rounds, each only copying what was written during
+    * the last one.
+    * @param   old_buffer - current buffer
+    * @param   new_buffer - buffer being resized to
+    * @param   copied - positions below this were already copied
+    * @return  std::uint64_t - new value for copied
+    */
+   static std::uint64_t precopy( Buffer::Data< T, B > * const old_buffer,
+                                 Buffer::Data< T, B > * const new_buffer,
+                                 std::uint64_t copied ) noexcept
+   {
+      for( int round( 0 ); round < max_precopy_rounds; round++ )
       {
-         case( dm::allocate ):
-         {
-            thread_access[ 0 ].flag[ dm::allocate ] = val;
-         }
-         break;
-         case( dm::allocate_range ):
-         {
-            thread_access[ 0 ].flag[ dm::allocate_range ] = val;
-         }
-         break;
-         case( dm::push ):
-         {
-            thread_access[ 0 ].flag[ dm::push ] = val;
-         }
-         break;
-         case( dm::recycle ):
-         {
-            thread_access[ 1 ].flag[ dm::recycle ] = val;
-         }
-         break;
-         case( dm::pop ):
+         const auto rpt( Pointer::position( old_buffer->read_pt  ) );
+         const auto wpt( Pointer::position( old_buffer->write_pt ) );
+         const auto begin( std::max( rpt, copied ) );
+         /** nothing (or too much, when shrinking) to copy **/
+         if( wpt <= begin + 1 || wpt - rpt > new_buffer->max_cap )
          {
-            thread_access[ 1 ].flag[ dm::pop ] = val;
+            break;
          }
-         break;
-         case( dm::peek ):
+         new_buffer->copyItems( old_buffer, begin, wpt );
+         copied = wpt;
+      }
+      return( copied );
+   }
+
+   /**
+    * quiesced - spin for a short window waiting for the
+    * threads at both ends to pass epoch without holding
+    * a reference into this FIFO, and for any callers of 
+    * size() to leave.
+    * @param   epoch - const std::uint64_t
+    * @return  bool - true if the buffer is safe to swap 
+    */
+   bool quiesced( const std::uint64_t epoch ) noexcept
+   {
+      auto safe( [&]( endpoint_t &ep ) noexcept -> bool
+      {
+         auto * const owner( ep.owner.load( std::memory_order_seq_cst ) );
+         /** no owner yet, will see the resize flag on the way in **/
+         if( owner != nullptr && ! owner->passed( epoch ) )
          {
-            thread_access[ 1 ].flag[ dm::peek ] = val;
+            return( false );
          }
-         break;
-         case( dm::size ):
+         return( ep.held.load( std::memory_order_acquire ) == 0 );
+      } );
+      for( std::size_t i( 0 ); i < max_ack_spins; i++ )
+      {
+         if( safe( endpoint[ 0 ] ) && 
+             safe( endpoint[ 1 ] ) &&
+             checking_size.load( std::memory_order_seq_cst ) == 0 )
          {
-            /** this one has to be atomic, multiple updaters **/
-            if( val == 0 )
-            {
-                checking_size->fetch_sub( 1, std::memory_order_relaxed );
-            }
-            else
-            {
-                checking_size->fetch_add( 1, std::memory_order_relaxed );
-            }
+            return( true );
          }
-         break;
-         default:
-            assert( false );
+         std::this_thread::yield();
       }
-      return;
+      return( false );
    }
+
+   /**
+    * can_precopy - a queued item can be changed in place by
+    * the consumer through peek() without popping it, an early
+    * copy of a class that owns memory (std::string, say) would
+    * then be stale. Trivially copyable items are fine, as are
+    * the pointers stored for externally allocated ones.
+    */
+   static constexpr bool can_precopy = ext_alloc< T >::value ||
+                                       std::is_trivially_copyable< T >::value;
+
+   /** how long to wait for the endpoints before giving them back the buffer **/
+   static constexpr std::size_t max_ack_spins = 1024;
+   /** see precopy() **/
+   static constexpr int         max_precopy_rounds = 4;
+   
+   /** 
+    * read mostly, written by the resizer only. The buffer
+    * is being resized while requested != completed.
+    */
+   Buffer::Data< T, B > *buffer              = nullptr; 
+   bool                  resizeable          = true;
+   /** see get_generation() **/
+   std::uint64_t         generation          = 0;
+   std::atomic< std::uint64_t > requested    = { 0 };
+   std::atomic< std::uint64_t > completed    = { 0 };
+   /** see track_unpublished() **/
+   const std::size_t    *unpublished         = nullptr;
+   
+   /** 
+    * endpoint_t - state for one end of the FIFO, the thread
+    * currently using it and the held bits for access keys 
+    * that leave references into the buffer (dm::holds).
+    * Only written by that thread.
+    */
+   struct ALIGN( L1D_CACHE_LINE_SIZE ) endpoint_t
+   {
+      std::atomic< ThreadAccess* >  owner = { nullptr };
+      std::atomic< std::uint64_t >  held  = { 0 };
+   };
+   /** producer then consumer **/
+   endpoint_t            endpoint[ 2 ];
+  
+   ALIGN( L1D_CACHE_LINE_SIZE ) 
+      std::atomic< std::uint64_t >  checking_size = { 0 };
 };
 #endif /* END RAFTDATAMANAGER_TCC */
@@ -44,9 +44,16 @@ namespace raft
 template < typename T > 
     using set_t = std::set< T >;
 
-using ptr_set_t = set_t< std::uintptr_t >;
-using recyclefunc_t = std::function< void( void * ) >;
-using ptr_map_t = std::map< std::uintptr_t, recyclefunc_t >;
+/**
+ * the reclaim lists the scheduler hands to each kernel's FIFOs
+ * (see Schedule::fifo_gc), entries are only ever appended then
+ * the whole list is cleared after the kernel runs, so a flat
+ * vector that keeps its capacity is all that's needed.
+ */
+using ptr_set_t = std::vector< std::uintptr_t >;
+/** plain function pointer, one of these is stored per recycled item **/
+using recyclefunc_t = void (*)( void * );
+using ptr_map_t = std::vector< std::pair< std::uintptr_t, recyclefunc_t > >;
 using ptr_t = std::uintptr_t;
 
 using core_id_t = std::int64_t;
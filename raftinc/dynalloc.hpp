@@ -19,11 +19,67 @@
  */
 #ifndef RAFTDYNALLOC_HPP
 #define RAFTDYNALLOC_HPP  1
+#include <atomic>
+#include <cstddef>
 #include "allocate.hpp"
 
+/**
+ * DYNALLOC_MONITOR_INTERVAL_US - time between monitor passes
+ * over the FIFOs in microseconds.
+ */
+#ifndef DYNALLOC_MONITOR_INTERVAL_US
+#define DYNALLOC_MONITOR_INTERVAL_US 3000
+#endif
+
+/**
+ * DYNALLOC_SHRINK_WATERMARK - default for shrink_policy::watermark,
+ * a FIFO whose occupancy (size / capacity) stays below this 
+ * fraction for the whole shrink window is halved.
+ */
+#ifndef DYNALLOC_SHRINK_WATERMARK
+#define DYNALLOC_SHRINK_WATERMARK 0.25
+#endif
+
+/**
+ * DYNALLOC_SHRINK_WINDOW - default for shrink_policy::window, 
+ * number of consecutive monitor passes a FIFO has to stay below
+ * the watermark before it's shrunk.
+ */
+#ifndef DYNALLOC_SHRINK_WINDOW
+#define DYNALLOC_SHRINK_WINDOW 100
+#endif
+
+/**
+ * DYNALLOC_RESIZE_HOLDOFF - default for shrink_policy::holdoff,
+ * number of monitor passes after any resize of a FIFO before it
+ * can be shrunk again, keeps an edge with bursty traffic from 
+ * oscillating between two sizes.
+ */
+#ifndef DYNALLOC_RESIZE_HOLDOFF
+#define DYNALLOC_RESIZE_HOLDOFF 300
+#endif
+
+/**
+ * define DYNALLOC_REPORT_FOOTPRINT to have the current and peak
+ * bytes held by the FIFOs printed to std::cerr on exit.
+ */
+
 namespace raft
 {
     class map;
+
+/**
+ * shrink_policy - when dynalloc halves an idle edge, set for
+ * a whole map with map::set_shrink, the defaults come from 
+ * the macros above.
+ */
+struct shrink_policy
+{
+    double      watermark = DYNALLOC_SHRINK_WATERMARK;
+    std::size_t window    = DYNALLOC_SHRINK_WINDOW;
+    std::size_t holdoff   = DYNALLOC_RESIZE_HOLDOFF;
+};
+
 }
 
 class dynalloc : public Allocate
@@ -41,6 +97,20 @@ public:
      */
     virtual void run();
 
+    /**
+     * footprint - bytes held by the FIFO buffers of every
+     * edge as of the last monitor pass.
+     * @return std::size_t
+     */
+    virtual std::size_t footprint() const noexcept;
+
+    /**
+     * peak_footprint - largest value footprint() has
+     * returned over the life of the application.
+     * @return std::size_t
+     */
+    virtual std::size_t peak_footprint() const noexcept;
+
 private:
     /**
      * hash - simple hash function to quickly
@@ -57,6 +127,25 @@ private:
      */
     static std::size_t hash( PortInfo &a, 
                              PortInfo &b );
+
+    /**
+     * edge_stats - per edge monitor state, grow_count is the number
+     * of passes the producer was mostly blocked, low_count the
+     * number of consecutive passes below the shrink watermark and
+     * holdoff the passes left before a shrink is allowed.
+     */
+    struct edge_stats
+    {
+        int         grow_count  = 0;
+        std::size_t low_count   = 0;
+        std::size_t holdoff     = 0;
+    };
+
+    /** copied from the map at construction, see map::set_shrink **/
+    const raft::shrink_policy shrink;
+
+    std::atomic< std::size_t > curr_footprint = { 0 };
+    std::atomic< std::size_t > max_footprint  = { 0 };
 };
 
 #endif /* END RAFTDYNALLOC_HPP */
@@ -0,0 +1,192 @@
+/**
+ * fanin.hpp - consumer side of a Type::FanIn edge. Several
+ * output ports can be linked to the same input port, each
+ * producer gets its own single producer ring (a Type::Heap
+ * RingBuffer) and the consumer's port gets one of these, which
+ * hands out items from whichever of the rings has them. There's
+ * no order across producers, items from any one producer come
+ * out in the order they were sent. Replaces a raft::join kernel
+ * (and its thread and copy) in front of the consumer. Ranges
+ * that hand out references (peek_range, peek_span) come from
+ * a single producer's ring, see select().
+ * @author: agent
+ * @version: Fri Oct 16 22:57:42 2026
+ *
+ * Copyright 2026 agent
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at:
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef RAFTFANIN_HPP
+#define RAFTFANIN_HPP  1
+#include <cstddef>
+#include <vector>
+#include "fifo.hpp"
+#include "waitstrategy.hpp"
+
+class FanIn : public FIFO
+{
+public:
+   FanIn() = default;
+
+   /** doesn't own the producer rings, the allocator does **/
+   virtual ~FanIn() = default;
+
+   /**
+    * add_source - add the ring of one more producer, called
+    * by the allocator before the kernels start.
+    * @param   fifo - FIFO* const, ring of the producer
+    */
+   void add_source( FIFO * const fifo );
+
+   /**
+    * sources - number of producer rings.
+    * @return  std::size_t
+    */
+   std::size_t sources() const noexcept;
+
+   /** sum over all of the producer rings **/
+   virtual std::size_t size();
+   virtual std::size_t space_avail();
+
+   /**
+    * capacity - sum over all of the producer rings.
+    * @return  std::size_t
+    */
+   virtual std::size_t capacity();
+
+   virtual void deallocate();
+   virtual void send( const raft::signal = raft::none );
+   virtual void send_range( const raft::signal = raft::none );
+   virtual void unpeek();
+   virtual void resize( const std::size_t n_items,
+                        const std::size_t align,
+                        volatile bool &exit_alloc );
+
+   /**
+    * the producer rings are monitored (and resized) through the
+    * ports of the producers, so there's nothing to report here.
+    */
+   virtual float get_frac_write_blocked();
+   virtual std::size_t get_suggested_count();
+   virtual std::size_t footprint();
+
+   /**
+    * invalidate - only called on the consumer side for a
+    * term signal, the consumer is going away so close all of
+    * the producer rings.
+    */
+   virtual void invalidate();
+
+   /**
+    * is_invalid - true once every producer is done.
+    * @return  bool
+    */
+   virtual bool is_invalid();
+
+   virtual bool reclaims_items() const noexcept;
+
+   /**
+    * set_wait_strategy - how the consumer waits for one of
+    * the rings to fill. There's no single ring for the
+    * producers to signal so raft::wait::park is treated as
+    * raft::wait::spin_yield here, the producers still park
+    * when their own ring is full.
+    * @param   s - const raft::wait::strategy
+    */
+   virtual void set_wait_strategy( const raft::wait::strategy s );
+
+   /**
+    * make_new_fifo - for symmetry with the RingBuffer builders,
+    * none of the params are used.
+    */
+   static FIFO* make_new_fifo( const std::size_t n_items,
+                               const std::size_t align,
+                               void * const data );
+
+protected:
+   virtual void setPtrMap( ptr_map_t * const in );
+   virtual void setPtrSet( ptr_set_t * const out );
+   virtual void setInPeekSet( ptr_set_t * const peekset );
+   virtual void setOutPeekSet( ptr_set_t * const peekset );
+
+   virtual raft::signal signal_peek();
+   /** true if any of the producer rings has one **/
+   virtual bool has_signal();
+   virtual void signal_pop();
+   virtual void inline_signal_send( const raft::signal sig );
+
+   virtual void local_allocate( void **ptr );
+   virtual void local_allocate_n( void *ptr, const std::size_t n );
+   virtual void local_allocate_span( void *range,
+                                     const std::size_t n );
+   virtual void local_push( void *ptr, const raft::signal &signal );
+   virtual void local_insert( void *ptr_begin,
+                              void *ptr_end,
+                              const raft::signal &signal,
+                              const std::size_t iterator_type );
+
+   virtual void local_pop( void *ptr, raft::signal *signal );
+   virtual void local_pop_range( void *ptr_data,
+                                 const std::size_t n_items );
+   virtual void local_pop_n( void *items,
+                             const std::size_t n,
+                             const std::size_t item_size,
+                             raft::signal *signals );
+   virtual void local_peek( void **ptr,
+                            raft::signal *signal );
+   virtual void local_peek_range( void **ptr,
+                                  void **sig,
+                                  const std::size_t n_items,
+                                  std::size_t &curr_pointer_loc ,
+                                  std::size_t &queue_size );
+   virtual void local_peek_span( void *range,
+                                 const std::size_t n );
+   virtual void local_recycle( std::size_t range );
+
+   /** forwarded to every producer ring **/
+   virtual void flush_reads();
+
+private:
+   /**
+    * producer_call - throws PortTypeMismatchException for a
+    * producer side call made on the consumer's end.
+    * @param   name - const char*, name of the call
+    */
+   void producer_call( const char * const name );
+
+   /**
+    * select - blocks till one of the rings holds at least n
+    * items and returns it, round robin so that a busy producer
+    * can't starve the others. Once every producer is
+    * done the ring with the most items left is returned
+    * even if it has fewer than n, its own pop/peek then throws
+    * the usual exception. So peek_range, peek_span and the
+    * std::vector version of pop_range need all n items on one
+    * producer's ring, near the end of a stream they can throw
+    * NoMoreDataException while size() is still >= n. The
+    * array version of pop_range takes items from every ring.
+    * @param   n - const std::size_t
+    * @return  FIFO*
+    */
+   FIFO* select( const std::size_t n );
+
+   std::vector< FIFO* >  source;
+   /** ring of the last pop/peek, recycle goes here **/
+   FIFO                 *current  = nullptr;
+   /** where the round robin scan starts **/
+   std::size_t           next     = 0;
+   raft::wait::strategy  wait_strategy = raft::wait::spin_yield;
+   /** never notified, only there so backoff can be reused **/
+   raft::wait::spot      unused_spot;
+};
+#endif /* END RAFTFANIN_HPP */
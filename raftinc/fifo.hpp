@@ -20,6 +20,8 @@
 #ifndef RAFTFIFO_HPP
 #define RAFTFIFO_HPP  1
 #include <cstddef>
+#include <cstring>
+#include <string>
 #include <typeinfo>
 #include <iterator>
 #include <list>
@@ -35,6 +37,12 @@
 #include "blocked.hpp"
 #include "signalvars.hpp"
 #include "alloc_traits.tcc"
+#include "slabpool.tcc"
+#include "ringspan.hpp"
+#include "waitstrategy.hpp"
+#include "batch.hpp"
+#include "placement.hpp"
+#include "record.hpp"
 
 
 #include "defs.hpp"
@@ -66,11 +74,25 @@ public:
    virtual ~FIFO() = default;
 
    /**
-    * size - returns the current size of this FIFO
+    * size - returns the current size of this FIFO, safe to call
+    * from any thread. On a batched edge (see raft::batch) it
+    * only counts what both ends have published, so it can be
+    * off by up to the batch size, see consumer_size().
     * @return  std::size_t
     */
    virtual std::size_t size() = 0;
 
+   /**
+    * consumer_size - the consumer's view of size(), leaves out
+    * what the consumer has read but not published yet. Only
+    * call from the thread running the consuming kernel.
+    * @return  std::size_t
+    */
+   virtual std::size_t consumer_size()
+   {
+      return( size() );
+   }
+
    /**
     * space_avail - convenience function to get the current
     * space available in the FIFO, could otherwise be calculated
@@ -131,7 +153,7 @@ public:
       T **ptr( nullptr );
       /** call blocks till an element is available **/
       local_allocate( (void**) &ptr );
-      *ptr = new T( std::forward< Args >( params )... );
+      *ptr = raft::slab_pool< T >::make( std::forward< Args >( params )... );
       return( **ptr );
    }
 
@@ -196,7 +218,7 @@ public:
       T **ptr( nullptr );
       /** call blocks till an element is available **/
       local_allocate( (void**) &ptr );
-      *ptr = new T( std::forward< Args >( params )... );
+      *ptr = raft::slab_pool< T >::make( std::forward< Args >( params )... );
       return( autorelease< T, allocatetype >( 
          reinterpret_cast< T* >( *ptr ), (*this) ) );
    }
@@ -214,7 +236,8 @@ public:
     * of the queue is less than n or some other unspecified
     * error occurs then the number allocated is returned in 
     * n_ret. To release items to the queue, use push_range
-    * as opposed to the standard push.
+    * as opposed to the standard push. Externally allocated
+    * (large) objects are default constructed as with allocate().
     * @param   n - const std::size_t, # items to allocate
     * @return  std::vector< std::reference_wrapper< T > >
     */
@@ -231,7 +254,28 @@ public:
             std::reference_wrapper< T > > >( output ) );
    }
 
-   //FIXME, implement allocate_range for object types
+   /**
+    * allocate_span - zero-copy version of allocate_range, returns
+    * the n writeable slots at the tail of the queue as at most two
+    * contiguous spans (the second is only non-empty when the range
+    * wraps past the end of the store) so that they can be filled 
+    * with memcpy or a vectorized loop. Only available for types 
+    * without a constructor since the slots are raw memory. Release
+    * the items to the queue with send_range exactly as with 
+    * allocate_range.
+    * @param   n - const std::size_t, # items to allocate
+    * @return  raft::span_pair< T >
+    */
+   template < class T,
+              typename std::enable_if<
+                  inline_nonclass_alloc< T >::value >::type* = nullptr >
+   auto allocate_span( const std::size_t n ) -> raft::span_pair< T >
+   {
+      raft::span_pair< T > range;
+      local_allocate_span( (void*) &range, n );
+      return( range );
+   }
+
    /**
     * send - releases the last item allocated by allocate() to the 
     * queue.  Function will simply return if allocate wasn't
@@ -274,7 +318,7 @@ public:
     * signal which is guaranteed to be delivered at the 
     * same time as the object (if of course the receiving 
     * object is responding to signals).
-    * @param   item -  T&&
+    * @param   item -  const T&&
     * @param   signal -  raft::signal, default raft::none
     */
    template < class T >
@@ -286,6 +330,56 @@ public:
       return;
    }
 
+   /**
+    * push - rvalue version, the object is move constructed
+    * into the FIFO so that anything it owns on the heap 
+    * (strings, vectors, etc.) is handed over instead of 
+    * being deep copied. The item is left in a moved-from
+    * state. Only taken for non-const rvalues, lvalues 
+    * and const rvalues go to the copying versions above.
+    * @param   item -  T&&
+    * @param   signal -  raft::signal, default raft::none
+    */
+   template < class T,
+              typename std::enable_if< 
+                  ! std::is_reference< T >::value &&
+                  ! std::is_const< T >::value >::type* = nullptr >
+   void push( T &&item, const raft::signal signal = raft::none )
+   {
+      void * const ptr( (void*) &item );
+      /** call blocks till element is written and released to queue **/
+      local_push_move( ptr, signal );
+      return;
+   }
+
+   /**
+    * emplace - constructs the item directly in the FIFO 
+    * from params and releases it to the queue, no temporary
+    * is built and nothing is copied or moved. Same as 
+    * allocate< T >( params... ) followed by send(), use that
+    * pair if a signal has to go along with the item.
+    * @param   params - arguments for a constructor of T
+    */
+   template < class T,
+              class ... Args,
+              typename std::enable_if< 
+                  inline_nonclass_alloc< T >::value >::type* = nullptr >
+   void emplace( Args&&... params )
+   {
+      allocate< T >() = T( std::forward< Args >( params )... );
+      send();
+   }
+
+   template < class T,
+              class ... Args,
+              typename std::enable_if< 
+                  ! inline_nonclass_alloc< T >::value >::type* = nullptr >
+   void emplace( Args&&... params )
+   {
+      allocate< T >( std::forward< Args >( params )... );
+      send();
+   }
+
 
    /**
     * insert - inserts the range from begin to end in the FIFO,
@@ -298,7 +392,9 @@ public:
     * @param   end   - iterator_type, iterator to end of range
     * @param   signal - raft::signal, default raft::none
     */
-   template< class iterator_type >
+   template< class iterator_type,
+             typename std::enable_if< 
+               ! contiguous_iterator< iterator_type >::value >::type* = nullptr >
    void insert(   iterator_type begin,
                   iterator_type end,
                   const raft::signal signal = raft::none )
@@ -311,6 +407,46 @@ public:
                     typeid( iterator_type ).hash_code() );
       return;
    }
+
+   /** 
+    * insert - contiguous ranges of trivially copyable items
+    * (raw pointers, std::vector iterators) go through the 
+    * pointer and length version below.
+    */
+   template< class iterator_type,
+             typename std::enable_if< 
+               contiguous_iterator< iterator_type >::value >::type* = nullptr >
+   void insert(   iterator_type begin,
+                  iterator_type end,
+                  const raft::signal signal = raft::none )
+   {
+      const auto n( std::distance( begin, end ) );
+      if( n > 0 )
+      {
+         insert( &(*begin), static_cast< std::size_t >( n ), signal );
+      }
+      return;
+   }
+
+   /**
+    * insert - inserts the n items starting at items, blocks
+    * until all are on the queue. The signal goes with the
+    * last item. Queues that support it copy trivially copyable 
+    * items in bulk (at most two memcpy calls and one update of
+    * the write index per queue-sized chunk), anything else 
+    * is pushed one item at a time.
+    * @param   items - const T* const, first item
+    * @param   n - const std::size_t, number of items
+    * @param   signal - raft::signal, default raft::none
+    */
+   template< class T >
+   void insert(   const T * const items,
+                  const std::size_t n,
+                  const raft::signal signal = raft::none )
+   {
+      local_insert_n( (const void*) items, n, sizeof( T ), signal );
+      return;
+   }
    
    /**
     * pop - pops the head of the queue.  If the receiving
@@ -353,6 +489,26 @@ public:
       return;
    }
 
+   /**
+    * pop_range - pops n_items into the array at items, 
+    * blocks till all of them have been read. The bulk 
+    * counterpart of insert( items, n ), trivially copyable 
+    * items are copied out with memcpy where the queue 
+    * supports it.
+    * @param   items - T* const, room for n_items
+    * @param   n_items - const std::size_t
+    * @param   signals - raft::signal* const, room for n_items
+    *          signals or nullptr if they aren't wanted
+    */
+   template< class T >
+   void pop_range( T * const items,
+                   const std::size_t n_items,
+                   raft::signal * const signals = nullptr )
+   {
+      local_pop_n( (void*) items, n_items, sizeof( T ), signals );
+      return;
+   }
+
    /**
     * peek - returns a reference to the head of the
     * queue.  unpeek() must be called after this to 
@@ -395,35 +551,141 @@ public:
       void *ptr = nullptr;
       void *sig = nullptr;
       std::size_t curr_pointer_loc( 0 );
-      local_peek_range( &ptr, &sig, n, curr_pointer_loc );
+      std::size_t queue_size( 0 );
+      local_peek_range( &ptr, &sig, n, curr_pointer_loc, queue_size );
       return( autorelease< T, peekrange >( 
          (*this),
          reinterpret_cast< T * const >( ptr ),
          reinterpret_cast< Buffer::Signal* >( sig ),
          curr_pointer_loc,
-         n ) );
+         n,
+         queue_size ) );
    }
    
+   /**
+    * peek_range - same for externally allocated objects, the
+    * references are to the objects the queue points to, so 
+    * pushing one on downstream hands it over without a copy,
+    * exactly as with peek.
+    * @ n - const std::size_t, number of items to peek
+    * @return - autorelease< T, peekrange >
+    */
    template< class T,
              typename std::enable_if< ext_alloc< T >::value >::type* = nullptr >
    auto  peek_range( const std::size_t n ) -> 
       autorelease< T, peekrange >
    {
-      /** FIXME: still not implemented yet for externally allocated objects **/
-      assert( false );
       void *ptr = nullptr;
       void *sig = nullptr;
       std::size_t curr_pointer_loc( 0 );
-      local_peek_range( &ptr, &sig, n, curr_pointer_loc );
+      std::size_t queue_size( 0 );
+      local_peek_range( &ptr, &sig, n, curr_pointer_loc, queue_size );
       return( autorelease< T, peekrange >( 
          (*this),
-         reinterpret_cast< T * const >( ptr ),
+         reinterpret_cast< T ** const >( ptr ),
          reinterpret_cast< Buffer::Signal* >( sig ),
          curr_pointer_loc,
-         n ) );
+         n,
+         queue_size ) );
    }
 
 
+   /**
+    * peek_span - zero-copy version of peek_range, returns the 
+    * n items at the head of the queue as at most two contiguous
+    * spans pointing straight into the queue's store (the second
+    * is only non-empty when the range wraps past the end of the
+    * store). As with peek, unpeek() must be called once the 
+    * spans are no longer in use and recycle( n ) to release the
+    * items.
+    * @param   n - const std::size_t, number of items to peek
+    * @return  raft::span_pair< T >
+    */
+   template< class T,
+             typename std::enable_if< inline_alloc< T >::value >::type* = nullptr >
+   auto peek_span( const std::size_t n ) -> raft::span_pair< T >
+   {
+      raft::span_pair< T > range;
+      local_peek_span( (void*) &range, n );
+      return( range );
+   }
+
+   /**
+    * allocate_bytes - record rings only (ports of type 
+    * raft::bytes, see record.hpp), returns n contiguous 
+    * writeable bytes at the tail of the ring. Release them as
+    * a record with send() or, to send only the first few bytes
+    * written, with send_bytes().
+    * @param   n - const std::size_t, most bytes the record can have
+    * @return  raft::byte_span
+    * @throws  PortTypeMismatchException - if not a record ring
+    */
+   raft::byte_span allocate_bytes( const std::size_t n )
+   {
+      return( local_allocate_bytes( n ) );
+   }
+
+   /**
+    * send_bytes - releases the first used bytes of the last
+    * allocate_bytes call as one record.
+    * @param   used - const std::size_t, <= the bytes allocated
+    * @param   signal - const raft::signal, default: NONE
+    */
+   void send_bytes( const std::size_t used, 
+                    const raft::signal signal = raft::none )
+   {
+      local_send_bytes( used, signal );
+   }
+
+   /**
+    * push_bytes - copies n bytes from data into the ring as
+    * one record.
+    * @param   data - const void*
+    * @param   n - const std::size_t
+    * @param   signal - const raft::signal, default: NONE
+    */
+   void push_bytes( const void * const data, 
+                    const std::size_t n,
+                    const raft::signal signal = raft::none )
+   {
+      auto span( local_allocate_bytes( n ) );
+      std::memcpy( span.data(), data, n );
+      local_send_bytes( n, signal );
+   }
+
+   void push_bytes( const std::string &s, 
+                    const raft::signal signal = raft::none )
+   {
+      push_bytes( s.data(), s.size(), signal );
+   }
+
+   /**
+    * peek_record - record rings only, returns a view of the 
+    * record at the head of the ring. As with peek, call unpeek()
+    * once done with the view and recycle() to release the record.
+    * @param   signal - raft::signal*, signal sent with the record
+    * @return  raft::record
+    * @throws  PortTypeMismatchException - if not a record ring
+    */
+   raft::record peek_record( raft::signal *signal = nullptr )
+   {
+      return( local_peek_record( signal ) );
+   }
+
+   /**
+    * pop_record - copies the record at the head of the ring
+    * into out and releases it.
+    * @param   out - std::string&
+    * @param   signal - raft::signal*, signal sent with the record
+    */
+   void pop_record( std::string &out, raft::signal *signal = nullptr )
+   {
+      const auto rec( local_peek_record( signal ) );
+      out.assign( rec.data(), rec.size() );
+      unpeek();
+      local_recycle( 1 );
+   }
+
    /**
     * unpeek - call after peek to let the runtime know that 
     * all references to the returned value are no longer in
@@ -516,6 +778,22 @@ public:
      */
      virtual std::size_t get_suggested_count() = 0;
 
+    /**
+     * footprint - returns the number of bytes currently
+     * allocated for this queue's items and signals, used
+     * by the dynamic allocator to report total memory use.
+     * @return  std::size_t bytes
+     */
+     virtual std::size_t footprint() = 0;
+
+    /**
+     * high_water_mark - the most items this queue has held
+     * at once, only tracked by the unbounded (Type::Infinite)
+     * queue, everything else returns zero.
+     * @return  std::size_t items
+     */
+     virtual std::size_t high_water_mark();
+
    /**
     * invalidate - used by producer thread to label this
     * queue as invalid.  Could be for many differing reasons,
@@ -534,7 +812,72 @@ public:
     * @return bool - true if invalid
     */
    virtual bool is_invalid() = 0;
+
+   /**
+    * reclaims_items - true if items on this FIFO are allocated
+    * outside of the queue and freed through the lists set by
+    * setPtrMap/setPtrSet, the scheduler skips Schedule::fifo_gc
+    * for kernels with none of these.
+    * @return bool
+    */
+   virtual bool reclaims_items() const noexcept;
+
+   /**
+    * set_wait_strategy - how the endpoints of this FIFO wait
+    * when it's full or empty, set by the allocator from the
+    * PortInfo of the edge. The default version ignores it.
+    * @param   s - const raft::wait::strategy
+    */
+   virtual void set_wait_strategy( const raft::wait::strategy s );
+
+   /**
+    * set_batch - batched index publication for this FIFO (see
+    * batch.hpp), set by the allocator from the PortInfo of the
+    * edge. The default version ignores it.
+    * @param   b - const raft::batch&
+    */
+   virtual void set_batch( const raft::batch &b );
+
+   /**
+    * set_placement - pages and NUMA node for the store of this
+    * FIFO (see placement.hpp), set by the allocator from the
+    * PortInfo of the edge. The default version ignores it.
+    * @param   place - const raft::placement&
+    */
+   virtual void set_placement( const raft::placement &place );
+
+   /**
+    * set_fused - set by the scheduler when both ends of this
+    * FIFO run on one thread (a fused chain, see map::fuseChains).
+    * A wait on such an edge could never end, so it throws
+    * FusedChainBlockedException instead. The default version
+    * ignores it.
+    * @param   fused - const bool
+    */
+   virtual void set_fused( const bool fused );
+
+   /**
+    * flush - producer side, makes everything pushed so far
+    * visible to the consumer. Only does anything on a batched
+    * edge, where it's also done on its own at the latest when
+    * the kernel goes idle.
+    */
+   virtual void flush();
 protected:
+   /**
+    * flush_reads - consumer side counterpart of flush, hands
+    * the slots popped so far back to the producer. Called by
+    * the scheduler when the consumer goes idle.
+    */
+   virtual void flush_reads();
+
+   /**
+    * flush_due - producer side, flush() if the oldest 
+    * unpublished item is older than the latency bound of
+    * the edge. Called by the scheduler between runs.
+    */
+   virtual void flush_due();
+
    /**
     * setPtrMap - 
     */
@@ -557,6 +900,16 @@ protected:
     * @return raft::signal
     */
    virtual raft::signal signal_peek() = 0;
+
+   /**
+    * has_signal - cheap check for the scheduler, false only if
+    * there's certainly no signal on any item in the queue, so
+    * it can skip signal_peek. The default version can't tell
+    * and always returns true.
+    * @return  bool
+    */
+   virtual bool has_signal();
+
    /**
     * signal_pop - special function fo rthe scheduler to 
     * pop the current signal and associated item.
@@ -593,6 +946,17 @@ protected:
     * @param   - n, const std::size_t
     */
    virtual void  local_allocate_n( void *ptr, const std::size_t n ) = 0;
+
+   /**
+    * local_allocate_span - blocks until n items can be written 
+    * then sets the raft::span_pair< T > pointed to by range to the
+    * n free slots at the tail of the queue.  exitBuffer is left 
+    * to send_range, same as local_allocate_n.
+    * @param   range - void*, dereferenced raft::span_pair< T >
+    * @param   n - const std::size_t
+    */
+   virtual void local_allocate_span( void *range,
+                                     const std::size_t n ) = 0;
    /**
     * local_push - pushes the object reference by the void
     * ptr and pushes it to the FIFO with the associated 
@@ -604,6 +968,16 @@ protected:
     */
    virtual void local_push( void *ptr, const raft::signal &signal ) = 0;
 
+   /**
+    * local_push_move - same as local_push but the object 
+    * pointed to by ptr may be moved from. The default copies 
+    * (calls local_push), queues that construct items in 
+    * place override it.
+    * @param   ptr - void*, never null
+    * @param   signal - raft::signal reference
+    */
+   virtual void local_push_move( void *ptr, const raft::signal &signal );
+
    /**
     * local_insert - inserts a range from ptr_begin to ptr_end
     * and inserts the signal at the last element inserted, the 
@@ -625,6 +999,33 @@ protected:
     */
    virtual void local_pop( void *ptr, raft::signal *signal ) = 0;
 
+   /**
+    * local_insert_n - inserts the n items, each item_size bytes,
+    * laid out one after the other starting at items. The
+    * default pushes them one at a time through local_push.
+    * @param   items - const void*
+    * @param   n - const std::size_t
+    * @param   item_size - const std::size_t, sizeof( T )
+    * @param   signal - raft::signal, goes with the last item
+    */
+   virtual void local_insert_n( const void *items,
+                                const std::size_t n,
+                                const std::size_t item_size,
+                                const raft::signal &signal );
+
+   /**
+    * local_pop_n - counterpart of local_insert_n, the default
+    * pops one at a time through local_pop.
+    * @param   items - void*, room for n items
+    * @param   n - const std::size_t
+    * @param   item_size - const std::size_t, sizeof( T )
+    * @param   signals - raft::signal*, nullptr if not wanted
+    */
+   virtual void local_pop_n( void *items,
+                             const std::size_t n,
+                             const std::size_t item_size,
+                             raft::signal *signals );
+
    /**
     * local_pop_range - pops a range, of n_items and stores
     * them to the array of T* items pointed to by ptr_data.
@@ -651,12 +1052,35 @@ protected:
     * @param   sig - void**, same as above but for signal queue
     * @param   n_items - const std::size_t, number of items requested
     * @param   curr_pointer_loc - number of items able to be returned
+    * @param   queue_size - set to the number of slots the store
+    *          wraps at, item i is at (curr_pointer_loc + i) % queue_size
     */
    virtual void local_peek_range( void **ptr, 
                                   void **sig,
                                   const std::size_t n_items,
-                                  std::size_t &curr_pointer_loc ) = 0;
+                                  std::size_t &curr_pointer_loc ,
+                                  std::size_t &queue_size ) = 0;
    
+   /**
+    * local_peek_span - same as local_peek_range except the 
+    * raft::span_pair< T > pointed to by range is set to the n
+    * items at the head of the queue.
+    * @param   range - void*, dereferenced raft::span_pair< T >
+    * @param   n - const std::size_t
+    */
+   virtual void local_peek_span( void *range,
+                                 const std::size_t n ) = 0;
+
+   /**
+    * local_allocate_bytes/local_send_bytes/local_peek_record -
+    * the record ring calls, the default versions throw a
+    * PortTypeMismatchException.
+    */
+   virtual raft::byte_span local_allocate_bytes( const std::size_t n );
+   virtual void local_send_bytes( const std::size_t used, 
+                                  const raft::signal signal );
+   virtual raft::record local_peek_record( raft::signal *signal );
+
    /**
     * local_recycle - called by template recycle function
     * after calling destructor (for non-POD types).
@@ -670,6 +1094,8 @@ protected:
     */
    friend class Schedule;
    friend class Allocate;
+   /** forwards the consumer calls to the producer rings **/
+   friend class FanIn;
 };
 
 
@@ -28,6 +28,8 @@
 #include "datamanager.tcc"
 #include "defs.hpp"
 #include "internaldefs.hpp"
+#include "waitstrategy.hpp"
+#include "portexception.hpp"
 
 template < class T, Type::RingBufferType type > 
    class FIFOAbstract : public FIFO
@@ -35,8 +37,126 @@ template < class T, Type::RingBufferType type >
 public:
    FIFOAbstract() : FIFO(){}
 
+   virtual bool reclaims_items() const noexcept
+   {
+      return( ext_alloc< T >::value );
+   }
+
+   /**
+    * set_wait_strategy - called by the allocator before the
+    * endpoints start, see waitstrategy.hpp.
+    * @param   s - const raft::wait::strategy
+    */
+   virtual void set_wait_strategy( const raft::wait::strategy s )
+   {
+      assert( s != raft::wait::inherit );
+      wait_strategy = s;
+   }
+
+   virtual void set_fused( const bool f )
+   {
+      fused = f;
+   }
+
 protected:
 
+    /**
+     * producer_backoff/consumer_backoff - state for one 
+     * blocking call, see raft::wait::backoff.
+     */
+    raft::wait::backoff producer_backoff() noexcept
+    {
+        return( raft::wait::backoff( wait_strategy, space_ready ) );
+    }
+    
+    raft::wait::backoff consumer_backoff() noexcept
+    {
+        return( raft::wait::backoff( wait_strategy, data_ready ) );
+    }
+
+    /**
+     * producer_wait - call each time the producer finds fewer
+     * than n free slots, call outside of enterBuffer/exitBuffer.
+     */
+    void producer_wait( raft::wait::backoff &wait, const std::size_t n )
+    {
+        auto ready( [&]() -> bool 
+        { 
+            return( (this)->space_avail() >= n ); 
+        } );
+        if( R_UNLIKELY( fused ) )
+        {
+            self_wait( ready, "producer" );
+        }
+        wait.idle( ready );
+    }
+    
+    /**
+     * consumer_wait - same for the consumer waiting on n items,
+     * wakes up for a closed port too so that it can exit.
+     */
+    void consumer_wait( raft::wait::backoff &wait, const std::size_t n )
+    {
+        auto ready( [&]() -> bool 
+        { 
+            return( (this)->size() >= n || (this)->is_invalid() ); 
+        } );
+        if( R_UNLIKELY( fused ) )
+        {
+            self_wait( ready, "consumer" );
+        }
+        wait.idle( ready );
+    }
+
+    /**
+     * self_wait - on a fused edge, throws if the calling thread
+     * runs both ends and would have to wait, the other end
+     * can't run till this one returns.
+     * @param   ready - F&&, bool()
+     * @param   side - const char*, for the message
+     */
+    template < class F > void self_wait( F &&ready, const char * const side )
+    {
+        if( datamanager.bothEndsLocal() && ! ready() )
+        {
+            throw FusedChainBlockedException( std::string( "fused chain " ) + 
+               side + " would wait on a kernel on its own thread, a fused kernel "
+               "can only push (pop) as many items per run as its link holds, "
+               "turn fusion off or give the link a bigger buffer" );
+        }
+    }
+
+    /**
+     * wake_consumer/wake_producer - call after moving the write
+     * (read) position, nothing but a compare unless the queue 
+     * parks.
+     */
+    inline void wake_consumer() noexcept
+    {
+        if( R_UNLIKELY( wait_strategy == raft::wait::park ) )
+        {
+            data_ready.notify();
+        }
+    }
+
+    inline void wake_producer() noexcept
+    {
+        if( R_UNLIKELY( wait_strategy == raft::wait::park ) )
+        {
+            space_ready.notify();
+        }
+    }
+
+    /** wake_all - after a resize or close **/
+    void wake_all() noexcept
+    {
+        if( wait_strategy == raft::wait::park )
+        {
+            data_ready.wake();
+            space_ready.wake();
+        }
+    }
+
     inline void init() noexcept
     {
         auto * const buffer( datamanager.get() );
@@ -62,6 +182,14 @@ protected:
          * for cache performance.
          */
         Blocked                     *write_stats = nullptr;
+        /**
+         * Type::SPSC only, producer's private copy of the 
+         * consumer's read position and the datamanager
+         * generation it was read from, refreshed only when 
+         * this copy says the queue is full.
+         */
+        std::uint64_t                remote_read   = 0;
+        std::uint64_t                remote_gen    = 0;
     } producer_data;
    
    
@@ -74,6 +202,14 @@ protected:
         ptr_map_t                   *in         = nullptr;
         ptr_set_t                   *in_peek    = nullptr;
         Blocked                     *read_stats = nullptr;
+        /**
+         * Type::SPSC only, consumer's private copy of the 
+         * producer's write position and the datamanager 
+         * generation it was read from, refreshed only when
+         * this copy says the queue is empty.
+         */
+        std::uint64_t                remote_write  = 0;
+        std::uint64_t                remote_gen    = 0;
     } consumer_data;
     
     /** 
@@ -82,5 +218,13 @@ protected:
      * lock free buffer resizing and re-alignment.
      */
     DataManager< T, type >       datamanager;
+
+    raft::wait::strategy         wait_strategy = raft::wait::spin_yield;
+    /** both ends run on one thread, see set_fused **/
+    bool                         fused         = false;
+    /** consumer parks here waiting for items **/
+    raft::wait::spot             data_ready;
+    /** producer parks here waiting for space **/
+    raft::wait::spot             space_ready;
 };
 #endif /* END RAFTFIFOABSTRACT_TCC */
@@ -40,6 +40,7 @@ class basic_parallel;
 class kpair;
 class interface_partition;
 class pool_schedule;
+class Allocate;
 
 
 #ifndef CLONE
@@ -156,6 +157,7 @@ protected:
     friend class ::kpair;
     friend class ::interface_partition;
     friend class ::pool_schedule;
+    friend class ::Allocate;
 
     /**
      * NOTE: doesn't need to be atomic since only one thread
@@ -166,6 +168,26 @@ protected:
      
     bool internal_alloc = false;
 
+    /**
+     * set by the allocator if any port of this kernel is on
+     * a batched edge, the scheduler then flushes the ports
+     * between runs (see batch.hpp).
+     */
+    bool batched_ports = false;
+
+    /**
+     * set by map::fuseChains, the kernels before and after this
+     * one on a fused chain, run on the head's thread.
+     */
+    raft::kernel *fused_prev = nullptr;
+    raft::kernel *fused_next = nullptr;
+
+    /**
+     * set by raft::kernel_batch, the scheduler calls its
+     * run_batch() in place of run() (see kernel_batch.hpp).
+     */
+    bool batch_run = false;
+
     
     void  retire() noexcept
     {
@@ -0,0 +1,119 @@
+/**
+ * kernel_batch.hpp - base for kernels that take their input a
+ * batch at a time. Extend raft::kernel_batch and implement
+ * run_batch() instead of run(). The scheduler counts what's
+ * queued on each input port once, calls run_batch() with the
+ * counts, and the kernel can then pop (pop_range, peek_range,
+ * etc.) that many items without blocking. The per call checks
+ * the scheduler makes are paid once per batch rather than once
+ * per item. Like raft::kernel_all the kernel is only run when
+ * any port has data, set sched_behav to raft::all_port in the
+ * constructor to only run it when all of them do.
+ * @author: agent
+ * @version: Sat Oct 17 00:48:10 2026
+ *
+ * Copyright 2026 agent
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at:
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef RAFTKERNEL_BATCH_HPP
+#define RAFTKERNEL_BATCH_HPP  1
+#include <cstddef>
+#include <string>
+#include <utility>
+#include <vector>
+#include "kernel.hpp"
+
+class Schedule;
+
+namespace raft
+{
+
+/**
+ * ready - items queued on each input port of a kernel_batch
+ * when run_batch() is called. The kernel is the only reader of
+ * its ports, so at least this many can be read without waiting.
+ */
+class ready
+{
+public:
+   /**
+    * operator[] - count for the named port
+    * @throws PortNotFoundException
+    */
+   std::size_t operator[]( const std::string &port_name ) const;
+
+   /** min - count on the port with the fewest, 0 with no ports **/
+   std::size_t min() const noexcept
+   {
+      return( least );
+   }
+
+   /** total - count over all ports **/
+   std::size_t total() const noexcept
+   {
+      return( sum );
+   }
+
+   /** ports - number of input ports **/
+   std::size_t ports() const noexcept
+   {
+      return( counts.size() );
+   }
+
+private:
+   /** port name (the port map's key) and its count **/
+   std::vector< std::pair< const std::string*, std::size_t > > counts;
+   std::size_t least = 0;
+   std::size_t sum   = 0;
+
+   friend class kernel_batch;
+};
+
+class kernel_batch : public raft::kernel
+{
+public:
+   kernel_batch();
+
+   virtual ~kernel_batch() = default;
+
+   /**
+    * run_batch - called by the scheduler in place of run(),
+    * see raft::ready for the counts. Return values are the
+    * same as for run(). A kernel without input ports is called
+    * with no counts, over and over till it returns stop.
+    * @param   avail - const raft::ready&
+    * @return  raft::kstatus
+    */
+   virtual raft::kstatus run_batch( const raft::ready &avail ) = 0;
+
+   /**
+    * run - for schedulers that only call run(), counts what's
+    * queued and calls run_batch() with it.
+    */
+   virtual raft::kstatus run();
+
+private:
+   /**
+    * count - fill avail in one pass over the input ports,
+    * returns true if the kernel should run per sched_behav.
+    */
+   bool count();
+
+   raft::ready avail;
+
+   friend class ::Schedule;
+};
+
+} /** end namespace raft **/
+#endif /* END RAFTKERNEL_BATCH_HPP */
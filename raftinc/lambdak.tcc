@@ -19,9 +19,14 @@
  */
 #ifndef RAFTLAMBDAK_TCC
 #define RAFTLAMBDAK_TCC  1
+#include <cassert>
 #include <functional>
+#include <string>
+#include <tuple>
+#include <type_traits>
 #include <utility>
 #include <typeinfo>
+#include <vector>
 #include <raft>
 
 namespace raft
@@ -32,45 +37,160 @@ namespace raft
 template < class... PORTSL > struct AddPorts;
 template < class... PORTSK > struct AddSamePorts;
 
-template < class... PORTS >
-   class lambdak : public raft::kernel
+/** handles on a lambda kernel's ports, indexed as the ports are named **/
+template < class T > using port_handles = std::vector< raft::port_handle< T > >;
+
+/**
+ * inline_lambdak - kernel that runs a lambda (or any callable)
+ * stored by its own type, so the call in run() can be inlined
+ * rather than going through a std::function. Use make_lambdak
+ * below to get one without naming the lambda's type. The
+ * callable is either called with the ports:
+ *    raft::kstatus ( Port &input, Port &output )
+ * or, if all ports are one type T, with a handle per port:
+ *    raft::kstatus ( raft::port_handles< T > &input,
+ *                    raft::port_handles< T > &output )
+ * which skips the name lookup on each call. The kernel can be
+ * cloned (e.g., by basic_parallel) if the callable can be copied,
+ * each clone gets a copy of it, so anything captured by reference
+ * is shared between them.
+ */
+template < class F, class... PORTS >
+   class inline_lambdak : public raft::kernel
 {
+   static_assert( sizeof...( PORTS ) > 0,
+                  "lambda kernels need at least one port type" );
+   /** single port type, only used for handles **/
+   using port_t    = typename std::tuple_element< 0, std::tuple< PORTS... > >::type;
+   using handles_t = raft::port_handles< port_t >;
+
+   template < class G >
+      static auto takes( int ) -> decltype(
+         std::declval< G& >()( std::declval< handles_t& >(),
+                               std::declval< handles_t& >() ),
+         std::true_type() );
+   template < class G >
+      static auto takes( ... ) -> std::false_type;
+
+   template < class G >
+      static auto takes_ports( int ) -> decltype(
+         std::declval< G& >()( std::declval< Port& >(),
+                               std::declval< Port& >() ),
+         std::true_type() );
+   template < class G >
+      static auto takes_ports( ... ) -> std::false_type;
+
+   /** ports are preferred where both would work (generic lambdas) **/
+   using uses_ports   = decltype( takes_ports< F >( 0 ) );
+   using uses_handles = std::integral_constant< bool,
+      ! uses_ports::value && decltype( takes< F >( 0 ) )::value >;
+
+   static_assert( uses_ports::value || uses_handles::value,
+                  "lambda kernel func must take ( Port&, Port& ) or, with a single "
+                  "port type, ( raft::port_handles< T >&, raft::port_handles< T >& )" );
+   static_assert( ! uses_handles::value || sizeof...( PORTS ) == 1,
+                  "port handles are only given to lambda kernels with a single port type" );
+
 public:
-   typedef std::function< raft::kstatus ( Port &input,
-                                          Port &output ) > lambdafunc_t;
    /**
     * constructor -
     * @param   inputs - const std::size_t number of inputs to the kernel
     * @param   outputs - const std::size_t number of outputs to the kernel
-    * @param   func - static or lambda function to execute.
+    * @param   func - callable to execute, copied or moved in
     */
-   lambdak( const std::size_t inputs,
-            const std::size_t outputs,
-            lambdafunc_t  func ) :   raft::kernel(),
-                                     run_func( func )
+   inline_lambdak( const std::size_t inputs,
+                   const std::size_t outputs,
+                   F func ) : raft::kernel(),
+                              run_func( std::move( func ) ),
+                              inputs( inputs ),
+                              outputs( outputs )
    {
       add_ports< PORTS... >( inputs, outputs );
+      make_handles( uses_handles() );
    }
 
+   /**
+    * copy constructor - the copy gets its own ports, so only
+    * the port counts and the callable are taken from other.
+    */
+   inline_lambdak( const inline_lambdak &other ) :
+      inline_lambdak( other.inputs, other.outputs, other.run_func )
+   {
+   }
 
-    //FIXME, add copy constructor
+   inline_lambdak( inline_lambdak &&other ) :
+      inline_lambdak( other.inputs, other.outputs, std::move( other.run_func ) )
+   {
+   }
 
+   virtual ~inline_lambdak() = default;
 
    /**
     * run - implement the run function for this kernel,
     */
    virtual raft::kstatus run()
    {
-      return( run_func( input  /** input ports **/,
-                        output /** output ports **/) );
+      return( call( uses_handles() ) );
    }
 
-
+   /**
+    * clone - copy of this kernel if the callable can be
+    * copied, otherwise throws CloneNotImplementedException.
+    */
+   virtual raft::kernel* clone()
+   {
+      return( clone_if( std::is_copy_constructible< F >() ) );
+   }
 
 private:
    /** lambda func passed by user **/
-   lambdafunc_t  run_func;
+   F                 run_func;
+   const std::size_t inputs;
+   const std::size_t outputs;
+   handles_t         in_handles;
+   handles_t         out_handles;
+
+   raft::kstatus call( std::false_type )
+   {
+      return( run_func( input  /** input ports **/,
+                        output /** output ports **/ ) );
+   }
+
+   raft::kstatus call( std::true_type )
+   {
+      return( run_func( in_handles, out_handles ) );
+   }
+
+   void make_handles( std::false_type )
+   {
+   }
 
+   void make_handles( std::true_type )
+   {
+      for( std::size_t it( 0 ); it < inputs; it++ )
+      {
+         in_handles.emplace_back( input.handle< port_t >( std::to_string( it ) ) );
+      }
+      for( std::size_t it( 0 ); it < outputs; it++ )
+      {
+         out_handles.emplace_back( output.handle< port_t >( std::to_string( it ) ) );
+      }
+   }
+
+   raft::kernel* clone_if( std::true_type )
+   {
+      auto *ptr( new inline_lambdak( *this ) );
+      /** RL needs to dealloc this one **/
+      ptr->internal_alloc = true;
+      return( ptr );
+   }
+
+   raft::kernel* clone_if( std::false_type )
+   {
+      throw CloneNotImplementedException( "lambda kernel can't be cloned, its function can't be copied" );
+      /** won't be reached **/
+      return( nullptr );
+   }
 
    /** function **/
    template < class... PORTSM >
@@ -105,9 +225,56 @@ private:
                                      output /* ports */);
       }
    }
+}; /** end template inline_lambdak **/
+
+/**
+ * make_lambdak - inline_lambdak for func, port types are given
+ * as for lambdak, e.g.:
+ *    auto k( raft::make_lambdak< int >( 1, 1, [&]( Port &in, Port &out ){ ... } ) );
+ */
+template < class... PORTS, class F >
+   inline_lambdak< typename std::decay< F >::type, PORTS... >
+   make_lambdak( const std::size_t inputs,
+                 const std::size_t outputs,
+                 F &&func )
+{
+   return( inline_lambdak< typename std::decay< F >::type, PORTS... >(
+      inputs, outputs, std::forward< F >( func ) ) );
+}
+
+/**
+ * lambdak - lambda kernel that takes any function with the
+ * ( Port&, Port& ) signature, called through a std::function.
+ * Use make_lambdak where the call should be inlined.
+ */
+template < class... PORTS >
+   class lambdak : public inline_lambdak< std::function< raft::kstatus ( Port&, Port& ) >,
+                                          PORTS... >
+{
+public:
+   typedef std::function< raft::kstatus ( Port &input,
+                                          Port &output ) > lambdafunc_t;
+   /**
+    * constructor -
+    * @param   inputs - const std::size_t number of inputs to the kernel
+    * @param   outputs - const std::size_t number of outputs to the kernel
+    * @param   func - static or lambda function to execute.
+    */
+   lambdak( const std::size_t inputs,
+            const std::size_t outputs,
+            lambdafunc_t  func ) :
+      inline_lambdak< lambdafunc_t, PORTS... >( inputs, outputs, func )
+   {
+   }
 
+   lambdak( const lambdak &other ) :
+      inline_lambdak< lambdafunc_t, PORTS... >( other )
+   {
+   }
 
+   virtual ~lambdak() = default;
 
+   CLONE();
 }; /** end template lambdak **/
 
 /** class recursion **/
@@ -40,6 +40,15 @@
 /** includes all partitioners **/
 #include "partitioners.hpp"
 
+/**
+ * FUSED_BUFFER_ITEMS - slots in the FIFO between two kernels of
+ * a fused chain (see set_fusion), small since both ends run on
+ * the same thread, one after the other.
+ */
+#ifndef FUSED_BUFFER_ITEMS
+#define FUSED_BUFFER_ITEMS 64
+#endif
+
 namespace raft
 {
 
@@ -104,6 +113,11 @@ public:
       }
       /** check types, ensure all are linked **/
       checkEdges();
+      /** a scheduler that doesn't run the chains would hang on them **/
+      if( fusion && scheduler::runs_fused )
+      {
+         fuseChains();
+      }
       partition pt;
       pt.partition( all_kernels );
       
@@ -147,6 +161,8 @@ public:
       /** scheduler done, cleanup alloc **/
       exit_alloc = true;
       mem_thread.join();
+      fifo_footprint      = alloc.footprint();
+      fifo_peak_footprint = alloc.peak_footprint();
       /** no more need to duplicate kernels **/
       exit_para = true;
       parallel_mon.join();
@@ -161,6 +177,26 @@ public:
     */
    kernel_pair_t operator +=( kpair &p );
 
+   /**
+    * footprint - bytes held by the FIFOs when the allocator
+    * last looked, valid once exe() returns, 0 if the allocator
+    * doesn't keep track (dynalloc does).
+    * @return std::size_t
+    */
+   std::size_t footprint() const noexcept
+   {
+      return( fifo_footprint );
+   }
+
+   /**
+    * peak_footprint - most bytes the FIFOs held at once while 
+    * exe() ran, same caveats as footprint().
+    * @return std::size_t
+    */
+   std::size_t peak_footprint() const noexcept
+   {
+      return( fifo_peak_footprint );
+   }
    
 
 protected:
@@ -178,6 +214,19 @@ protected:
     */
    void checkEdges();
 
+   /**
+    * fuseChains - finds each chain of kernels joined by edges
+    * that go from a kernel's only output port to a kernel's 
+    * only input port, and links its kernels (fused_prev / 
+    * fused_next) so the scheduler runs the chain on a single
+    * thread. Broadcast, FanIn, batched and out of order edges,
+    * kernel_batch kernels and kernels marked for duplication 
+    * are left alone. Edges
+    * inside a chain without a fixed buffer size get one of
+    * FUSED_BUFFER_ITEMS.
+    */
+   void fuseChains();
+
    /**
     * enableDuplication - add split / join kernels where needed, 
     * for the moment we're going with a simple split/join topology,
@@ -196,6 +245,7 @@ protected:
    friend class ::basic_parallel;
    friend class ::Schedule;
    friend class ::Allocate;
+   friend class ::dynalloc;
 
 private:
     using split_stack_t = std::stack< std::size_t >;
@@ -243,6 +293,10 @@ private:
                           kernels_t &temp_groups,
                           kpair * const next );
 
+    /** copied from the allocator at the end of exe() **/
+    std::size_t fifo_footprint      = 0;
+    std::size_t fifo_peak_footprint = 0;
+
 }; /** end map decl **/
 
 } /** end namespace raft **/
@@ -45,6 +45,9 @@
 #include "stdalloc.hpp"
 #include "kpair.hpp"
 #include "kernel_pair_t.hpp"
+#include "waitstrategy.hpp"
+#include "batch.hpp"
+#include "placement.hpp"
 
 class MapBase
 {
@@ -63,8 +66,20 @@ public:
    /** 
     * link - this comment goes for the next 4 types of link functions,
     * which basically do the exact same thing.  The template function
-    * takes a single param order::spec which is exactly as the name
-    * implies, the order of the queue linking the two kernels.  The
+    * takes a param order::spec which is exactly as the name
+    * implies, the order of the queue linking the two kernels, and
+    * an optional Type::RingBufferType selecting the FIFO type used
+    * for the edge (e.g., Type::SPSC), default is Type::Heap, and an
+    * optional raft::wait::strategy for the edge, default is the one
+    * set for the whole map with set_wait (see waitstrategy.hpp).
+    * The optional raft::batch turns on batched index publication
+    * for the edge (see batch.hpp), heap backed types only, and
+    * the optional raft::placement puts the store of the edge on
+    * huge pages and/or the consumer's NUMA node (placement.hpp).
+    * Linking several sources to the same destination port is only
+    * allowed with Type::FanIn on every one of those links, and 
+    * linking one source port to several destinations only with
+    * Type::Broadcast. The
     * various functions are needed to specify different ordering types
     * each of these will be commented separately below.  This function
     * assumes that Kernel 'a' has only a single output and raft::kernel 'b' has
@@ -76,10 +91,14 @@ public:
     *          a single port to link.
     * @return  kernel_pair_t - references to src, dst kernels.
     */
-   template < raft::order::spec t = raft::order::in >
+   template < raft::order::spec t = raft::order::in,
+              Type::RingBufferType B = Type::Heap,
+              raft::wait::strategy W = raft::wait::inherit >
       kernel_pair_t link( raft::kernel *a, 
                           raft::kernel *b,
-                          const std::size_t buffer = 0 )
+                          const std::size_t buffer = 0,
+                          const raft::batch &batch = raft::batch(),
+                          const raft::placement &place = raft::placement() )
    {
       updateKernels( a, b );
       PortInfo *port_info_a( nullptr );
@@ -93,6 +112,10 @@ public:
                        a );
       }
       port_info_a->fixed_buffer_size = buffer;
+      port_info_a->buffer_type       = B;
+      port_info_a->wait              = W;
+      port_info_a->batch             = batch;
+      port_info_a->place             = place;
       PortInfo *port_info_b( nullptr );
       try{
          port_info_b = &(b->input.getPortInfo());
@@ -104,6 +127,10 @@ public:
                           b );
       }
       port_info_b->fixed_buffer_size = buffer;
+      port_info_b->buffer_type       = B;
+      port_info_b->wait              = W;
+      port_info_b->batch             = batch;
+      port_info_b->place             = place;
 
       join( *a, port_info_a->my_name, *port_info_a, 
             *b, port_info_b->my_name, *port_info_b );
@@ -125,15 +152,23 @@ public:
     *          a_port.
     * @return  kernel_pair_t - references to src, dst kernels.
     */
-   template < raft::order::spec t = raft::order::in > 
+   template < raft::order::spec t = raft::order::in,
+              Type::RingBufferType B = Type::Heap,
+              raft::wait::strategy W = raft::wait::inherit >
       kernel_pair_t link( raft::kernel *a, 
                           const std::string  a_port, 
                           raft::kernel *b,
-                          const std::size_t buffer = 0 )
+                          const std::size_t buffer = 0,
+                          const raft::batch &batch = raft::batch(),
+                          const raft::placement &place = raft::placement() )
    {
       updateKernels( a, b );
       PortInfo &port_info_a( a->output.getPortInfoFor( a_port ) );
       port_info_a.fixed_buffer_size = buffer;
+      port_info_a.buffer_type       = B;
+      port_info_a.wait              = W;
+      port_info_a.batch             = batch;
+      port_info_a.place             = place;
       PortInfo *port_info_b;
       try{
          port_info_b = &(b->input.getPortInfo());
@@ -145,6 +180,10 @@ public:
                           b );
       }
       port_info_b->fixed_buffer_size = buffer;
+      port_info_b->buffer_type       = B;
+      port_info_b->wait              = W;
+      port_info_b->batch             = batch;
+      port_info_b->place             = place;
       join( *a, a_port , port_info_a, 
             *b, port_info_b->my_name, *port_info_b );
       set_order< t >( port_info_a, *port_info_b ); 
@@ -166,11 +205,15 @@ public:
     *          has no input port named b_port
     * @return  kernel_pair_t - references to src, dst kernels.
     */
-   template < raft::order::spec t = raft::order::in >
+   template < raft::order::spec t = raft::order::in,
+              Type::RingBufferType B = Type::Heap,
+              raft::wait::strategy W = raft::wait::inherit >
       kernel_pair_t link( raft::kernel *a, 
                           raft::kernel *b, 
                           const std::string b_port,
-                          const std::size_t buffer = 0 )
+                          const std::size_t buffer = 0,
+                          const raft::batch &batch = raft::batch(),
+                          const raft::placement &place = raft::placement() )
    {
       updateKernels( a, b );
       PortInfo *port_info_a( nullptr );
@@ -184,9 +227,17 @@ public:
                           a );
       }
       port_info_a->fixed_buffer_size = buffer;
+      port_info_a->buffer_type       = B;
+      port_info_a->wait              = W;
+      port_info_a->batch             = batch;
+      port_info_a->place             = place;
       
       PortInfo &port_info_b( b->input.getPortInfoFor( b_port) );
       port_info_b.fixed_buffer_size = buffer;
+      port_info_b.buffer_type       = B;
+      port_info_b.wait              = W;
+      port_info_b.batch             = batch;
+      port_info_b.place             = place;
       
       join( *a, port_info_a->my_name, *port_info_a, 
             *b, b_port, port_info_b );
@@ -206,18 +257,30 @@ public:
     *          is missing port a_port or b_port.
     * @return  kernel_pair_t - references to src, dst kernels.
     */
-   template < raft::order::spec t = raft::order::in >
+   template < raft::order::spec t = raft::order::in,
+              Type::RingBufferType B = Type::Heap,
+              raft::wait::strategy W = raft::wait::inherit >
       kernel_pair_t link( raft::kernel *a, 
                           const std::string a_port, 
                           raft::kernel *b, 
                           const std::string b_port,
-                          const std::size_t buffer = 0 )
+                          const std::size_t buffer = 0,
+                          const raft::batch &batch = raft::batch(),
+                          const raft::placement &place = raft::placement() )
    {
       updateKernels( a, b );
       auto &port_info_a( a->output.getPortInfoFor( a_port ) );
       port_info_a.fixed_buffer_size = buffer;
+      port_info_a.buffer_type       = B;
+      port_info_a.wait              = W;
+      port_info_a.batch             = batch;
+      port_info_a.place             = place;
       auto &port_info_b( b->input.getPortInfoFor( b_port) );
       port_info_b.fixed_buffer_size = buffer;
+      port_info_b.buffer_type       = B;
+      port_info_b.wait              = W;
+      port_info_b.batch             = batch;
+      port_info_b.place             = place;
       
       join( *a, a_port, port_info_a, 
             *b, b_port, port_info_b );
@@ -228,6 +291,56 @@ public:
 
 
 
+   /**
+    * set_wait - sets the wait strategy used by every edge that
+    * doesn't pick its own in link, default is 
+    * raft::wait::spin_yield. Takes effect at exe().
+    * @param   s - const raft::wait::strategy
+    */
+   void set_wait( const raft::wait::strategy s ) noexcept
+   {
+      assert( s != raft::wait::inherit );
+      default_wait = s;
+   }
+
+   /**
+    * set_fusion - if on, exe() runs each chain of kernels linked
+    * one output port to one input port (a >> b >> c, where b
+    * has no other ports) on one thread instead of one thread per
+    * kernel. The kernels still talk through their FIFOs, which
+    * get FUSED_BUFFER_ITEMS slots each unless link gave them a
+    * fixed size, so items and signals are seen in the same order.
+    * The thread runs a kernel once the FIFO in front of it is
+    * full (or the kernel before it is done) and there's room
+    * for an item in the one after it, so a fused kernel whose
+    * run() reads or writes more items at once than its link
+    * holds needs a bigger link buffer, or the map left unfused.
+    * If it would have to wait on its own thread the FIFO throws
+    * FusedChainBlockedException rather than hang. Kernels that
+    * extend raft::kernel_batch are never fused, nor is anything
+    * run by a scheduler that doesn't run chains (pool_schedule).
+    * Off by default, takes effect at exe().
+    * @param   on - const bool
+    */
+   void set_fusion( const bool on ) noexcept
+   {
+      fusion = on;
+   }
+
+   /**
+    * set_shrink - sets when dynalloc halves an idle edge, the
+    * occupancy watermark, the number of monitor passes it has 
+    * to stay under it and the passes after any resize before
+    * the next shrink (see dynalloc.hpp). Takes effect at exe().
+    * @param   policy - const raft::shrink_policy&
+    */
+   void set_shrink( const raft::shrink_policy &policy ) noexcept
+   {
+      assert( policy.watermark > 0.0 && policy.watermark < 1.0 );
+      assert( policy.window > 0 );
+      shrink = policy;
+   }
+
 protected:
    /**
     * join - helper method joins the two ports given the correct 
@@ -341,6 +454,13 @@ protected:
     * DOES: flatten these kernels into main map once we run 
     */
    std::vector< MapBase* >   sub_maps;
+
+   /** wait strategy for edges linked with raft::wait::inherit **/
+   raft::wait::strategy      default_wait = raft::wait::spin_yield;
+   /** fuse linear chains at exe(), see set_fusion **/
+   bool                      fusion       = false;
+   /** when dynalloc shrinks an edge, see set_shrink **/
+   raft::shrink_policy       shrink;
    friend class raft::map;
 };
    
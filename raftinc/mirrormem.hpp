@@ -0,0 +1,63 @@
+/**
+ * mirrormem.hpp - allocation of "mirrored" memory, the same
+ * physical pages mapped twice back to back so that an access
+ * that runs past the end of the first mapping lands at the start
+ * of it. Used by Buffer::Data< T, Type::Mirrored > so that any
+ * range of a ring buffer is contiguous in the virtual address
+ * space.
+ * @author: agent
+ * @version: Fri Oct 16 22:25:58 2026
+ * 
+ * Copyright 2026 agent
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at:
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef RAFTMIRRORMEM_HPP
+#define RAFTMIRRORMEM_HPP  1
+#include <cstddef>
+
+namespace raft
+{
+
+namespace mirror
+{
+
+/**
+ * granularity - the length of a mirrored region has to be a 
+ * multiple of this (the page size), returns zero if mirrored
+ * memory isn't available on this platform.
+ * @return  std::size_t
+ */
+std::size_t granularity() noexcept;
+
+/**
+ * alloc - map length bytes twice, back to back, length must 
+ * be a multiple of granularity(). Returns the start of the
+ * first mapping or nullptr on failure (or if unsupported), in 
+ * which case the caller should fall back to a normal buffer.
+ * @param   length - const std::size_t
+ * @return  void*
+ */
+void* alloc( const std::size_t length ) noexcept;
+
+/**
+ * free - release memory returned by alloc.
+ * @param   ptr - void* from alloc
+ * @param   length - const std::size_t, same as given to alloc
+ */
+void  free( void * const ptr, const std::size_t length ) noexcept;
+
+} /** end namespace mirror **/
+
+} /** end namespace raft **/
+#endif /* END RAFTMIRRORMEM_HPP */
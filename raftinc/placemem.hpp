@@ -0,0 +1,107 @@
+/**
+ * placemem.hpp - allocation of ring buffer stores with a
+ * raft::placement (see placement.hpp), anonymous mappings
+ * on huge pages and/or bound to a NUMA node with mbind.
+ * @author: agent
+ * @version: Fri Oct 16 23:55:00 2026
+ *
+ * Copyright 2026 agent
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at:
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef RAFTPLACEMEM_HPP
+#define RAFTPLACEMEM_HPP  1
+#include <cstddef>
+#include "placement.hpp"
+
+/**
+ * HUGE_PAGE_SIZE - size of a huge page, stores on huge pages
+ * are mapped on and rounded up to a multiple of this.
+ */
+#ifndef HUGE_PAGE_SIZE
+#define HUGE_PAGE_SIZE ( 1 << 21 )
+#endif
+
+/**
+ * HUGE_PAGE_MIN_STORE - stores smaller than this stay on base
+ * pages even if the edge asks for huge ones, rounding them up
+ * would waste most of the page.
+ */
+#ifndef HUGE_PAGE_MIN_STORE
+#define HUGE_PAGE_MIN_STORE ( 1 << 20 )
+#endif
+
+namespace raft
+{
+
+namespace placemem
+{
+
+/**
+ * nodes - number of NUMA nodes on this machine, one if it
+ * can't be told.
+ * @return  int
+ */
+int nodes() noexcept;
+
+/**
+ * node_of - NUMA node of core, -1 if the core isn't set or
+ * the node can't be found.
+ * @param   core - const int, as from kernel::getCoreAssignment
+ * @return  int
+ */
+int node_of( const int core ) noexcept;
+
+/**
+ * node_of - NUMA node the page at ptr is on (faulting it in
+ * if it isn't yet), -1 if it can't be told.
+ * @param   ptr - const void*
+ * @return  int
+ */
+int node_of( const void * const ptr ) noexcept;
+
+/**
+ * huge_pages - whether the kernel backs the mapping ptr is in
+ * with huge pages, either explicit ones or transparent ones 
+ * it was advised to use.
+ * @param   ptr - const void*
+ * @return  int - 1 if so, 0 if not, -1 if it can't be told
+ */
+int huge_pages( const void * const ptr ) noexcept;
+
+/**
+ * alloc - map a store of at least length bytes placed as
+ * given. Returns nullptr if place asks for nothing this
+ * platform (or machine) can do, in which case the caller
+ * should allocate the store as usual. On success mapped is
+ * set to the length actually mapped.
+ * @param   length - const std::size_t
+ * @param   place - const raft::placement&
+ * @param   mapped - std::size_t&, to pass to free
+ * @return  void*
+ */
+void* alloc( const std::size_t length,
+             const raft::placement &place,
+             std::size_t &mapped ) noexcept;
+
+/**
+ * free - release memory returned by alloc.
+ * @param   ptr - void* from alloc
+ * @param   mapped - const std::size_t, as set by alloc
+ */
+void  free( void * const ptr, const std::size_t mapped ) noexcept;
+
+} /** end namespace placemem **/
+
+} /** end namespace raft **/
+#endif /* END RAFTPLACEMEM_HPP */
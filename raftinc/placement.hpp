@@ -0,0 +1,90 @@
+/**
+ * placement.hpp - per edge setting for where the store of a
+ * heap backed ring goes. By default the store comes from
+ * posix_memalign, i.e., base pages on whichever NUMA node
+ * first touches them (usually the producer's). A big edge can
+ * ask for huge pages instead, transparent (madvise) or explicit
+ * (MAP_HUGETLB, falling back to transparent when the pool is
+ * empty), and to have the store bound to the node of the core
+ * the consumer is assigned to. On a single node machine, or
+ * where neither is available, the store is allocated as usual.
+ * @author: agent
+ * @version: Fri Oct 16 23:55:00 2026
+ *
+ * Copyright 2026 agent
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at:
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef RAFTPLACEMENT_HPP
+#define RAFTPLACEMENT_HPP  1
+#include <cstdint>
+
+namespace raft
+{
+
+/** pages backing the store **/
+enum class pages : std::uint8_t { base, transparent, huge };
+
+/**
+ * NUMA node for the store, consumer goes by the core the 
+ * partitioner assigned to the consumer kernel before the
+ * FIFOs are allocated. Only partition_scotch (USE_PARTITION) 
+ * and partition_basic (map.exe< partition_basic >()) assign
+ * cores, with the default partition_dummy no kernel has one
+ * and consumer is the same as first_touch.
+ */
+enum class numa : std::uint8_t { first_touch, consumer };
+
+struct placement
+{
+   placement() = default;
+
+   /**
+    * placement -
+    * @param   page - const raft::pages
+    * @param   policy - const raft::numa, consumer binds the
+    *          store to the node of the consumer's core, if
+    *          the partitioner set one (see raft::numa)
+    */
+   explicit placement( const raft::pages page,
+                       const raft::numa policy = raft::numa::first_touch ) :
+                                                            page( page ),
+                                                            policy( policy )
+   {
+   }
+
+   explicit placement( const raft::numa policy ) : policy( policy )
+   {
+   }
+
+   /**
+    * is_default - true if the store can come from the heap
+    * as usual.
+    * @return  bool
+    */
+   bool is_default() const noexcept
+   {
+      return( page == raft::pages::base && node < 0 );
+   }
+
+   raft::pages page   = raft::pages::base;
+   raft::numa  policy = raft::numa::first_touch;
+   /**
+    * node to bind the store to, resolved by the allocator from
+    * the consumer's core for raft::numa::consumer, -1 is none
+    */
+   int         node   = -1;
+};
+
+} /** end namespace raft **/
+#endif /* END RAFTPLACEMENT_HPP */
@@ -32,21 +32,36 @@ class ALIGN( L1D_CACHE_LINE_SIZE ) Pointer
     using wrap_t = std::size_t;
 
 public:
-   Pointer() : max_cap( 0 ){}
+   Pointer() : max_cap( 0 ), mask( 0 ){}
 
    /**
     * Pointer - used to synchronize read and write
     * pointers for the ring buffer.  This class encapsulates
-    * wrapping.
+    * wrapping. The pointer itself is a free running 64-bit
+    * counter, the index into the buffer is the counter
+    * masked by cap - 1 when cap is a power of two (the 
+    * allocators make sure it is), otherwise we fall back
+    * to the modulo.
     */
-   Pointer( const std::size_t cap ) : max_cap( cap ){}
+   Pointer( const std::size_t cap ) : max_cap( cap ),
+                                      mask( Pointer::is_pow2( cap ) ? 
+                                            cap - 1 : 0 ){}
    
+   /**
+    * Pointer - same as above, but starts the counter 
+    * wrap_set laps ahead, e.g., a write pointer for a 
+    * buffer that starts out full.
+    * @param   cap - const std::size_t
+    * @param   wrap_set - number of laps to start at
+    */
    Pointer( const std::size_t cap, 
             const wrap_t wrap_set );
    /**
     * Pointer - used to snchronize read and write pointers for the
     * ring buffer, this constructer is a copy constructor that
-    * copies an old Pointer object and sets a new max_capacity
+    * copies an old Pointer object and sets a new max_capacity.
+    * The position is kept as is, items keep their positions 
+    * across a resize and only their index changes
     * @param   other, const Pointer&, the other pointer to be cpied
     * @param   new_cap, the new max cap
     */
@@ -60,9 +75,20 @@ public:
    static std::size_t val( Pointer &ptr ) ;
 
    /**
-    * inc - increments the pointer, takes care of wrapping
-    * the pointers as well so you don't run off the page
-    * @return  std::size_t, current value of pointer after increment
+    * index - returns the index into a buffer of this 
+    * pointer's capacity for the given position, i.e., 
+    * what val() would return if the pointer were at
+    * position.
+    * @param   ptr - Pointer&
+    * @param   position - const std::uint64_t
+    * @return  std::size_t
+    */
+   static std::size_t index( Pointer &ptr, 
+                             const std::uint64_t position ) noexcept;
+
+   /**
+    * inc - increments the pointer, wrapping is taken care 
+    * of by val() so this is a simple add.
     */
    static void inc( Pointer &ptr ) ;
    
@@ -77,35 +103,43 @@ public:
    static void incBy( Pointer &ptr,
                       const std::size_t in );
 
-   
    /**
-    * wrapIndiciator - returns the current wrap position, 
-    * the read should never be ahead of the write, and 
-    * at best they should be equal.  This is used when
-    * determining to return max_cap or zero for the current
-    * queue size.  
-    * @return  std::size_t
+    * position - returns the number of increments this
+    * pointer has seen since it was constructed (plus any
+    * laps it was started with).  The read and write 
+    * positions are directly comparable, size is simply 
+    * write - read.  When read from the thread that
+    * doesn't own the pointer the value returned is never
+    * ahead of the true position, it can however lag behind
+    * it, so it is safe to use as a conservative snapshot.
+    * @return  std::uint64_t
     */
-   static std::size_t wrapIndicator( Pointer &ptr ) ;
+   static std::uint64_t position( Pointer &ptr ) ;
+
+   /**
+    * is_pow2 - returns true if n is a non-zero power
+    * of two.
+    * @param   n - const std::size_t
+    * @return  bool
+    */
+   static constexpr bool is_pow2( const std::size_t n ) noexcept
+   {
+      return( n != 0 && ( n & ( n - 1 ) ) == 0 );
+   }
    
 private:
-    volatile std::uint64_t           a  = 0;
-#ifdef JVEC_MACHINE    
-    volatile std::uint64_t           b  = 0;
-#endif    
     /**
-     * size of wrap pointer might become an issue
-     * if GHz increase drastically or if this runs
-     * for a really really long time....@ 10GHz and
-     * assuming 1 wrap per cycle that works out to 
-     * around 54 years, @ 2GHz we have ~250 years.
-     * TODO, get these set correctly if we do eventually
-     * wrap an unsigned 64 int.
+     * free running counters, at 10GHz and one increment
+     * per cycle these take ~58 years to overflow, and when
+     * they do the masked index is still correct for power
+     * of two capacities.
      */
-    volatile wrap_t    wrap_a  = 0;
+    volatile std::uint64_t           a  = 0;
 #ifdef JVEC_MACHINE    
-    volatile wrap_t    wrap_b  = 0;
+    volatile std::uint64_t           b  = 0;
 #endif    
     const    std::size_t      max_cap;
+    /** max_cap - 1 if max_cap is a power of two, zero otherwise **/
+    const    std::size_t      mask;
 };
 #endif /* END RAFTPOINTER_HPP */
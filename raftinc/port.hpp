@@ -35,10 +35,15 @@
 #include "fifo.hpp"
 #include "port_info.hpp"
 #include "ringbuffer.tcc"
+#include "broadcast.tcc"
+#include "recordring.hpp"
+#include "porthandle.hpp"
+#include "channel.hpp"
 #include "port_info_types.hpp"
 #include "portmap_t.hpp"
 #include "portiterator.hpp"
 #include "portexception.hpp"
+#include "common.hpp"
 #include "defs.hpp"
 
 /** needed for friending below **/
@@ -206,6 +211,36 @@ public:
    virtual FIFO& operator[]( const std::string &&port_name  );
    virtual FIFO& operator[]( const std::string &port_name ); 
 
+   /**
+    * handle - typed handle on the port, see porthandle.hpp.
+    * Does the lookup that operator[] does on every call once,
+    * keep the handle and use it in run().
+    * @param   port_name - const std::string&
+    * @return  raft::port_handle< T >
+    * @throws  PortNotFoundException, PortTypeMismatchException
+    */
+   template < class T >
+   raft::port_handle< T > handle( const std::string &port_name )
+   {
+      return( raft::port_handle< T >( 
+         &getPortInfoOf< T >( port_name, "handle" ) ) );
+   }
+
+   /**
+    * channel - like handle, but the ring type is given too and
+    * the calls don't go through the FIFO's virtuals, see 
+    * channel.hpp.
+    * @param   port_name - const std::string&
+    * @return  raft::channel< T, type >
+    * @throws  PortNotFoundException, PortTypeMismatchException
+    */
+   template < class T, Type::RingBufferType type = Type::Heap >
+   raft::channel< T, type > channel( const std::string &port_name )
+   {
+      return( raft::channel< T, type >( 
+         &getPortInfoOf< T >( port_name, "channel" ) ) );
+   }
+
    /**
     * hasPorts - returns true if any ports exists, false
     * otherwise.
@@ -288,6 +323,61 @@ protected:
          std::make_pair( true /** yes instrumentation **/,
                          RingBuffer< T, Type::Heap, true >::make_new_fifo ) );
 
+      pi.const_map.insert(
+         std::make_pair( Type::SPSC , std::make_shared< instr_map_t >() ) );
+
+      pi.const_map[ Type::SPSC ]->insert(
+         std::make_pair( false /** no instrumentation **/,
+                         RingBuffer< T, Type::SPSC, false >::make_new_fifo ) );
+      pi.const_map[ Type::SPSC ]->insert(
+         std::make_pair( true /** yes instrumentation **/,
+                         RingBuffer< T, Type::SPSC, true >::make_new_fifo ) );
+
+      pi.const_map.insert(
+         std::make_pair( Type::Mirrored , std::make_shared< instr_map_t >() ) );
+
+      pi.const_map[ Type::Mirrored ]->insert(
+         std::make_pair( false /** no instrumentation **/,
+                         RingBuffer< T, Type::Mirrored, false >::make_new_fifo ) );
+      pi.const_map[ Type::Mirrored ]->insert(
+         std::make_pair( true /** yes instrumentation **/,
+                         RingBuffer< T, Type::Mirrored, true >::make_new_fifo ) );
+
+      pi.const_map.insert(
+         std::make_pair( Type::Infinite , std::make_shared< instr_map_t >() ) );
+
+      pi.const_map[ Type::Infinite ]->insert(
+         std::make_pair( false /** no instrumentation **/,
+                         RingBuffer< T, Type::Infinite, false >::make_new_fifo ) );
+      pi.const_map[ Type::Infinite ]->insert(
+         std::make_pair( true /** yes instrumentation **/,
+                         RingBuffer< T, Type::Infinite, true >::make_new_fifo ) );
+
+      /**
+       * FanIn builds the ring of one producer, the allocator 
+       * adds it to the FanIn on the consumer's port
+       */
+      pi.const_map.insert(
+         std::make_pair( Type::FanIn , std::make_shared< instr_map_t >() ) );
+
+      pi.const_map[ Type::FanIn ]->insert(
+         std::make_pair( false /** no instrumentation **/,
+                         RingBuffer< T, Type::Heap, false >::make_new_fifo ) );
+      pi.const_map[ Type::FanIn ]->insert(
+         std::make_pair( true /** yes instrumentation **/,
+                         RingBuffer< T, Type::Heap, true >::make_new_fifo ) );
+
+      /** builds the producer end, the allocator adds the readers **/
+      pi.const_map.insert(
+         std::make_pair( Type::Broadcast , std::make_shared< instr_map_t >() ) );
+
+      pi.const_map[ Type::Broadcast ]->insert(
+         std::make_pair( false /** no instrumentation **/,
+                         Broadcast< T >::make_new_fifo ) );
+      pi.const_map[ Type::Broadcast ]->insert(
+         std::make_pair( true /** yes instrumentation **/,
+                         Broadcast< T >::make_new_fifo ) );
+
       //pi.const_map.insert( std::make_pair( Type::SharedMemory, new instr_map_t() ) );
       //pi.const_map[ Type::SharedMemory ]->insert(
       //   std::make_pair( false /** no instrumentation **/,
@@ -351,6 +441,28 @@ protected:
     */
    PortInfo& getPortInfoFor( const std::string port_name );
 
+   /**
+    * getPortInfoOf - getPortInfoFor that also checks the port
+    * is of type T, for handle and channel.
+    * @param   port_name - const std::string&
+    * @param   what - const char*, caller's name for the message
+    * @return  PortInfo&
+    */
+   template < class T >
+   PortInfo& getPortInfoOf( const std::string &port_name, 
+                            const char * const what )
+   {
+      auto &pi( getPortInfoFor( port_name ) );
+      if( pi.type != std::type_index( typeid( T ) ) )
+      {
+         throw PortTypeMismatchException( std::string( what ) + "< " + 
+            common::printClassNameFromStr( typeid( T ).name() ) + 
+            " > asked for on port \"" + port_name + 
+            "\" which is of another type" );
+      }
+      return( pi );
+   }
+
    /**
     * portmap - container struct with all ports.  The
     * mutex should be locked before accessing this structure
@@ -384,6 +496,27 @@ protected:
    friend class raft::parallel_k;
 };
 
+/**
+ * initializeConstMap - ports of type raft::bytes carry records
+ * (see record.hpp), on a Heap or SPSC link they get a 
+ * RecordRing, which is single producer, single consumer
+ * already. No other FIFO type takes records.
+ */
+template <> inline void Port::initializeConstMap< raft::bytes >( PortInfo &pi )
+{
+   for( const auto type : { Type::Heap, Type::SPSC } )
+   {
+      pi.const_map.insert(
+         std::make_pair( type, std::make_shared< instr_map_t >() ) );
+      pi.const_map[ type ]->insert(
+         std::make_pair( false /** no instrumentation **/,
+                         RecordRing::make_new_fifo ) );
+      pi.const_map[ type ]->insert(
+         std::make_pair( true /** yes instrumentation **/,
+                         RecordRing::make_new_fifo ) );
+   }
+   return;
+}
 
 
 #endif /* END RAFTPORT_HPP */
@@ -26,12 +26,17 @@
 #include <functional>
 #include <cstddef>
 #include <memory>
+#include <vector>
+#include <utility>
 #include <cassert>
 
 #include "alloc_defs.hpp"
 #include "ringbuffertypes.hpp"
 #include "port_info_types.hpp"
 #include "fifo.hpp"
+#include "waitstrategy.hpp"
+#include "batch.hpp"
+#include "placement.hpp"
 
 namespace raft{
    class kernel;
@@ -61,7 +66,20 @@ struct PortInfo
     * until the FIFO is fully emptied.
     * @return FIFO*
     */
-   FIFO* getFIFO();
+   FIFO* getFIFO()
+   {
+      struct{
+         FIFO *a;
+         FIFO *b;
+      }copy = { fifo_a, fifo_b };
+      /** for most architectures that don't need this, it'll be optimized out after the first iteration **/
+      while( copy.a != copy.b )
+      {
+         copy.a = fifo_a;
+         copy.b = fifo_b;
+      }
+      return( copy.a );
+   }
 
    /**
     * setFIFO - call this funciton to set a FIFO, updates both
@@ -103,6 +121,11 @@ struct PortInfo
    
    raft::kernel     *other_kernel    = nullptr;
    std::string       other_name      = "";
+   /** 
+    * Type::Broadcast output ports only, every kernel/port
+    * linked after the first one (which is other_kernel).
+    */
+   std::vector< std::pair< raft::kernel*, std::string > > broadcast_to;
    
    /** runtime settings **/
    bool              use_my_allocator= false;
@@ -112,5 +135,13 @@ struct PortInfo
    std::size_t       nitems          = 0;
    std::size_t       start_index     = 0;
    std::size_t       fixed_buffer_size = 0;   
+   /** FIFO type to allocate, must have an entry in const_map **/
+   Type::RingBufferType buffer_type  = Type::Heap;
+   /** how the FIFO endpoints wait, inherit means the map default **/
+   raft::wait::strategy wait         = raft::wait::inherit;
+   /** batched index publication for the edge, see batch.hpp **/
+   raft::batch          batch;
+   /** pages and NUMA node for the store, see placement.hpp **/
+   raft::placement      place;
 };
 #endif /* END RAFTPORT_INFO_HPP */
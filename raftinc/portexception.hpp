@@ -99,4 +99,22 @@ using PortAlreadyExists
 using PortUnconnectedException
     = PortExceptionBase< 7 >;
 
+/**
+ * RecordTooLargeException - a record bigger than half the store
+ * of a record ring (see recordring.hpp) was allocated, it could
+ * never fit.
+ */
+using RecordTooLargeException
+    = PortExceptionBase< 8 >;
+
+/**
+ * FusedChainBlockedException - a kernel in a fused chain (see
+ * map::set_fusion) had to wait on an edge whose other end runs
+ * on the same thread, e.g., it pushed more items in one run()
+ * than there was room for. Nothing could ever wake it, so this
+ * is thrown rather than hang.
+ */
+using FusedChainBlockedException
+    = PortExceptionBase< 9 >;
+
 #endif
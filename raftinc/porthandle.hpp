@@ -0,0 +1,156 @@
+/**
+ * porthandle.hpp - typed handle on a single port, returned by
+ * input.handle< T >( name ) / output.handle< T >( name ). The
+ * name is looked up (and the type checked) once when the handle
+ * is made, after that each call goes straight to the port's
+ * FIFO without the std::map find and string compare that
+ * input[ name ] costs. Make them in the kernel's constructor
+ * after addPort, or anywhere before run() is called.
+ *
+ * The handle keeps the port's PortInfo, not the FIFO, and reads
+ * the FIFO pointer from it on every call (two loads, see
+ * PortInfo::getFIFO()). A dynalloc resize swaps the store under
+ * the same FIFO, the allocator and the auto-parallel code can
+ * swap the FIFO itself, the handle follows both.
+ * @author: agent
+ * @version: Sat Oct 17 00:15:18 2026
+ *
+ * Copyright 2026 agent
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at:
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef RAFTPORTHANDLE_HPP
+#define RAFTPORTHANDLE_HPP  1
+#include <cassert>
+#include <cstddef>
+#include <utility>
+#include "fifo.hpp"
+#include "port_info.hpp"
+#include "signalvars.hpp"
+
+namespace raft
+{
+
+template < class T > class port_handle
+{
+public:
+   /** unbound, assign one from handle< T >() before use **/
+   port_handle() = default;
+
+   explicit port_handle( PortInfo * const info ) : info( info )
+   {
+      assert( info != nullptr );
+   }
+
+   /** fifo - the FIFO currently behind the port **/
+   FIFO& fifo() const
+   {
+      assert( info != nullptr );
+      auto * const f( info->getFIFO() );
+      assert( f != nullptr );
+      return( *f );
+   }
+
+   FIFO* operator ->() const
+   {
+      return( &fifo() );
+   }
+
+   /** bound - true if made by handle< T >() **/
+   bool bound() const noexcept
+   {
+      return( info != nullptr );
+   }
+
+   /** calls below are the FIFO calls of the same name **/
+   std::size_t size() const
+   {
+      return( fifo().size() );
+   }
+
+   std::size_t space_avail() const
+   {
+      return( fifo().space_avail() );
+   }
+
+   template < class... Args > T& allocate( Args&&... params ) const
+   {
+      return( fifo().template allocate< T >( std::forward< Args >( params )... ) );
+   }
+
+   void send( const raft::signal signal = raft::none ) const
+   {
+      fifo().send( signal );
+   }
+
+   void push( const T &item, const raft::signal signal = raft::none ) const
+   {
+      fifo().push( item, signal );
+   }
+
+   void push( T &&item, const raft::signal signal = raft::none ) const
+   {
+      fifo().push( std::move( item ), signal );
+   }
+
+   void insert( const T * const items,
+                const std::size_t n,
+                const raft::signal signal = raft::none ) const
+   {
+      fifo().insert( items, n, signal );
+   }
+
+   void pop( T &item, raft::signal *signal = nullptr ) const
+   {
+      fifo().pop( item, signal );
+   }
+
+   void pop_range( T * const items,
+                   const std::size_t n,
+                   raft::signal * const signals = nullptr ) const
+   {
+      fifo().pop_range( items, n, signals );
+   }
+
+   T& peek( raft::signal *signal = nullptr ) const
+   {
+      return( fifo().template peek< T >( signal ) );
+   }
+
+   auto peek_range( const std::size_t n ) const ->
+      decltype( std::declval< FIFO& >().template peek_range< T >( n ) )
+   {
+      return( fifo().template peek_range< T >( n ) );
+   }
+
+   void unpeek() const
+   {
+      fifo().unpeek();
+   }
+
+   void recycle( const std::size_t range = 1 ) const
+   {
+      fifo().recycle( range );
+   }
+
+   void flush() const
+   {
+      fifo().flush();
+   }
+
+private:
+   PortInfo *info = nullptr;
+};
+
+} /** end namespace raft **/
+#endif /* END RAFTPORTHANDLE_HPP */
@@ -0,0 +1,82 @@
+/**
+ * record.hpp - port type and views for record rings. A port
+ * added as addPort< raft::bytes >( name ) gets a RecordRing
+ * (see recordring.hpp) instead of a typed ring, which carries
+ * length prefixed variable length records inline in a byte
+ * store. The producer writes straight into the ring through
+ * the raft::byte_span returned by allocate_bytes, the consumer
+ * reads straight out of it through the raft::record returned
+ * by peek_record, so strings and blobs don't need a heap
+ * allocation of their own.
+ * @author: agent
+ * @version: Sat Oct 17 00:01:59 2026
+ *
+ * Copyright 2026 agent
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at:
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef RAFTRECORD_HPP
+#define RAFTRECORD_HPP  1
+#include <cstddef>
+#include <string>
+
+namespace raft
+{
+
+/** port type of a record ring, never instantiated **/
+struct bytes{};
+
+/**
+ * basic_record - pointer and length into the store of a
+ * record ring, only valid till the record is sent (producer)
+ * or recycled (consumer).
+ */
+template < class C > class basic_record
+{
+public:
+   basic_record() = default;
+
+   basic_record( C * const ptr, const std::size_t length ) : ptr( ptr ),
+                                                             length( length )
+   {
+   }
+
+   C*          data()  const noexcept { return( ptr ); }
+   std::size_t size()  const noexcept { return( length ); }
+   bool        empty() const noexcept { return( length == 0 ); }
+   C*          begin() const noexcept { return( ptr ); }
+   C*          end()   const noexcept { return( ptr + length ); }
+
+   C& operator []( const std::size_t i ) const noexcept
+   {
+      return( ptr[ i ] );
+   }
+
+   /** str - copy of the record **/
+   std::string str() const
+   {
+      return( std::string( ptr, length ) );
+   }
+
+private:
+   C           *ptr    = nullptr;
+   std::size_t  length = 0;
+};
+
+/** read only view of a record, from peek_record **/
+using record    = basic_record< const char >;
+/** writeable bytes for a record, from allocate_bytes **/
+using byte_span = basic_record< char >;
+
+} /** end namespace raft **/
+#endif /* END RAFTRECORD_HPP */
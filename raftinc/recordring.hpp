@@ -0,0 +1,183 @@
+/**
+ * recordring.hpp - FIFO for ports of type raft::bytes (see
+ * record.hpp). Records are stored inline in a power of two
+ * byte store, each behind an 8 byte header with its length
+ * and signal and padded to a multiple of the header. A record
+ * never wraps, if it doesn't fit before the end of the store
+ * the producer leaves a marker and starts it at the front, so
+ * a record can be at most half the store. The producer
+ * publishes a count of records, the consumer the byte
+ * position it has read up to. Single producer, single
+ * consumer, the store isn't resized.
+ * @author: agent
+ * @version: Sat Oct 17 00:01:59 2026
+ *
+ * Copyright 2026 agent
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at:
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef RAFTRECORDRING_HPP
+#define RAFTRECORDRING_HPP  1
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include "fifo.hpp"
+#include "record.hpp"
+#include "waitstrategy.hpp"
+#include "internaldefs.hpp"
+
+/**
+ * RECORD_RING_MIN_BYTES - smallest store for a record ring,
+ * the buffer size given to link is taken as bytes and rounded
+ * up to a power of two no smaller than this.
+ */
+#ifndef RECORD_RING_MIN_BYTES
+#define RECORD_RING_MIN_BYTES ( 1 << 16 )
+#endif
+
+class RecordRing : public FIFO
+{
+public:
+   RecordRing( const std::size_t n_bytes );
+
+   virtual ~RecordRing();
+
+   /**
+    * make_new_fifo - same as for the typed rings, n_items is
+    * the size of the store in bytes, there's no user supplied
+    * store for a record ring.
+    */
+   static FIFO* make_new_fifo( const std::size_t n_items,
+                               const std::size_t align,
+                               void * const data );
+
+   /** size - records on the ring **/
+   virtual std::size_t size();
+   /** space_avail - free bytes, including those of the headers **/
+   virtual std::size_t space_avail();
+   /** capacity - bytes in the store **/
+   virtual std::size_t capacity();
+
+   virtual void deallocate();
+   virtual void send( const raft::signal signal = raft::none );
+   virtual void send_range( const raft::signal signal = raft::none );
+   virtual void unpeek();
+
+   /** not resizeable, does nothing **/
+   virtual void resize( const std::size_t n_items,
+                        const std::size_t align,
+                        volatile bool &exit_alloc );
+   virtual float get_frac_write_blocked();
+   virtual std::size_t get_suggested_count();
+   virtual std::size_t footprint();
+
+   virtual void invalidate();
+   virtual bool is_invalid();
+
+   virtual void set_wait_strategy( const raft::wait::strategy s );
+
+protected:
+   virtual raft::signal signal_peek();
+   virtual void signal_pop();
+   virtual void inline_signal_send( const raft::signal sig );
+
+   /** the typed calls, these all throw PortTypeMismatchException **/
+   virtual void local_allocate( void **ptr );
+   virtual void local_allocate_n( void *ptr, const std::size_t n );
+   virtual void local_allocate_span( void *range, const std::size_t n );
+   virtual void local_push( void *ptr, const raft::signal &signal );
+   virtual void local_insert( void *ptr_begin,
+                              void *ptr_end,
+                              const raft::signal &signal,
+                              const std::size_t iterator_type );
+   virtual void local_pop( void *ptr, raft::signal *signal );
+   virtual void local_pop_range( void *ptr_data,
+                                 const std::size_t n_items );
+   virtual void local_peek( void **ptr, raft::signal *signal );
+   virtual void local_peek_range( void **ptr,
+                                  void **sig,
+                                  const std::size_t n_items,
+                                  std::size_t &curr_pointer_loc ,
+                                  std::size_t &queue_size );
+   virtual void local_peek_span( void *range, const std::size_t n );
+
+   /** drops range records, or as many as there are **/
+   virtual void local_recycle( std::size_t range );
+
+   virtual raft::byte_span local_allocate_bytes( const std::size_t n );
+   virtual void local_send_bytes( const std::size_t used,
+                                  const raft::signal signal );
+   virtual raft::record local_peek_record( raft::signal *signal );
+
+private:
+   struct header
+   {
+      std::uint32_t  length;
+      raft::signal   signal;
+   };
+
+   /** length of the marker left where a record didn't fit **/
+   static constexpr std::uint32_t wrap = ~static_cast< std::uint32_t >( 0 );
+
+   /** bytes taken by a record of n bytes, header included **/
+   static std::size_t footprint_of( const std::size_t n ) noexcept
+   {
+      return( sizeof( header ) +
+              ( ( n + sizeof( header ) - 1 ) & ~( sizeof( header ) - 1 ) ) );
+   }
+
+   header* at( const std::uint64_t pos ) const noexcept
+   {
+      return( reinterpret_cast< header* >( store + ( pos & mask ) ) );
+   }
+
+   /** record_at - consumer, position of the record at pos, past a marker **/
+   std::uint64_t record_at( const std::uint64_t pos ) const noexcept
+   {
+      return( at( pos )->length == wrap ? pos + ( cap - ( pos & mask ) ) : pos );
+   }
+
+   /** typed_call - for the calls a record ring can't take **/
+   static void typed_call( const char * const name );
+
+   void wake_consumer() noexcept;
+   void wake_producer() noexcept;
+
+   const std::size_t  cap;
+   const std::size_t  mask;
+   char              *store = nullptr;
+
+   /** written by the producer **/
+   struct ALIGN( L1D_CACHE_LINE_SIZE ) {
+      /** byte position after the last record sent **/
+      std::atomic< std::uint64_t > tail   = { 0 };
+      std::atomic< std::uint64_t > count  = { 0 };
+      /** allocate_bytes **/
+      bool                         allocated = false;
+      std::uint64_t                start     = 0;
+      std::size_t                  reserved  = 0;
+   } producer;
+
+   /** written by the consumer **/
+   struct ALIGN( L1D_CACHE_LINE_SIZE ) {
+      /** byte position after the last record recycled **/
+      std::atomic< std::uint64_t > head   = { 0 };
+      std::atomic< std::uint64_t > count  = { 0 };
+   } consumer;
+
+   std::atomic< bool >          valid         = { true };
+   raft::wait::strategy         wait_strategy = raft::wait::spin_yield;
+   raft::wait::spot             data_ready;
+   raft::wait::spot             space_ready;
+};
+#endif /* END RAFTRECORDRING_HPP */
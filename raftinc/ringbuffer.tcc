@@ -107,14 +107,14 @@ public:
         if( data != nullptr )
         {
             return( 
-                new RingBuffer<T, Type::Heap, false>( data, 
-                                                      n_items, 
-                                                      align /** actually start pos, redesign **/)
+                new RingBuffer<T, type, false>( data, 
+                                                n_items, 
+                                                align /** actually start pos, redesign **/)
             );
         }
         else
         {
-            return( new RingBuffer< T, Type::Heap, false >(n_items, align ) );
+            return( new RingBuffer< T, type, false >(n_items, align ) );
         }
     }
 
@@ -123,8 +123,13 @@ public:
     {
         if((this)->datamanager.is_resizeable())
         {
+            /** new store goes where the old one was asked to **/
             (this)->datamanager.resize(
-                new Buffer::Data<T, type>(size, align), exit_alloc);
+                new Buffer::Data<T, type>(size, align, 
+                                          (this)->datamanager.get()->place), 
+                exit_alloc);
+            /** anyone parked may have room (or items) now **/
+            (this)->wake_all();
         }
         /** else, not resizeable..just return **/
         return;
@@ -144,7 +149,7 @@ public:
     RingBufferBaseMonitor(const std::size_t n, const std::size_t align)
         : RingBufferBase<T, type>(), term(false)
     {
-        (this)->datamanager.set(new Buffer::Data<T, Type::Heap>(n, align));
+        (this)->datamanager.set(new Buffer::Data<T, type>(n, align));
         (this)->init();
         /** add monitor types immediately after construction **/
         // sample_master.registerSample( new MeanSampleType< T, type >() );
@@ -186,8 +191,13 @@ public:
     {
         if((this)->datamanager.is_resizeable())
         {
+            /** new store goes where the old one was asked to **/
             (this)->datamanager.resize(
-                new Buffer::Data<T, type>(size, align), exit_alloc);
+                new Buffer::Data<T, type>(size, align, 
+                                          (this)->datamanager.get()->place), 
+                exit_alloc);
+            /** anyone parked may have room (or items) now **/
+            (this)->wake_all();
         }
         /** else, not resizeable..just return **/
         return;
@@ -226,7 +236,65 @@ public:
     }
 };
 
-/** specialization for dummy one **/
+template <class T>
+class RingBuffer<T, Type::SPSC, true /* monitor */>
+    : public RingBufferBaseMonitor<T, Type::SPSC>
+{
+public:
+    /**
+     * RingBuffer - default constructor, initializes basic
+     * data structures.
+     */
+    RingBuffer(const std::size_t n, const std::size_t align = 16)
+        : RingBufferBaseMonitor<T, Type::SPSC>(n, align)
+    {
+        /** nothing really to do **/
+    }
+
+    virtual ~RingBuffer() = default;
+
+    static FIFO* make_new_fifo( const std::size_t n_items, 
+                                const std::size_t align, 
+                                void * const data )
+    {
+        UNUSED( data );
+        assert(data == nullptr);
+        return( new RingBuffer<T, Type::SPSC, true>(n_items, align) );
+    }
+};
+
+template <class T>
+class RingBuffer<T, Type::Mirrored, true /* monitor */>
+    : public RingBufferBaseMonitor<T, Type::Mirrored>
+{
+public:
+    /**
+     * RingBuffer - default constructor, initializes basic
+     * data structures.
+     */
+    RingBuffer(const std::size_t n, const std::size_t align = 16)
+        : RingBufferBaseMonitor<T, Type::Mirrored>(n, align)
+    {
+        /** nothing really to do **/
+    }
+
+    virtual ~RingBuffer() = default;
+
+    static FIFO* make_new_fifo( const std::size_t n_items, 
+                                const std::size_t align, 
+                                void * const data )
+    {
+        UNUSED( data );
+        assert(data == nullptr);
+        return( new RingBuffer<T, Type::Mirrored, true>(n_items, align) );
+    }
+};
+
+/** 
+ * Type::Infinite, the queue grows a segment at a time so 
+ * there's nothing for the dynamic allocator to resize, n
+ * is the number of items per segment.
+ */
 template <class T>
 class RingBuffer<T, Type::Infinite, true /* monitor */>
     : public RingBufferBaseMonitor<T, Type::Infinite>
@@ -238,24 +306,33 @@ public:
      */
     RingBuffer( const std::size_t n, 
                 const std::size_t align = 16 )
-        : RingBufferBaseMonitor<T, Type::Infinite>(1, align)
+        : RingBufferBaseMonitor<T, Type::Infinite>(n, align)
     {
-        UNUSED( n );
+        /** nothing really to do **/
     }
 
     virtual ~RingBuffer() = default;
 
     static FIFO* make_new_fifo( const std::size_t n_items, 
                                 const std::size_t align, 
-                                void const * data )
+                                void * const data )
     {
         UNUSED( data );
         assert(data == nullptr);
         return (new RingBuffer<T, Type::Infinite, true>(n_items, align));
     }
+
+    virtual void resize( const std::size_t size, 
+                         const std::size_t align, 
+                         volatile bool& exit_alloc )
+    {
+        UNUSED( size );
+        UNUSED( align );
+        UNUSED( exit_alloc );
+        return;
+    }
 };
 
-/** specialization for dummy with no instrumentation **/
 template <class T>
 class RingBuffer< T, Type::Infinite, false >
     : public RingBufferBase< T, Type::Infinite >
@@ -269,8 +346,10 @@ public:
                 const std::size_t align = 16)
         : RingBufferBase<T, Type::Infinite>()
     {
-        UNUSED( n );
-        (this)->datamanager.set(new Buffer::Data<T, Type::Heap>( 1, align ));
+        assert( n != 0 );
+        (this)->datamanager.set( 
+            new Buffer::Data< T, Type::Infinite >( n, align ) );
+        (this)->init();
     }
 
     virtual ~RingBuffer()
@@ -298,19 +377,15 @@ public:
         return (new RingBuffer<T, Type::Infinite, false>(n_items, align));
     }
 
-    virtual void resize(
-        const std::size_t size, 
-        const std::size_t align, 
-        bool& exit_alloc)
+    virtual void resize( const std::size_t size, 
+                         const std::size_t align, 
+                         volatile bool& exit_alloc )
     {
         UNUSED( size );
         UNUSED( align );
         UNUSED( exit_alloc );
-
-        /** should never really be calling this function **/
-        assert(false);
+        return;
     }
-
 };
 
 
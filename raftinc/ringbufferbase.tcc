@@ -40,6 +40,7 @@
 namespace raft
 {
    class kernel;
+   template < class T, Type::RingBufferType type > class channel;
 }
 
 /**
@@ -20,6 +20,7 @@
 #ifndef RAFTRINGBUFFERHEAP_TCC
 #define RAFTRINGBUFFERHEAP_TCC  1
 
+#include <algorithm>
 #include "portexception.hpp"
 #include "ringbufferheap_abstract.tcc"
 #include "defs.hpp"
@@ -30,20 +31,24 @@
 #include "sysschedutil.hpp"
 
 /** inline alloc **/
-template < class T >
+template < class T, Type::RingBufferType type >
 class RingBufferBase<
     T,
-    Type::Heap,
-    typename std::enable_if< inline_nonclass_alloc< T >::value >::type >
-: public RingBufferBaseHeap< T, Type::Heap >
+    type,
+    typename std::enable_if< inline_nonclass_alloc< T >::value &&
+                             Type::heap_backed< type >::value >::type >
+: public RingBufferBaseHeap< T, type >
 {
 public:
-   RingBufferBase() : RingBufferBaseHeap< T, Type::Heap >()
+   RingBufferBase() : RingBufferBaseHeap< T, type >()
    {
    }
 
    virtual ~RingBufferBase() = default;
 
+   /** makes the local_* calls directly, see channel.hpp **/
+   template < class, Type::RingBufferType > friend class raft::channel;
+
    virtual void deallocate()
    {
       /**
@@ -70,12 +75,10 @@ public:
          return;
       }
       /** should be the end of the write, regardless of which allocate called **/
-      auto * const buff_ptr( (this)->datamanager.get() );
-      const size_t write_index( Pointer::val( buff_ptr->write_pt ) );
-      buff_ptr->signal[ write_index ] = signal;
+      (this)->write_signal( signal );
       (this)->producer_data.write_stats->bec.count++;
       (this)->producer_data.allocate_called = false;
-      Pointer::inc( buff_ptr->write_pt );
+      (this)->commit_write( 1 );
       (this)->datamanager.exitBuffer( dm::allocate );
    }
 
@@ -92,12 +95,10 @@ public:
         return;
       }
       /** should be the end of the write, regardless of which allocate called **/
-      const size_t write_index( Pointer::val( (this)->datamanager.get()->write_pt ) );
-      (this)->datamanager.get()->signal[ write_index ] = signal;
+      (this)->write_signal( signal );
       /* only need to inc one more **/
       auto &n_allocated( (this)->producer_data.n_allocated );
-      Pointer::incBy( (this)->datamanager.get()->write_pt,
-                      n_allocated );
+      (this)->commit_write( n_allocated );
       (this)->producer_data.write_stats->bec.count += n_allocated;
       (this)->producer_data.allocate_called = false;
       n_allocated     = 0;
@@ -125,30 +126,31 @@ protected:
          return;
       }
       do{ /** at least one to remove **/
+         auto wait( (this)->consumer_backoff() );
          for( ;; )
          {
             (this)->datamanager.enterBuffer( dm::recycle );
             if( (this)->datamanager.notResizing() )
             {
-               if( (this)->size() > 0 )
+               if( (this)->local_size( 1 ) )
                {
                   break;
                }
-               else if( (this)->is_invalid() && (this)->size() == 0 )
+               else if( (this)->is_invalid() && (this)->local_used() == 0 )
                {
                   (this)->datamanager.exitBuffer( dm::recycle );
                   return;
                }
             }
             (this)->datamanager.exitBuffer( dm::recycle );
-            raft::yield();
+            (this)->consumer_wait( wait, 1 );
          }
-         auto * const buff_ptr( (this)->datamanager.get() );
          /**
           * TODO, this whole func can be optimized a bit more
           * using the incBy func of Pointer
           */
-         Pointer::inc( buff_ptr->read_pt );
+         (this)->take_signal();
+         (this)->commit_read( 1 );
          (this)->datamanager.exitBuffer( dm::recycle );
       }while( --range > 0 );
       return;
@@ -165,10 +167,11 @@ protected:
     */
    virtual void local_allocate( void **ptr )
    {
+      auto wait( (this)->producer_backoff() );
       for(;;)
       {
          (this)->datamanager.enterBuffer( dm::allocate );
-         if( (this)->datamanager.notResizing() && (this)->space_avail() > 0  )
+         if( (this)->datamanager.notResizing() && (this)->local_space_avail( 1 )  )
          {
             break;
          }
@@ -179,17 +182,10 @@ protected:
          {
             wr_stats = 1;
          }
-#if __x86_64
-         __asm__ volatile("\
-           pause"
-           :
-           :
-           : );
-#endif
-         raft::yield();
+         (this)->producer_wait( wait, 1 );
       }
       auto * const buff_ptr( (this)->datamanager.get() );
-      const size_t write_index( Pointer::val( buff_ptr->write_pt ) );
+      const size_t write_index( (this)->write_index() );
       *ptr = (void*)&( buff_ptr->store[ write_index ] );
       (this)->producer_data.allocate_called = true;
       /** call exitBuffer during push call **/
@@ -197,10 +193,11 @@ protected:
 
    virtual void local_allocate_n( void *ptr, const std::size_t n )
    {
+      auto wait( (this)->producer_backoff() );
       for( ;; )
       {
          (this)->datamanager.enterBuffer( dm::allocate_range );
-         if( (this)->datamanager.notResizing() && (this)->space_avail() >= n )
+         if( (this)->datamanager.notResizing() && (this)->local_space_avail( n ) )
          {
             break;
          }
@@ -221,14 +218,7 @@ protected:
          {
             wr_stats = 1;
          }
-#if __x86_64
-       __asm__ volatile("\
-         pause"
-         :
-         :
-         : );
-#endif
-         raft::yield();
+         (this)->producer_wait( wait, n );
       }
       auto *container(
          reinterpret_cast< std::vector< std::reference_wrapper< T > >* >( ptr ) );
@@ -238,7 +228,7 @@ protected:
        */
       /** iterate over range, pause if not enough items **/
       auto * const buff_ptr( (this)->datamanager.get() );
-      std::size_t write_index( Pointer::val( buff_ptr->write_pt ) );
+      std::size_t write_index( (this)->write_index() );
       for( std::size_t index( 0 ); index < n; index++ )
       {
          /**
@@ -246,7 +236,6 @@ protected:
           * not here
           */
          container->emplace_back( buff_ptr->store[ write_index ] );
-         buff_ptr->signal[ write_index ] = raft::none;
          write_index = ( write_index + 1 ) % buff_ptr->max_cap;
       }
       (this)->producer_data.n_allocated = 
@@ -269,12 +258,13 @@ protected:
     */
    virtual void  local_push( void *ptr, const raft::signal &signal )
    {
+      auto wait( (this)->producer_backoff() );
       for(;;)
       {
          (this)->datamanager.enterBuffer( dm::push );
          if( (this)->datamanager.notResizing() )
          {
-            if( (this)->space_avail() > 0 )
+            if( (this)->local_space_avail( 1 ) )
             {
                break;
             }
@@ -286,25 +276,18 @@ protected:
          {
             wr_stats = 1;
          }
-#if __x86_64
-         __asm__ volatile("\
-           pause"
-           :
-           :
-           : );
-#endif
-         raft::yield();
+         (this)->producer_wait( wait, 1 );
       }
       auto * const buff_ptr( (this)->datamanager.get() );
-       const size_t write_index( Pointer::val( buff_ptr->write_pt ) );
+       const size_t write_index( (this)->write_index() );
       if( ptr != nullptr )
       {
          T *item( reinterpret_cast< T* >( ptr ) );
           buff_ptr->store[ write_index ]          = *item;
           (this)->producer_data.write_stats->bec.count++;
        }
-      buff_ptr->signal[ write_index ]         = signal;
-       Pointer::inc( buff_ptr->write_pt );
+      (this)->write_signal( signal );
+       (this)->commit_write( 1 );
 #if 0       
       if( signal == raft::quit )
       {
@@ -324,38 +307,37 @@ protected:
    virtual void
    local_pop( void *ptr, raft::signal *signal )
    {
+      auto wait( (this)->consumer_backoff() );
       for(;;)
       {
          (this)->datamanager.enterBuffer( dm::pop );
          if( (this)->datamanager.notResizing() )
          {
-            if( (this)->size() > 0 )
+            if( (this)->local_size( 1 ) )
             {
                break;
             }
-            else if( (this)->is_invalid() && (this)->size() == 0 )
+            else if( (this)->is_invalid() && (this)->local_used() == 0 )
             {
                throw ClosedPortAccessException(
                   "Accessing closed port with pop call, exiting!!" );
             }
          }
-         else
+         (this)->datamanager.exitBuffer( dm::pop );
+         /** handle stats **/
+         auto &rd_stats( (this)->consumer_data.read_stats->bec.blocked );
+         if( rd_stats == 0 )
          {
-            (this)->datamanager.exitBuffer( dm::pop );
-            /** handle stats **/
-            auto &rd_stats( (this)->consumer_data.read_stats->bec.blocked );
-            if( rd_stats == 0 )
-            {
-               rd_stats  = 1;
-            }
+            rd_stats  = 1;
          }
-         raft::yield();
+         (this)->consumer_wait( wait, 1 );
       }
       auto * const buff_ptr( (this)->datamanager.get() );
-      const std::size_t read_index( Pointer::val( buff_ptr->read_pt ) );
+      const std::size_t read_index( (this)->read_index() );
+      const auto sig( (this)->take_signal() );
       if( signal != nullptr )
       {
-         *signal = buff_ptr->signal[ read_index ];
+         *signal = sig;
       }
       assert( ptr != nullptr );
       /** gotta dereference pointer and copy **/
@@ -363,8 +345,64 @@ protected:
       *item = buff_ptr->store[ read_index ];
       /** only increment here b/c we're actually reading an item **/
       (this)->consumer_data.read_stats->bec.count++;
-      Pointer::inc( buff_ptr->read_pt );
+      (this)->commit_read( 1 );
+      (this)->datamanager.exitBuffer( dm::pop );
+   }
+
+   /**
+    * try_push - local_push without the wait loop, small enough
+    * to be inlined into a caller that knows T (see channel.hpp).
+    * Leaves the ring as it was and returns false if it's full
+    * or being resized, the caller goes through local_push then.
+    * @param   item - const T&
+    * @param   signal - const raft::signal
+    * @return  bool - true if the item is on the ring
+    */
+   bool try_push( const T &item, const raft::signal signal ) noexcept
+   {
+      (this)->datamanager.enterBuffer( dm::push );
+      if( R_UNLIKELY( ! (this)->datamanager.notResizing() ||
+                      ! (this)->local_space_avail( 1 ) ) )
+      {
+         (this)->datamanager.exitBuffer( dm::push );
+         return( false );
+      }
+      (this)->datamanager.get()->store[ (this)->write_index() ] = item;
+      (this)->producer_data.write_stats->bec.count++;
+      (this)->write_signal( signal );
+      (this)->commit_write( 1 );
+      (this)->datamanager.exitBuffer( dm::push );
+      return( true );
+   }
+
+   /**
+    * try_pop - local_pop without the wait loop, returns false
+    * if the ring is empty or being resized, the caller goes
+    * through local_pop then (which also throws once the port
+    * is closed).
+    * @param   item - T&
+    * @param   signal - raft::signal*, nullptr if not wanted
+    * @return  bool - true if item was set
+    */
+   bool try_pop( T &item, raft::signal *signal )
+   {
+      (this)->datamanager.enterBuffer( dm::pop );
+      if( R_UNLIKELY( ! (this)->datamanager.notResizing() ||
+                      ! (this)->local_size( 1 ) ) )
+      {
+         (this)->datamanager.exitBuffer( dm::pop );
+         return( false );
+      }
+      const auto sig( (this)->take_signal() );
+      if( signal != nullptr )
+      {
+         *signal = sig;
+      }
+      item = (this)->datamanager.get()->store[ (this)->read_index() ];
+      (this)->consumer_data.read_stats->bec.count++;
+      (this)->commit_read( 1 );
       (this)->datamanager.exitBuffer( dm::pop );
+      return( true );
    }
 
 
@@ -377,37 +415,31 @@ protected:
     */
    virtual void local_peek(  void **ptr, raft::signal *signal )
    {
+      auto wait( (this)->consumer_backoff() );
       for(;;)
       {
 
          (this)->datamanager.enterBuffer( dm::peek );
          if( (this)->datamanager.notResizing() )
          {
-            if( (this)->size() > 0  )
+            if( (this)->local_size( 1 ) )
             {
                break;
             }
-            else if( (this)->is_invalid() && (this)->size() == 0 )
+            else if( (this)->is_invalid() && (this)->local_used() == 0 )
             {
                throw ClosedPortAccessException(
                   "Accessing closed port with local_peek call, exiting!!" );
             }
          }
          (this)->datamanager.exitBuffer( dm::peek );
-#if  __x86_64
-         __asm__ volatile("\
-           pause"
-           :
-           :
-           : );
-#endif
-         raft::yield();
+         (this)->consumer_wait( wait, 1 );
       }
       auto * const buff_ptr( (this)->datamanager.get() );
-      const auto read_index( Pointer::val( buff_ptr->read_pt ) );
+      const auto read_index( (this)->read_index() );
       if( signal != nullptr )
       {
-         *signal = buff_ptr->signal[ read_index ];
+         *signal = (this)->read_signal();
       }
       *ptr = reinterpret_cast< void* >( &( buff_ptr->store[ read_index ] ) );
       return;
@@ -421,37 +453,32 @@ protected:
    virtual void local_peek_range( void **ptr,
                                   void **sig,
                                   const std::size_t n,
-                                  std::size_t &curr_pointer_loc )
+                                  std::size_t &curr_pointer_loc ,
+                                  std::size_t &queue_size )
    {
+      auto wait( (this)->consumer_backoff() );
       for(;;)
       {
 
          (this)->datamanager.enterBuffer( dm::peek );
          if( (this)->datamanager.notResizing() )
          {
-            if( (this)->size() >= n  )
+            if( (this)->local_size( n ) )
             {
                break;
             }
-            else if( (this)->is_invalid() && (this)->size() == 0 )
+            else if( (this)->is_invalid() && (this)->local_used() == 0 )
             {
                throw ClosedPortAccessException(
                   "Accessing closed port with local_peek_range call, exiting!!" );
             }
-            else if( (this)->is_invalid() && (this)->size() < n )
+            else if( (this)->is_invalid() && (this)->local_used() < n )
             {
                throw NoMoreDataException( "Too few items left on closed port, kernel exiting" );
             }
          }
          (this)->datamanager.exitBuffer( dm::peek );
-#if  __x86_64
-         __asm__ volatile("\
-           pause"
-           :
-           :
-           : );
-#endif
-          raft::yield();
+         (this)->consumer_wait( wait, n );
       }
 
       /**
@@ -460,9 +487,11 @@ protected:
        */
       /** iterate over range, pause if not enough items **/
       auto * const buff_ptr( (this)->datamanager.get() );
-      const std::size_t cpl( Pointer::val( buff_ptr->read_pt ) );
+      const std::size_t cpl( (this)->read_index() );
       curr_pointer_loc = cpl;
-      *sig =  reinterpret_cast< void* >(  &buff_ptr->signal[ cpl ] );
+      queue_size       = buff_ptr->max_cap;
+      /** indexed from crp by the autorelease, hand out the base **/
+      *sig =  reinterpret_cast< void* >( (this)->peek_signals( n ) );
       *ptr =  buff_ptr->store;
       return;
    }
@@ -473,24 +502,28 @@ protected:
  * INLINE CLASS ALLOC STARTS HERE
  *********************************/
 
-template < class T >
+template < class T, Type::RingBufferType type >
 class RingBufferBase<
     T,
-    Type::Heap,
-    typename std::enable_if< inline_class_alloc< T >::value >::type >
-: public RingBufferBaseHeap< T, Type::Heap >
+    type,
+    typename std::enable_if< inline_class_alloc< T >::value &&
+                             Type::heap_backed< type >::value >::type >
+: public RingBufferBaseHeap< T, type >
 {
 public:
-   RingBufferBase() : RingBufferBaseHeap< T, Type::Heap >()
+   RingBufferBase() : RingBufferBaseHeap< T, type >()
    {
    }
 
    virtual ~RingBufferBase() = default;
 
+   /** makes the local_* calls directly, see channel.hpp **/
+   template < class, Type::RingBufferType > friend class raft::channel;
+
    virtual void deallocate()
    {
       auto * const buff_ptr( (this)->datamanager.get() );
-      const auto read_index( Pointer::val( buff_ptr->read_pt ) );
+      const auto read_index( (this)->read_index() );
       auto * const ptr = reinterpret_cast< T* >( &( buff_ptr->store[ read_index ] ) );
       /** destruct **/
       ptr->~T();
@@ -511,12 +544,10 @@ public:
            return;
         }
         /** should be the end of the write, regardless of which allocate called **/
-        auto * const buff_ptr( (this)->datamanager.get() );
-        const size_t write_index( Pointer::val( buff_ptr->write_pt ) );
-        buff_ptr->signal[ write_index ] = signal;
+        (this)->write_signal( signal );
         (this)->producer_data.write_stats->bec.count++;
         (this)->producer_data.allocate_called = false;
-        Pointer::inc( buff_ptr->write_pt );
+        (this)->commit_write( 1 );
         (this)->datamanager.exitBuffer( dm::allocate );
     }
 
@@ -532,14 +563,11 @@ public:
         {
             return;
         }
-        auto * const buff_ptr( (this)->datamanager.get() );
         /** should be the end of the write, regardless of which allocate called **/
-        const size_t write_index( Pointer::val( buff_ptr->write_pt ) );
-        buff_ptr->signal[ write_index ] = signal;
+        (this)->write_signal( signal );
         /* only need to inc one more, the rest have already**/
         auto &n_allocated( (this)->producer_data.n_allocated );
-        Pointer::incBy( buff_ptr->write_pt,
-                        n_allocated );
+        (this)->commit_write( n_allocated );
         
         (this)->producer_data.write_stats->bec.count += n_allocated;
         /** cleanup **/
@@ -568,31 +596,33 @@ protected:
          return;
       }
       do{ /** at least one to remove **/
+         auto wait( (this)->consumer_backoff() );
          for( ;; )
          {
             (this)->datamanager.enterBuffer( dm::recycle );
             if( (this)->datamanager.notResizing() )
             {
-               if( (this)->size() > 0 )
+               if( (this)->local_size( 1 ) )
                {
                   break;
                }
-               else if( (this)->is_invalid() && (this)->size() == 0 )
+               else if( (this)->is_invalid() && (this)->local_used() == 0 )
                {
                   (this)->datamanager.exitBuffer( dm::recycle );
                   return;
                }
             }
             (this)->datamanager.exitBuffer( dm::recycle );
-            raft::yield();
+            (this)->consumer_wait( wait, 1 );
          }
          auto * const buff_ptr( (this)->datamanager.get() );
-         const size_t read_index( Pointer::val( buff_ptr->read_pt ) );
+         const size_t read_index( (this)->read_index() );
          auto *ptr =
             reinterpret_cast< T* >( &( buff_ptr->store[ read_index ] ) );
          /** call destructor direct, faster than recyle func **/
          ptr->~T();
-         Pointer::inc( buff_ptr->read_pt );
+         (this)->take_signal();
+         (this)->commit_read( 1 );
          (this)->datamanager.exitBuffer( dm::recycle );
       }while( --range > 0 );
       return;
@@ -609,10 +639,11 @@ protected:
     */
    virtual void local_allocate( void **ptr )
    {
+      auto wait( (this)->producer_backoff() );
       for(;;)
       {
          (this)->datamanager.enterBuffer( dm::allocate );
-         if( (this)->datamanager.notResizing() && (this)->space_avail() > 0  )
+         if( (this)->datamanager.notResizing() && (this)->local_space_avail( 1 )  )
          {
             break;
          }
@@ -623,17 +654,10 @@ protected:
          {
             wr_stats = 1;
          }
-#if __x86_64
-         __asm__ volatile("\
-           pause"
-           :
-           :
-           : );
-#endif
-         raft::yield();
+         (this)->producer_wait( wait, 1 );
       }
       auto * const buff_ptr( (this)->datamanager.get() );
-      const size_t write_index( Pointer::val( buff_ptr->write_pt ) );
+      const size_t write_index( (this)->write_index() );
       *ptr = (void*)&( buff_ptr->store[ write_index ] );
       (this)->producer_data.allocate_called = true;
       /** call exitBuffer during push call **/
@@ -641,10 +665,11 @@ protected:
 
    virtual void local_allocate_n( void *ptr, const std::size_t n )
    {
+      auto wait( (this)->producer_backoff() );
       for( ;; )
       {
          (this)->datamanager.enterBuffer( dm::allocate_range );
-         if( (this)->datamanager.notResizing() && (this)->space_avail() >= n )
+         if( (this)->datamanager.notResizing() && (this)->local_space_avail( n ) )
          {
             break;
          }
@@ -655,14 +680,7 @@ protected:
          {
             wr_stats = 1;
          }
-#if __x86_64
-       __asm__ volatile("\
-         pause"
-         :
-         :
-         : );
-#endif
-         raft::yield();
+         (this)->producer_wait( wait, n );
       }
       auto *container(
          reinterpret_cast< std::vector< std::reference_wrapper< T > >* >( ptr ) );
@@ -672,7 +690,7 @@ protected:
        */
       /** iterate over range, pause if not enough items **/
       auto * const buff_ptr( (this)->datamanager.get() );
-      std::size_t write_index( Pointer::val( buff_ptr->write_pt ) );
+      std::size_t write_index( (this)->write_index() );
       for( std::size_t index( 0 ); index < n; index++ )
       {
          /**
@@ -680,7 +698,6 @@ protected:
           * not here
           */
          container->emplace_back( buff_ptr->store[ write_index ] );
-         buff_ptr->signal[ write_index ] = raft::none;
          write_index = ( write_index + 1 ) % buff_ptr->max_cap;
       }
       (this)->producer_data.n_allocated = 
@@ -703,12 +720,28 @@ protected:
     */
    virtual void  local_push( void *ptr, const raft::signal &signal )
    {
+      push_item< false >( ptr, signal );
+   }
+
+   /**
+    * local_push_move - same as local_push but the item is
+    * moved into the slot rather than copied.
+    */
+   virtual void  local_push_move( void *ptr, const raft::signal &signal )
+   {
+      push_item< true >( ptr, signal );
+   }
+
+   template < bool move >
+   void  push_item( void *ptr, const raft::signal &signal )
+   {
+      auto wait( (this)->producer_backoff() );
       for(;;)
       {
          (this)->datamanager.enterBuffer( dm::push );
          if( (this)->datamanager.notResizing() )
          {
-            if( (this)->space_avail() > 0 )
+            if( (this)->local_space_avail( 1 ) )
             {
                break;
             }
@@ -720,27 +753,25 @@ protected:
          {
             wr_stats = 1;
          }
-#if __x86_64
-         __asm__ volatile("\
-           pause"
-           :
-           :
-           : );
-#endif
-         raft::yield();
+         (this)->producer_wait( wait, 1 );
       }
       auto * const buff_ptr( (this)->datamanager.get() );
-       const size_t write_index( Pointer::val( buff_ptr->write_pt ) );
+       const size_t write_index( (this)->write_index() );
       if( ptr != nullptr )
       {
           T *item( reinterpret_cast< T* >( ptr ) );
-          new (
-            &buff_ptr->store[ write_index ]
-          ) T( *item  );
+          if( move )
+          {
+             new ( &buff_ptr->store[ write_index ] ) T( std::move( *item ) );
+          }
+          else
+          {
+             new ( &buff_ptr->store[ write_index ] ) T( *item );
+          }
           (this)->producer_data.write_stats->bec.count++;
        }
-      buff_ptr->signal[ write_index ]         = signal;
-       Pointer::inc( buff_ptr->write_pt );
+      (this)->write_signal( signal );
+       (this)->commit_write( 1 );
       (this)->datamanager.exitBuffer( dm::push );
    }
 
@@ -754,43 +785,42 @@ protected:
    virtual void
    local_pop( void *ptr, raft::signal *signal )
    {
+      auto wait( (this)->consumer_backoff() );
       for(;;)
       {
          (this)->datamanager.enterBuffer( dm::pop );
          if( (this)->datamanager.notResizing() )
          {
-            if( (this)->size() > 0 )
+            if( (this)->local_size( 1 ) )
             {
                break;
             }
-            else if( (this)->is_invalid() && (this)->size() == 0 )
+            else if( (this)->is_invalid() && (this)->local_used() == 0 )
             {
                throw ClosedPortAccessException(
                   "Accessing closed port with pop call, exiting!!" );
             }
          }
-         else
+         (this)->datamanager.exitBuffer( dm::pop );
+         /** handle stats **/
+         auto &rd_stats( (this)->consumer_data.read_stats->bec.blocked );
+         if( rd_stats == 0 )
          {
-            (this)->datamanager.exitBuffer( dm::pop );
-            /** handle stats **/
-            auto &rd_stats( (this)->consumer_data.read_stats->bec.blocked );
-            if( rd_stats == 0 )
-            {
-               rd_stats  = 1;
-            }
-            raft::yield();
+            rd_stats  = 1;
          }
+         (this)->consumer_wait( wait, 1 );
       }
       auto * const buff_ptr( (this)->datamanager.get() );
-      const std::size_t read_index( Pointer::val( buff_ptr->read_pt ) );
+      const std::size_t read_index( (this)->read_index() );
+      const auto sig( (this)->take_signal() );
       if( signal != nullptr )
       {
-         *signal = buff_ptr->signal[ read_index ];
+         *signal = sig;
       }
       assert( ptr != nullptr );
       /** gotta dereference pointer and copy **/
       T *item( reinterpret_cast< T* >( ptr ) );
-      *item = buff_ptr->store[ read_index ];
+      *item = std::move( buff_ptr->store[ read_index ] );
       /** 
        * we know the object is inline constructed, 
        * we should inline destruct it to fix bug
@@ -800,7 +830,7 @@ protected:
       ( &buff_ptr->store[ read_index ] )->~T();
       /** only increment here b/c we're actually reading an item **/
       (this)->consumer_data.read_stats->bec.count++;
-      Pointer::inc( buff_ptr->read_pt );
+      (this)->commit_read( 1 );
       (this)->datamanager.exitBuffer( dm::pop );
    }
 
@@ -814,37 +844,31 @@ protected:
     */
    virtual void local_peek(  void **ptr, raft::signal *signal )
    {
+      auto wait( (this)->consumer_backoff() );
       for(;;)
       {
 
          (this)->datamanager.enterBuffer( dm::peek );
          if( (this)->datamanager.notResizing() )
          {
-            if( (this)->size() > 0  )
+            if( (this)->local_size( 1 ) )
             {
                break;
             }
-            else if( (this)->is_invalid() && (this)->size() == 0 )
+            else if( (this)->is_invalid() && (this)->local_used() == 0 )
             {
                throw ClosedPortAccessException(
                   "Accessing closed port with local_peek call, exiting!!" );
             }
          }
          (this)->datamanager.exitBuffer( dm::peek );
-#if  __x86_64
-         __asm__ volatile("\
-           pause"
-           :
-           :
-           : );
-#endif
-         raft::yield();
+         (this)->consumer_wait( wait, 1 );
       }
       auto * const buff_ptr( (this)->datamanager.get() );
-      const size_t read_index( Pointer::val( buff_ptr->read_pt ) );
+      const size_t read_index( (this)->read_index() );
       if( signal != nullptr )
       {
-         *signal = buff_ptr->signal[ read_index ];
+         *signal = (this)->read_signal();
       }
       *ptr = (void*) &( buff_ptr->store[ read_index ] );
       return;
@@ -858,37 +882,32 @@ protected:
    virtual void local_peek_range( void **ptr,
                                   void **sig,
                                   const std::size_t n,
-                                  std::size_t &curr_pointer_loc )
+                                  std::size_t &curr_pointer_loc ,
+                                  std::size_t &queue_size )
    {
+      auto wait( (this)->consumer_backoff() );
       for(;;)
       {
 
          (this)->datamanager.enterBuffer( dm::peek );
          if( (this)->datamanager.notResizing() )
          {
-            if( (this)->size() >= n  )
+            if( (this)->local_size( n ) )
             {
                break;
             }
-            else if( (this)->is_invalid() && (this)->size() == 0 )
+            else if( (this)->is_invalid() && (this)->local_used() == 0 )
             {
                throw ClosedPortAccessException(
                   "Accessing closed port with local_peek_range call, exiting!!" );
             }
-            else if( (this)->is_invalid() && (this)->size() < n )
+            else if( (this)->is_invalid() && (this)->local_used() < n )
             {
                throw NoMoreDataException( "Too few items left on closed port, kernel exiting" );
             }
          }
          (this)->datamanager.exitBuffer( dm::peek );
-#if  __x86_64
-         __asm__ volatile("\
-           pause"
-           :
-           :
-           : );
-#endif
-         raft::yield();
+         (this)->consumer_wait( wait, n );
       }
 
       /**
@@ -897,9 +916,11 @@ protected:
        */
       /** iterate over range, pause if not enough items **/
       auto * const buff_ptr( (this)->datamanager.get() );
-      const auto cpl( Pointer::val( buff_ptr->read_pt ) );
+      const auto cpl( (this)->read_index() );
       curr_pointer_loc = cpl;
-      *sig =  reinterpret_cast< void* >(  &buff_ptr->signal[ cpl ] );
+      queue_size       = buff_ptr->max_cap;
+      /** indexed from crp by the autorelease, hand out the base **/
+      *sig =  reinterpret_cast< void* >( (this)->peek_signals( n ) );
       *ptr =  buff_ptr->store;
       return;
    }
@@ -910,34 +931,37 @@ protected:
  *EXTERNAL ALLOCATE STARTS HERE
  **************************************/
 
-template < class T >
+template < class T, Type::RingBufferType type >
 class RingBufferBase<
     T,
-    Type::Heap,
-    typename std::enable_if< ext_alloc< T >::value >::type >
-: public RingBufferBaseHeap< T, Type::Heap >
+    type,
+    typename std::enable_if< ext_alloc< T >::value &&
+                             Type::heap_backed< type >::value >::type >
+: public RingBufferBaseHeap< T, type >
 {
 public:
-   RingBufferBase() : RingBufferBaseHeap< T, Type::Heap >()
+   RingBufferBase() : RingBufferBaseHeap< T, type >()
    {
    }
 
    virtual ~RingBufferBase() = default;
 
+   /** makes the local_* calls directly, see channel.hpp **/
+   template < class, Type::RingBufferType > friend class raft::channel;
+
    virtual void deallocate()
    {
       auto * const buff_ptr( (this)->datamanager.get() );
-      const size_t write_index( Pointer::val( buff_ptr->write_pt ) );
+      const size_t write_index( (this)->write_index() );
       auto *ptr(
         reinterpret_cast< T* >( buff_ptr->store[ write_index ] )
       );
-      /** call local delete on obj **/
       /** 
        * bugfix for issue #37, memory leak, copy paste
        * error resulted in destructor being called, but
        * no deallocate. - jcb 15 July 2017
        */
-      delete( ptr );
+      raft::slab_pool< T >::destroy( ptr );
       (this)->producer_data.allocate_called = false;
       (this)->datamanager.exitBuffer( dm::allocate );
    }
@@ -955,12 +979,10 @@ public:
          return;
       }
       /** should be the end of the write, regardless of which allocate called **/
-      auto * const buff_ptr( (this)->datamanager.get() );
-      const size_t write_index( Pointer::val( buff_ptr->write_pt ) );
-      buff_ptr->signal[ write_index ] = signal;
+      (this)->write_signal( signal );
       (this)->producer_data.write_stats->bec.count++;
       (this)->producer_data.allocate_called = false;
-      Pointer::inc( buff_ptr->write_pt );
+      (this)->commit_write( 1 );
       (this)->datamanager.exitBuffer( dm::allocate );
    }
 
@@ -974,11 +996,9 @@ public:
    {
       if( ! (this)->producer_data.allocate_called ) return;
       /** should be the end of the write, regardless of which allocate called **/
-      const size_t write_index( Pointer::val( (this)->datamanager.get()->write_pt ) );
-      (this)->datamanager.get()->signal[ write_index ] = signal;
+      (this)->write_signal( signal );
       auto &n_allocated( (this)->producer_data.n_allocated );
-      Pointer::incBy( (this)->datamanager.get()->write_pt,
-                      n_allocated );
+      (this)->commit_write( n_allocated );
       /** cleanup **/
       (this)->producer_data.write_stats->bec.count += n_allocated;
       (this)->producer_data.allocate_called = false;
@@ -1006,45 +1026,36 @@ protected:
          return;
       }
       do{ /** at least one to remove **/
+         auto wait( (this)->consumer_backoff() );
          for( ;; )
          {
             (this)->datamanager.enterBuffer( dm::recycle );
             if( (this)->datamanager.notResizing() )
             {
-               if( (this)->size() > 0 )
+               if( (this)->local_size( 1 ) )
                {
                   break;
                }
-               else if( (this)->is_invalid() && (this)->size() == 0 )
+               else if( (this)->is_invalid() && (this)->local_used() == 0 )
                {
                   (this)->datamanager.exitBuffer( dm::recycle );
                   return;
                }
             }
             (this)->datamanager.exitBuffer( dm::recycle );
-            raft::yield();
+            (this)->consumer_wait( wait, 1 );
          }
          auto * const buff_ptr( (this)->datamanager.get() );
-         const size_t read_index( Pointer::val( buff_ptr->read_pt ) );
+         const size_t read_index( (this)->read_index() );
 
          auto **ptr( reinterpret_cast< void** >( &( buff_ptr->store[ read_index ] ) )
          );
 
-         (this)->consumer_data.in->insert(
-            std::make_pair( reinterpret_cast< std::uintptr_t >( *ptr ),
-                            []( void * ptr )
-                            {
-                                auto *actual_ptr(
-                                    reinterpret_cast< T* >( ptr )
-                                );
-                                /** 
-                                 * bugfix for issue #37, memory leak, copy paste
-                                 * error resulted in destructor being called, but
-                                 * no deallocate. - jcb 15 July 2017
-                                 */
-                                delete( actual_ptr );
-                            } ) );
-         Pointer::inc( buff_ptr->read_pt );
+         (this)->consumer_data.in->emplace_back( 
+            reinterpret_cast< std::uintptr_t >( *ptr ),
+            &raft::slab_pool< T >::reclaim );
+         (this)->take_signal();
+         (this)->commit_read( 1 );
          (this)->datamanager.exitBuffer( dm::recycle );
       }while( --range > 0 );
       return;
@@ -1061,10 +1072,11 @@ protected:
     */
    virtual void local_allocate( void **ptr )
    {
+      auto wait( (this)->producer_backoff() );
       for(;;)
       {
          (this)->datamanager.enterBuffer( dm::allocate );
-         if( (this)->datamanager.notResizing() && (this)->space_avail() > 0  )
+         if( (this)->datamanager.notResizing() && (this)->local_space_avail( 1 )  )
          {
             break;
          }
@@ -1075,17 +1087,10 @@ protected:
          {
             wr_stats = 1;
          }
-#if __x86_64
-         __asm__ volatile("\
-           pause"
-           :
-           :
-           : );
-#endif
-         raft::yield();
+         (this)->producer_wait( wait, 1 );
       }
       auto * const buff_ptr( (this)->datamanager.get() );
-      const size_t write_index( Pointer::val( buff_ptr->write_pt ) );
+      const size_t write_index( (this)->write_index() );
       *ptr = (void*)&( buff_ptr->store[ write_index ] );
       (this)->producer_data.allocate_called = true;
       /** call exitBuffer during push call **/
@@ -1093,10 +1098,11 @@ protected:
 
    virtual void local_allocate_n( void *ptr, const std::size_t n )
    {
+      auto wait( (this)->producer_backoff() );
       for( ;; )
       {
          (this)->datamanager.enterBuffer( dm::allocate_range );
-         if( (this)->datamanager.notResizing() && (this)->space_avail() >= n )
+         if( (this)->datamanager.notResizing() && (this)->local_space_avail( n ) )
          {
             break;
          }
@@ -1110,14 +1116,7 @@ protected:
          {
             wr_stats = 1;
          }
-#if __x86_64
-       __asm__ volatile("\
-         pause"
-         :
-         :
-         : );
-#endif
-         raft::yield();
+         (this)->producer_wait( wait, n );
       }
       auto *container(
          reinterpret_cast< std::vector< std::reference_wrapper< T > >* >( ptr ) );
@@ -1127,18 +1126,21 @@ protected:
        */
       /** iterate over range, pause if not enough items **/
       auto * const buff_ptr( (this)->datamanager.get() );
-      std::size_t write_index( Pointer::val( buff_ptr->write_pt ) );
+      std::size_t write_index( (this)->write_index() );
+      container->reserve( container->size() + n );
       for( std::size_t index( 0 ); index < n; index++ )
       {
-         /**
-          * TODO, fix this logic here, write index must get iterated, but
-          * not here
+         /** 
+          * each slot gets an object of its own, as with allocate(),
+          * the consumer hands it back to the pool once it's done
           */
-         container->emplace_back(
-            *reinterpret_cast< T* >( buff_ptr->store[ write_index ] ) );
-         buff_ptr->signal[ write_index ] = raft::none;
+         T * const item( raft::slab_pool< T >::make() );
+         buff_ptr->store[ write_index ] = item;
+         container->emplace_back( *item );
          write_index = ( write_index + 1 ) % buff_ptr->max_cap;
       }
+      (this)->producer_data.n_allocated = 
+        static_cast< decltype( (this)->producer_data.n_allocated ) >( n );
       (this)->producer_data.allocate_called = true;
       /** exitBuffer() called by push_range **/
    }
@@ -1157,12 +1159,28 @@ protected:
     */
    virtual void  local_push( void *ptr, const raft::signal &signal )
    {
+      push_item< false >( ptr, signal );
+   }
+
+   /**
+    * local_push_move - same as local_push but the item is
+    * moved into the slab object rather than copied.
+    */
+   virtual void  local_push_move( void *ptr, const raft::signal &signal )
+   {
+      push_item< true >( ptr, signal );
+   }
+
+   template < bool move >
+   void  push_item( void *ptr, const raft::signal &signal )
+   {
+      auto wait( (this)->producer_backoff() );
       for(;;)
       {
          (this)->datamanager.enterBuffer( dm::push );
          if( (this)->datamanager.notResizing() )
          {
-            if( (this)->space_avail() > 0 )
+            if( (this)->local_space_avail( 1 ) )
             {
                break;
             }
@@ -1173,39 +1191,41 @@ protected:
          {
             wr_stats = 1;
          }
-#if __x86_64
-         __asm__ volatile("\
-           pause"
-           :
-           :
-           : );
-#endif
-         raft::yield();
+         (this)->producer_wait( wait, 1 );
       }
       auto * const buff_ptr( (this)->datamanager.get() );
-       const size_t write_index( Pointer::val( buff_ptr->write_pt ) );
+       const size_t write_index( (this)->write_index() );
       if( ptr != nullptr )
       {
          /** might be faster to simply check stack range for alloc loc **/
          T *item( reinterpret_cast< T* >( ptr ) );
          auto **b_ptr( reinterpret_cast< T** >( &buff_ptr->store[ write_index ] ) );
 
-         if( (this)->producer_data.out_peek->find(
-            reinterpret_cast< std::uintptr_t >( item ) ) != 
-                (this)->producer_data.out_peek->cend() )
+         /** only a handful of peeks per run, linear search is fine **/
+         auto &peeked( *(this)->producer_data.out_peek );
+         if( std::find( peeked.cbegin(), peeked.cend(), 
+                        reinterpret_cast< std::uintptr_t >( item ) ) != 
+                peeked.cend() )
          {
             //this was from a previous peek call
-            (this)->producer_data.out->insert( reinterpret_cast< std::uintptr_t >( item ) );
+            (this)->producer_data.out->push_back( reinterpret_cast< std::uintptr_t >( item ) );
             *b_ptr = item;
          }
          else /** hope we have a move/copy constructor **/
          {
-            *b_ptr = new T( *item );
+            if( move )
+            {
+               *b_ptr = raft::slab_pool< T >::make( std::move( *item ) );
+            }
+            else
+            {
+               *b_ptr = raft::slab_pool< T >::make( *item );
+            }
          }
          (this)->producer_data.write_stats->bec.count++;
        }
-      buff_ptr->signal[ write_index ]         = signal;
-       Pointer::inc( buff_ptr->write_pt );
+      (this)->write_signal( signal );
+       (this)->commit_write( 1 );
 #if 0       
       if( signal == raft::quit )
       {
@@ -1225,51 +1245,52 @@ protected:
    virtual void
    local_pop( void *ptr, raft::signal *signal )
    {
+      auto wait( (this)->consumer_backoff() );
       for(;;)
       {
          (this)->datamanager.enterBuffer( dm::pop );
          if( (this)->datamanager.notResizing() )
          {
-            if( (this)->size() > 0 )
+            if( (this)->local_size( 1 ) )
             {
                break;
             }
-            else if( (this)->is_invalid() && (this)->size() == 0 )
+            else if( (this)->is_invalid() && (this)->local_used() == 0 )
             {
                throw ClosedPortAccessException(
                   "Accessing closed port with pop call, exiting!!" );
             }
          }
-         else
+         (this)->datamanager.exitBuffer( dm::pop );
+         /** handle stats **/
+         auto &rd_stats( (this)->consumer_data.read_stats->bec.blocked );
+         if( rd_stats == 0 )
          {
-            (this)->datamanager.exitBuffer( dm::pop );
-            /** handle stats **/
-            auto &rd_stats( (this)->consumer_data.read_stats->bec.blocked );
-            if( rd_stats == 0 )
-            {
-               rd_stats  = 1;
-            }
-            raft::yield();
+            rd_stats  = 1;
          }
+         (this)->consumer_wait( wait, 1 );
       }
       auto * const buff_ptr( (this)->datamanager.get() );
-      const std::size_t read_index( Pointer::val( buff_ptr->read_pt ) );
+      const std::size_t read_index( (this)->read_index() );
+      const auto sig( (this)->take_signal() );
       if( signal != nullptr )
       {
-         *signal = buff_ptr->signal[ read_index ];
+         *signal = sig;
       }
       assert( ptr != nullptr );
       /** gotta dereference pointer and copy **/
       T *item( reinterpret_cast< T* >( ptr ) );
       auto *head( reinterpret_cast< T* >( buff_ptr->store[ read_index ] ) );
-      *item = *head;
+      /** the slab object is destroyed below, nothing else sees it **/
+      *item = std::move( *head );
       /** only increment here b/c we're actually reading an item **/
       (this)->consumer_data.read_stats->bec.count++;
-      Pointer::inc( buff_ptr->read_pt );
+      (this)->commit_read( 1 );
       /**
-       * fix for bug #76 - jcb 18Nov2018
+       * fix for bug #76 - jcb 18Nov2018, the slot goes
+       * back to the pool along with the destructor call.
        */
-      head->~T();
+      raft::slab_pool< T >::destroy( head );
       (this)->datamanager.exitBuffer( dm::pop );
    }
 
@@ -1283,37 +1304,31 @@ protected:
     */
    virtual void local_peek(  void **ptr, raft::signal *signal )
    {
+      auto wait( (this)->consumer_backoff() );
       for(;;)
       {
 
          (this)->datamanager.enterBuffer( dm::peek );
          if( (this)->datamanager.notResizing() )
          {
-            if( (this)->size() > 0  )
+            if( (this)->local_size( 1 ) )
             {
                break;
             }
-            else if( (this)->is_invalid() && (this)->size() == 0 )
+            else if( (this)->is_invalid() && (this)->local_used() == 0 )
             {
                throw ClosedPortAccessException(
                   "Accessing closed port with local_peek call, exiting!!" );
             }
          }
          (this)->datamanager.exitBuffer( dm::peek );
-#if  __x86_64
-         __asm__ volatile("\
-           pause"
-           :
-           :
-           : );
-#endif
-         raft::yield();
+         (this)->consumer_wait( wait, 1 );
       }
       auto * const buff_ptr( (this)->datamanager.get() );
-      const size_t read_index( Pointer::val( buff_ptr->read_pt ) );
+      const size_t read_index( (this)->read_index() );
       if( signal != nullptr )
       {
-         *signal = buff_ptr->signal[ read_index ];
+         *signal = (this)->read_signal();
       }
       //actual pointer
       auto ***real_ptr( reinterpret_cast< T*** >( ptr ) );
@@ -1326,7 +1341,7 @@ protected:
                       sizeof( T ) < sizeof( std::uintptr_t ) << 7 ?
                       sizeof( T ) : sizeof( std::uintptr_t ) << 7
                       >( **real_ptr );
-      (this)->consumer_data.in_peek->insert( reinterpret_cast< ptr_t >( **real_ptr ) );
+      (this)->consumer_data.in_peek->push_back( reinterpret_cast< ptr_t >( **real_ptr ) );
       return;
       /**
        * exitBuffer() called when recycle is called, can't be sure the
@@ -1338,39 +1353,34 @@ protected:
    virtual void local_peek_range( void **ptr,
                                   void **sig,
                                   const std::size_t n,
-                                  std::size_t &curr_pointer_loc )
+                                  std::size_t &curr_pointer_loc ,
+                                  std::size_t &queue_size )
    {
+      auto wait( (this)->consumer_backoff() );
       for(;;)
       {
 
          (this)->datamanager.enterBuffer( dm::peek );
          if( (this)->datamanager.notResizing() )
          {
-            if( (this)->size() >= n  )
+            if( (this)->local_size( n ) )
             {
                break;
             }
-            else if( (this)->is_invalid() && (this)->size() == 0 )
+            else if( (this)->is_invalid() && (this)->local_used() == 0 )
             {
                (this)->datamanager.exitBuffer( dm::peek );
                throw ClosedPortAccessException(
                   "Accessing closed port with local_peek_range call, exiting!!" );
             }
-            else if( (this)->is_invalid() && (this)->size() < n )
+            else if( (this)->is_invalid() && (this)->local_used() < n )
             {
                (this)->datamanager.exitBuffer( dm::peek );
                throw NoMoreDataException( "Too few items left on closed port, kernel exiting" );
             }
          }
          (this)->datamanager.exitBuffer( dm::peek );
-#if  __x86_64
-         __asm__ volatile("\
-           pause"
-           :
-           :
-           : );
-#endif
-         raft::yield();
+         (this)->consumer_wait( wait, n );
       }
 
       /**
@@ -1379,9 +1389,21 @@ protected:
        */
       /** iterate over range, pause if not enough items **/
       auto * const buff_ptr( (this)->datamanager.get() );
-      const auto cpl( Pointer::val( buff_ptr->read_pt ) );
+      const auto cpl( (this)->read_index() );
       curr_pointer_loc = cpl;
-      *sig =  reinterpret_cast< void* >(  &buff_ptr->signal[ cpl ] );
+      queue_size       = buff_ptr->max_cap;
+      /** 
+       * peeked, same as local_peek, so that pushing one of these
+       * downstream hands the object over instead of copying it
+       */
+      auto &peeked( *(this)->consumer_data.in_peek );
+      for( std::size_t i( 0 ); i < n; i++ )
+      {
+         peeked.push_back( reinterpret_cast< ptr_t >( 
+            buff_ptr->store[ ( cpl + i ) % buff_ptr->max_cap ] ) );
+      }
+      /** indexed from crp by the autorelease, hand out the base **/
+      *sig =  reinterpret_cast< void* >( (this)->peek_signals( n ) );
       *ptr =  buff_ptr->store;
       return;
    }
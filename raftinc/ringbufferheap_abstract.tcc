@@ -20,9 +20,16 @@
 #ifndef RAFTRINGBUFFERHEAP_ABSTRACT_TCC
 #define RAFTRINGBUFFERHEAP_ABSTRACT_TCC  1
 
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <thread>
+#include <vector>
 #include "portexception.hpp"
 #include "defs.hpp"
 #include "sysschedutil.hpp"
+#include "ringspan.hpp"
+#include "signalqueue.hpp"
 
 template < class T,  Type::RingBufferType type > 
 class RingBufferBaseHeap : public FIFOAbstract< T, type> 
@@ -50,51 +57,23 @@ public:
          if( (this)->datamanager.notResizing() )
          {
             auto * const buff_ptr( (this)->datamanager.get() );
-TOP:      
-            const auto   wrap_write( Pointer::wrapIndicator( buff_ptr->write_pt  ) ),
-                         wrap_read(  Pointer::wrapIndicator( buff_ptr->read_pt   ) );
-
-            const auto   wpt( Pointer::val( buff_ptr->write_pt ) ), 
-                         rpt( Pointer::val( buff_ptr->read_pt  ) );
-            if( R_UNLIKELY (wpt == rpt) )
-            {
-               /** expect most of the time to be full **/
-               if( R_LIKELY( wrap_read < wrap_write ) )
-               {
-                  (this)->datamanager.exitBuffer( dm::size );
-                  return( buff_ptr->max_cap );
-               }
-               else if( wrap_read > wrap_write )
-               {
-                  /**
-                   * TODO, this condition is momentary, however there
-                   * is a better way to fix this with atomic operations...
-                   * or on second thought benchmarking shows the atomic
-                   * operations slows the queue down drastically so, perhaps
-                   * this is in fact the best of all possible returns (see 
-                   * Leibniz or Candide for further info).
-                   */
-                  raft::yield();
-                  goto TOP;
-               }
-               else
-               {
-                  (this)->datamanager.exitBuffer( dm::size );
-                  return( 0 );
-               }
-            }
-            else if( rpt < wpt )
-            {
-               (this)->datamanager.exitBuffer( dm::size );
-               return( wpt - rpt );
-            }
-            else if( rpt > wpt )
-            {
-               (this)->datamanager.exitBuffer( dm::size );
-               return( buff_ptr->max_cap - rpt + wpt ); 
-            }
+            /** 
+             * read first, the read position can't pass the write
+             * position so reading write second means the difference
+             * can't go negative. It can momentarily exceed the 
+             * capacity if both sides move in between the two 
+             * loads, so clamp.
+             */
+            /** 
+             * published position only, size() can be called from
+             * any thread, what the consumer hasn't published yet
+             * is its own (see consumer_size() below).
+             */
+            const auto rpt( Pointer::position( buff_ptr->read_pt ) );
+            const auto wpt( Pointer::position( buff_ptr->write_pt ) );
+            const std::size_t used( wpt > rpt ? wpt - rpt : 0 );
             (this)->datamanager.exitBuffer( dm::size );
-            return( 0 );
+            return( used < buff_ptr->max_cap ? used : buff_ptr->max_cap );
          }
          (this)->datamanager.exitBuffer( dm::size );
          raft::yield();
@@ -103,6 +82,28 @@ TOP:
    }
 
 
+   /**
+    * consumer_size - see FIFO::consumer_size(), same as size()
+    * but from the consumer's own read position.
+    * @return  std::size_t
+    */
+   virtual std::size_t   consumer_size() noexcept
+   {
+      for( ;; )
+      {
+         (this)->datamanager.enterBuffer( dm::size );
+         if( (this)->datamanager.notResizing() )
+         {
+            const auto used( (this)->local_used() );
+            (this)->datamanager.exitBuffer( dm::size );
+            return( used );
+         }
+         (this)->datamanager.exitBuffer( dm::size );
+         raft::yield();
+      } /** end for **/
+      return( 0 ); /** keep some compilers happy **/
+   }
+
    /**
     * invalidate - used by producer thread to label this
     * queue as invalid.  Could be for many differing reasons,
@@ -115,6 +116,8 @@ TOP:
    {
       auto * const ptr( (this)->datamanager.get() );
       ptr->is_valid = false;
+      /** a parked consumer needs to see this to exit **/
+      (this)->wake_all();
       return;
    }
    
@@ -140,7 +143,15 @@ TOP:
     */
    virtual std::size_t   space_avail()
    {
-      return( (this)->datamanager.get()->max_cap - size() );
+      /** 
+       * producer's view, counts what it has written but not
+       * yet published on a batched edge as used.
+       */
+      auto * const buff_ptr( (this)->datamanager.get() );
+      const auto rpt( Pointer::position( buff_ptr->read_pt ) );
+      const auto wpt( (this)->write_position() );
+      const std::size_t used( wpt - rpt );
+      return( used < buff_ptr->max_cap ? buff_ptr->max_cap - used : 0 );
    }
   
    /**
@@ -207,9 +218,598 @@ TOP:
     {
         return( (this)->datamanager.get()->force_resize );
     }
-   
+
+    /**
+     * footprint - bytes allocated for the store and
+     * signal arrays of the current buffer.
+     * @return  std::size_t
+     */
+    virtual std::size_t footprint()
+    {
+        return( (this)->datamanager.get()->dynamic_alloc_size );
+    }
+
+   /**
+    * set_batch - see batch.hpp, called by the allocator before
+    * either end starts.
+    * @param   b - const raft::batch&
+    */
+   virtual void set_batch( const raft::batch &b )
+   {
+      (this)->batch_items = b.items;
+      (this)->batch_latency = b.latency;
+      if( b.items != 0 )
+      {
+         /** a resize has to take along what isn't published yet **/
+         (this)->datamanager.track_unpublished( &(this)->write_batch.pending );
+      }
+   }
+
+   /**
+    * set_placement - see placement.hpp, called by the allocator
+    * before either end starts, while the store is still empty.
+    * @param   place - const raft::placement&
+    */
+   virtual void set_placement( const raft::placement &place )
+   {
+      (this)->datamanager.get()->replace_store( place );
+   }
+
+   /**
+    * flush - publish everything written so far, only called
+    * from the producer's thread.
+    */
+   virtual void flush()
+   {
+      (this)->publish_writes_outside();
+   }
+
 
 protected:
+   /**
+    * flush_reads - publish everything read so far, only called
+    * from the consumer's thread.
+    */
+   virtual void flush_reads()
+   {
+      (this)->publish_reads_outside();
+   }
+
+   /**
+    * flush_due - the clock is only read every BATCH_POLL_STRIDE
+    * calls, and only while something is waiting to be published.
+    */
+   virtual void flush_due()
+   {
+      auto &wb( (this)->write_batch );
+      if( wb.pending == 0 || ++wb.polls < BATCH_POLL_STRIDE )
+      {
+         return;
+      }
+      wb.polls = 0;
+      if( std::chrono::steady_clock::now() - wb.oldest >= (this)->batch_latency )
+      {
+         (this)->publish_writes_outside();
+      }
+   }
+
+   /**
+    * write_position/read_position - position of the next item
+    * each end will write (read), including what it hasn't
+    * published yet. Only valid on that end's own thread.
+    * @return  std::uint64_t
+    */
+   std::uint64_t write_position() noexcept
+   {
+      auto * const buff_ptr( (this)->datamanager.get() );
+      return( Pointer::position( buff_ptr->write_pt ) + (this)->write_batch.pending );
+   }
+
+   std::uint64_t read_position() noexcept
+   {
+      auto * const buff_ptr( (this)->datamanager.get() );
+      return( Pointer::position( buff_ptr->read_pt ) + (this)->read_batch.pending );
+   }
+
+   /**
+    * local_used - what consumer_size() returns, for use inside
+    * the consumer's own calls, between enterBuffer() and 
+    * exitBuffer() once notResizing() has said the buffer is safe.
+    * @return  std::size_t
+    */
+   std::size_t local_used() noexcept
+   {
+      auto * const buff_ptr( (this)->datamanager.get() );
+      const auto rpt( (this)->read_position() );
+      const auto wpt( Pointer::position( buff_ptr->write_pt ) );
+      const std::size_t used( wpt > rpt ? wpt - rpt : 0 );
+      return( used < buff_ptr->max_cap ? used : buff_ptr->max_cap );
+   }
+
+   /**
+    * write_index/read_index - index into the store of the
+    * positions above, use in place of Pointer::val on the
+    * write (read) pointer.
+    * @return  std::size_t
+    */
+   std::size_t write_index() noexcept
+   {
+      auto * const buff_ptr( (this)->datamanager.get() );
+      return( Pointer::index( buff_ptr->write_pt, (this)->write_position() ) );
+   }
+
+   std::size_t read_index() noexcept
+   {
+      auto * const buff_ptr( (this)->datamanager.get() );
+      return( Pointer::index( buff_ptr->read_pt, (this)->read_position() ) );
+   }
+
+   /**
+    * commit_write - the producer has written n more items,
+    * publishes them right away unless the edge is batched.
+    * A batched edge publishes once it has batch_items
+    * pending, or right away if the consumer has already read
+    * everything published, there's no point making it wait.
+    * @param   n - const std::size_t
+    */
+   void commit_write( const std::size_t n ) noexcept
+   {
+      auto &wb( (this)->write_batch );
+      wb.pending += n;
+      if( R_LIKELY( (this)->batch_items == 0 ) || wb.pending >= (this)->batch_items )
+      {
+         (this)->publish_writes();
+         return;
+      }
+      auto * const buff_ptr( (this)->datamanager.get() );
+      if( Pointer::position( buff_ptr->write_pt ) ==
+            Pointer::position( buff_ptr->read_pt ) )
+      {
+         (this)->publish_writes();
+      }
+      else if( wb.pending == n )
+      {
+         /** oldest unpublished item, for flush_due **/
+         wb.oldest = std::chrono::steady_clock::now();
+         wb.polls  = 0;
+      }
+   }
+
+   void publish_writes() noexcept
+   {
+      auto &wb( (this)->write_batch );
+      if( wb.pending == 0 )
+      {
+         return;
+      }
+      Pointer::incBy( (this)->datamanager.get()->write_pt, wb.pending );
+      wb.pending = 0;
+      (this)->wake_consumer();
+   }
+
+   /**
+    * commit_read - the consumer has read n more items, mirror
+    * image of commit_write. A batched edge gives the slots
+    * back early if the producer looks to be out of room.
+    * @param   n - const std::size_t
+    */
+   void commit_read( const std::size_t n ) noexcept
+   {
+      auto &rb( (this)->read_batch );
+      rb.pending += n;
+      if( R_LIKELY( (this)->batch_items == 0 ) || rb.pending >= (this)->batch_items )
+      {
+         (this)->publish_reads();
+         return;
+      }
+      auto * const buff_ptr( (this)->datamanager.get() );
+      if( Pointer::position( buff_ptr->write_pt ) -
+            Pointer::position( buff_ptr->read_pt ) >= buff_ptr->max_cap )
+      {
+         (this)->publish_reads();
+      }
+   }
+
+   void publish_reads() noexcept
+   {
+      auto &rb( (this)->read_batch );
+      if( rb.pending == 0 )
+      {
+         return;
+      }
+      Pointer::incBy( (this)->datamanager.get()->read_pt, rb.pending );
+      rb.pending = 0;
+      (this)->wake_producer();
+   }
+
+   /**
+    * producer_wait/consumer_wait - the other end can't see
+    * what hasn't been published, so publish before waiting
+    * on it or both ends could wait on each other.
+    */
+   void producer_wait( raft::wait::backoff &wait, const std::size_t n )
+   {
+      (this)->publish_writes_outside();
+      FIFOAbstract< T, type >::producer_wait( wait, n );
+   }
+
+   void consumer_wait( raft::wait::backoff &wait, const std::size_t n )
+   {
+      (this)->publish_reads_outside();
+      FIFOAbstract< T, type >::consumer_wait( wait, n );
+   }
+
+   /**
+    * publish_writes_outside/publish_reads_outside - for the
+    * calls above, made without having entered the buffer. The
+    * buffer can be swapped by a resize under us, so enter it
+    * and wait out a resize before publishing.
+    */
+   void publish_writes_outside() noexcept
+   {
+      if( R_LIKELY( (this)->write_batch.pending == 0 ) )
+      {
+         return;
+      }
+      while( ! (this)->publish_entered( dm::push ) )
+      {
+         std::this_thread::yield();
+      }
+   }
+
+   void publish_reads_outside() noexcept
+   {
+      if( R_LIKELY( (this)->read_batch.pending == 0 ) )
+      {
+         return;
+      }
+      while( ! (this)->publish_entered( dm::pop ) )
+      {
+         std::this_thread::yield();
+      }
+   }
+
+   /** publish_entered - one try for the two above, false while resizing **/
+   bool publish_entered( const dm::access_key key ) noexcept
+   {
+      (this)->datamanager.enterBuffer( key );
+      const bool safe( (this)->datamanager.notResizing() );
+      if( safe )
+      {
+         if( key == dm::push )
+         {
+            (this)->publish_writes();
+         }
+         else
+         {
+            (this)->publish_reads();
+         }
+      }
+      (this)->datamanager.exitBuffer( key );
+      return( safe );
+   }
+
+   /**
+    * write_signal - producer side, sig goes with the item offset
+    * items past the write position. Goes to the side queue, or
+    * to its slot if that's full, nothing to do for raft::none.
+    * @param   sig - const raft::signal
+    * @param   offset - const std::size_t
+    */
+   void write_signal( const raft::signal sig, 
+                      const std::size_t offset = 0 ) noexcept
+   {
+      if( R_LIKELY( sig == raft::none ) )
+      {
+         return;
+      }
+      const auto seq( (this)->write_position() + offset );
+      if( R_UNLIKELY( ! (this)->side_signals.push( seq, sig ) ) )
+      {
+         auto * const buff_ptr( (this)->datamanager.get() );
+         buff_ptr->slots()[ Pointer::index( buff_ptr->write_pt, seq ) ] = sig;
+         (this)->side_signals.overflow( seq );
+      }
+   }
+
+   /**
+    * read_signal - consumer side, signal of the item at the
+    * read position, leaves it there.
+    * @return  raft::signal
+    */
+   raft::signal read_signal() noexcept
+   {
+      const auto seq( (this)->read_position() );
+      Buffer::SignalQueue::entry e;
+      if( (this)->side_signals.front( e ) && e.seq == seq )
+      {
+         return( e.sig );
+      }
+      if( R_UNLIKELY( (this)->side_signals.overflowed( seq ) ) )
+      {
+         return( (this)->datamanager.get()->signal[ (this)->read_index() ] );
+      }
+      return( raft::none );
+   }
+
+   /**
+    * take_signals - consumer side, call before releasing the n
+    * items at the read position. Calls f( i, sig ) for each of
+    * them that has a signal, a slot it came from is reset to 
+    * raft::none.
+    * @param   n - const std::size_t
+    * @param   f - F&&, void( std::size_t, raft::signal )
+    */
+   template < class F > void take_signals( const std::size_t n, F &&f )
+   {
+      auto &q( (this)->side_signals );
+      const auto begin( (this)->read_position() );
+      const auto end( begin + n );
+      /** some are only in their slots, look at all of them **/
+      if( R_UNLIKELY( q.overflowed( begin ) ) )
+      {
+         auto * const buff_ptr( (this)->datamanager.get() );
+         for( auto seq( begin ); seq < end; seq++ )
+         {
+            auto &slot( buff_ptr->signal[ Pointer::index( buff_ptr->read_pt, seq ) ] );
+            if( slot.sig != raft::none )
+            {
+               f( seq - begin, slot.sig );
+               slot = raft::none;
+            }
+         }
+      }
+      Buffer::SignalQueue::entry e;
+      while( q.front( e ) && e.seq < end )
+      {
+         f( e.seq - begin, e.sig );
+         q.pop_front();
+      }
+   }
+
+   /**
+    * peek_signals - consumer side, for peek_range, returns an
+    * array indexed like the store that has the signals of the n
+    * items at the read position, raft::none everywhere else.
+    * Allocated on the first call, only the entries set by the
+    * last call are cleared.
+    * @param   n - const std::size_t
+    * @return  Buffer::Signal*
+    */
+   Buffer::Signal* peek_signals( const std::size_t n )
+   {
+      auto * const buff_ptr( (this)->datamanager.get() );
+      auto &sigs( (this)->peeked_signals );
+      auto &set( (this)->peeked_set );
+      if( sigs.size() != buff_ptr->max_cap )
+      {
+         sigs.assign( buff_ptr->max_cap, Buffer::Signal() );
+         set.clear();
+      }
+      for( const auto index : set )
+      {
+         sigs[ index ].sig = raft::none;
+      }
+      set.clear();
+      auto &q( (this)->side_signals );
+      const auto begin( (this)->read_position() );
+      const auto end( begin + n );
+      if( R_UNLIKELY( q.overflowed( begin ) ) )
+      {
+         for( auto seq( begin ); seq < end; seq++ )
+         {
+            const auto index( Pointer::index( buff_ptr->read_pt, seq ) );
+            if( buff_ptr->signal[ index ].sig != raft::none )
+            {
+               sigs[ index ].sig = buff_ptr->signal[ index ].sig;
+               set.emplace_back( index );
+            }
+         }
+      }
+      Buffer::SignalQueue::entry e;
+      for( std::size_t offset( 0 ); q.front( e, offset ) && e.seq < end; offset++ )
+      {
+         const auto index( Pointer::index( buff_ptr->read_pt, e.seq ) );
+         sigs[ index ].sig = e.sig;
+         set.emplace_back( index );
+      }
+      return( sigs.data() );
+   }
+
+   /** take_signal - take_signals for the one item at the read position **/
+   raft::signal take_signal()
+   {
+      raft::signal sig( raft::none );
+      (this)->take_signals( 1, [&]( const std::size_t i, const raft::signal s )
+      {
+         UNUSED( i );
+         sig = s;
+      } );
+      return( sig );
+   }
+
+   /**
+    * local_space_avail - producer side check used by the
+    * blocking functions (push, allocate, etc.), returns true
+    * if at least n items can be written without blocking.
+    * The default version simply calls space_avail().
+    * @param   n - const std::size_t
+    * @return  bool
+    */
+   template < Type::RingBufferType t = type,
+              typename std::enable_if< t != Type::SPSC >::type* = nullptr >
+   bool local_space_avail( const std::size_t n )
+   {
+      return( (this)->space_avail() >= n );
+   }
+
+   /**
+    * local_space_avail - SPSC version, only the producer's own
+    * write pointer is read on each call. The consumer's read
+    * pointer is read (and the cached copy refreshed) only when
+    * the cached copy says there isn't enough room. The cached
+    * read position can only lag the real one, so at worst
+    * we refresh once more than needed.
+    * @param   n - const std::size_t
+    * @return  bool
+    */
+   template < Type::RingBufferType t = type,
+              typename std::enable_if< t == Type::SPSC >::type* = nullptr >
+   bool local_space_avail( const std::size_t n )
+   {
+      auto * const buff_ptr( (this)->datamanager.get() );
+      const auto   gen( (this)->datamanager.get_generation() );
+      auto &pd( (this)->producer_data );
+      const auto wpt( (this)->write_position() );
+      const auto cap( buff_ptr->max_cap );
+      auto free_slots( [&]() noexcept -> std::size_t
+      {
+         const auto used( wpt - pd.remote_read );
+         return( used >= cap ? 0 : cap - used );
+      } );
+      if( R_LIKELY( pd.remote_gen == gen ) && free_slots() >= n )
+      {
+         return( true );
+      }
+      /** cached copy says full, or the buffer was resized, re-read **/
+      pd.remote_read   = Pointer::position( buff_ptr->read_pt );
+      pd.remote_gen    = gen;
+      return( free_slots() >= n );
+   }
+
+   /**
+    * local_size - consumer side check used by the blocking
+    * functions (pop, peek, recycle, etc.), returns true if
+    * at least n items are available to read. The default
+    * version simply calls local_used().
+    * @param   n - const std::size_t
+    * @return  bool
+    */
+   template < Type::RingBufferType t = type,
+              typename std::enable_if< t != Type::SPSC >::type* = nullptr >
+   bool local_size( const std::size_t n )
+   {
+      return( (this)->local_used() >= n );
+   }
+
+   /**
+    * local_size - SPSC version, mirror image of the
+    * local_space_avail function above. The producer's write
+    * pointer is only read when the cached copy says the
+    * queue doesn't have n items.
+    * @param   n - const std::size_t
+    * @return  bool
+    */
+   template < Type::RingBufferType t = type,
+              typename std::enable_if< t == Type::SPSC >::type* = nullptr >
+   bool local_size( const std::size_t n )
+   {
+      auto * const buff_ptr( (this)->datamanager.get() );
+      const auto   gen( (this)->datamanager.get_generation() );
+      auto &cd( (this)->consumer_data );
+      const auto rpt( (this)->read_position() );
+      auto avail( [&]() noexcept -> std::size_t
+      {
+         return( cd.remote_write > rpt ? cd.remote_write - rpt : 0 );
+      } );
+      if( R_LIKELY( cd.remote_gen == gen ) && avail() >= n )
+      {
+         return( true );
+      }
+      /** cached copy says empty, or the buffer was resized, re-read **/
+      cd.remote_write  = Pointer::position( buff_ptr->write_pt );
+      cd.remote_gen    = gen;
+      return( avail() >= n );
+   }
+
+   /**
+    * local_allocate_span - same wait as local_allocate_n, the only
+    * per-item work left is clearing the signals for the range.
+    */
+   virtual void local_allocate_span( void *range,
+                                     const std::size_t n )
+   {
+      auto wait( (this)->producer_backoff() );
+      for( ;; )
+      {
+         (this)->datamanager.enterBuffer( dm::allocate_range );
+         if( (this)->datamanager.notResizing() && (this)->local_space_avail( n ) )
+         {
+            break;
+         }
+         /** too big to ever fit, ask the allocator for more room **/
+         if( (this)->capacity() < n )
+         {
+            ((this)->datamanager.get()->force_resize) = n;
+         }
+         (this)->datamanager.exitBuffer( dm::allocate_range );
+         auto &wr_stats( (this)->producer_data.write_stats->bec.blocked );
+         if( wr_stats == 0 )
+         {
+            wr_stats = 1;
+         }
+         (this)->producer_wait( wait, n );
+      }
+      make_span( range, (this)->write_index(), n );
+      (this)->producer_data.n_allocated = 
+        static_cast< decltype( (this)->producer_data.n_allocated ) >( n );
+      (this)->producer_data.allocate_called = true;
+      /** exitBuffer() called by send_range **/
+   }
+
+   virtual void local_peek_span( void *range,
+                                 const std::size_t n )
+   {
+      auto wait( (this)->consumer_backoff() );
+      for(;;)
+      {
+         (this)->datamanager.enterBuffer( dm::peek );
+         if( (this)->datamanager.notResizing() )
+         {
+            if( (this)->local_size( n ) )
+            {
+               break;
+            }
+            else if( (this)->is_invalid() && (this)->local_used() == 0 )
+            {
+               throw ClosedPortAccessException(
+                  "Accessing closed port with local_peek_span call, exiting!!" );
+            }
+            else if( (this)->is_invalid() && (this)->local_used() < n )
+            {
+               throw NoMoreDataException( "Too few items left on closed port, kernel exiting" );
+            }
+         }
+         (this)->datamanager.exitBuffer( dm::peek );
+         (this)->consumer_wait( wait, n );
+      }
+      make_span( range, (this)->read_index(), n );
+      /** exitBuffer() called by unpeek **/
+   }
+
+   /**
+    * make_span - sets the raft::span_pair pointed to by range to
+    * the n items starting at index. A mirrored store can be read
+    * straight past its end, so treat it as twice as long and the 
+    * range never has to be split.
+    * @param   range - void* const, dereferenced raft::span_pair
+    * @param   index - const std::size_t
+    * @param   n - const std::size_t
+    */
+   void make_span( void * const range, 
+                   const std::size_t index, 
+                   const std::size_t n ) noexcept
+   {
+      auto * const buff_ptr( (this)->datamanager.get() );
+      using store_t = 
+         typename std::remove_pointer< decltype( buff_ptr->store ) >::type;
+      const std::size_t length( buff_ptr->mirrored ? 
+                                buff_ptr->max_cap << 1 : 
+                                buff_ptr->max_cap );
+      *reinterpret_cast< raft::span_pair< store_t >* >( range ) = 
+         raft::span_pair< store_t >( buff_ptr->store, length, index, n );
+   }
+
    /**
     * setPtrMap
     */
@@ -258,9 +858,17 @@ protected:
        * this value since the elements all remain in their 
        * location relative to the start of the queue.
        */
-      auto * const buff_ptr( (this)->datamanager.get() );
-      const size_t read_index( Pointer::val( buff_ptr->read_pt ) );
-      return( buff_ptr->signal[ read_index ] /* make copy */ ); 
+      return( (this)->read_signal() );
+   }
+
+   /**
+    * has_signal - only the side queue of signals is checked,
+    * see signalqueue.hpp.
+    * @return  bool
+    */
+   virtual bool has_signal()
+   {
+      return( (this)->side_signals.pending( (this)->read_position() ) );
    }
    /**
     * signal_pop - special function fo rthe scheduler to 
@@ -323,44 +931,78 @@ protected:
                                const raft::signal &signal, 
                                const std::size_t iterator_type )
    {
-   using it_list = typename std::list< T >::iterator;
-   using it_vec  = typename std::vector< T >::iterator; 
-
-   /**
-    * FIXME: I suspect this would be faster if the compile time (this)
-    * were in fact a pass by reference and the local_insert_helper could be 
-    * absorbed into the std::function, I think the capture probably
-    * has about as bad of perf as std::bind
-    */
-   const std::map< std::size_t, 
-             std::function< void (void*,void*,const raft::signal&) > > func_map
-               = {{ typeid( it_list ).hash_code(), 
-                    [&]( void *b_ptr, void *e_ptr, const raft::signal  &sig )
-                    {
-                        it_list *begin( reinterpret_cast< it_list* >( b_ptr ) );
-                        it_list *end  ( reinterpret_cast< it_list* >( e_ptr   ) );
-                        local_insert_helper( *begin, *end, sig );
-                    } },
-                  { typeid( it_vec ).hash_code(),
-                    [&]( void *b_ptr, void *e_ptr, const raft::signal  &sig )
-                    {
-                        it_vec *begin( reinterpret_cast< it_vec* >( b_ptr ) );
-                        it_vec *end  ( reinterpret_cast< it_vec* >( e_ptr   ) );
-                        local_insert_helper( *begin, *end, sig );
-
-                    } } };
-      auto f( func_map.find( iterator_type ) );
-      if( f != func_map.end() )
-      {
-         (*f).second( begin_ptr, end_ptr, signal );
+      using it_list = typename std::list< T >::iterator;
+      using it_vec  = typename std::vector< T >::iterator; 
+      if( iterator_type == typeid( it_list ).hash_code() )
+      {
+         local_insert_helper( *reinterpret_cast< it_list* >( begin_ptr ),
+                              *reinterpret_cast< it_list* >( end_ptr ),
+                              signal );
+      }
+      else if( iterator_type == typeid( it_vec ).hash_code() )
+      {
+         insert_vector< T >( *reinterpret_cast< it_vec* >( begin_ptr ),
+                             *reinterpret_cast< it_vec* >( end_ptr ),
+                             signal );
       }
       else
       {
-         /** TODO, throw exception **/
-         assert( false );
+         throw PortTypeMismatchException( 
+            "insert with an iterator type this FIFO doesn't take, only "
+            "std::list and std::vector iterators of the port type are" );
       }
       return;
    }
+
+   /**
+    * insert_vector - a std::vector range is contiguous, it goes
+    * through local_insert_n like any other pointer and length,
+    * except for std::vector< bool > which isn't.
+    */
+   template < class U,
+              typename std::enable_if< ! std::is_same< U, bool >::value >::type* = nullptr >
+   void insert_vector( const typename std::vector< U >::iterator begin,
+                       const typename std::vector< U >::iterator end,
+                       const raft::signal &signal )
+   {
+      const auto n( std::distance( begin, end ) );
+      if( n > 0 )
+      {
+         (this)->local_insert_n( (const void*) &(*begin), 
+                                 static_cast< std::size_t >( n ), 
+                                 sizeof( U ), 
+                                 signal );
+      }
+   }
+
+   template < class U,
+              typename std::enable_if< std::is_same< U, bool >::value >::type* = nullptr >
+   void insert_vector( const typename std::vector< U >::iterator begin,
+                       const typename std::vector< U >::iterator end,
+                       const raft::signal &signal )
+   {
+      local_insert_helper( begin, end, signal );
+   }
+
+   /**
+    * local_insert_n - trivially copyable in line items are
+    * copied straight into the store, see bulk_insert.
+    */
+   virtual void local_insert_n( const void *items,
+                                const std::size_t n,
+                                const std::size_t item_size,
+                                const raft::signal &signal )
+   {
+      bulk_insert< T >( items, n, item_size, signal );
+   }
+
+   virtual void local_pop_n( void *items,
+                             const std::size_t n,
+                             const std::size_t item_size,
+                             raft::signal *signals )
+   {
+      bulk_pop< T >( items, n, item_size, signals );
+   }
    
    
    /**
@@ -383,17 +1025,249 @@ protected:
             std::vector< std::pair< T, raft::signal > >* >( ptr_data ) );
       /** just in case **/
       assert( items->size() == n_items );
-      /**
-       * TODO: same as with the other range function
-       * I'm not too  happy with the performance on this
-       * one.  It'd be relatively easy to fix with a little
-       * time.
-       */
-      for( auto &pair : (*items))
+      pop_pairs< T >( *items );
+      return;
+   }
+
+private:
+   /** set_batch, zero publishes after every item **/
+   std::size_t                 batch_items   = 0;
+   std::chrono::microseconds   batch_latency =
+      std::chrono::microseconds( BATCH_LATENCY_US );
+
+   /**
+    * written (read) but not yet published, each only touched
+    * by its own end so each gets its own cache line.
+    */
+   struct ALIGN( L1D_CACHE_LINE_SIZE ) {
+      std::size_t                             pending = 0;
+      std::size_t                             polls   = 0;
+      std::chrono::steady_clock::time_point   oldest;
+   } write_batch;
+
+   struct ALIGN( L1D_CACHE_LINE_SIZE ) {
+      std::size_t                             pending = 0;
+   } read_batch;
+
+   /** non-raft::none signals in flight, see signalqueue.hpp **/
+   Buffer::SignalQueue         side_signals;
+   /** see peek_signals(), consumer's **/
+   std::vector< Buffer::Signal > peeked_signals;
+   std::vector< std::size_t >    peeked_set;
+
+   /**
+    * check_item_size - the items handed to bulk_insert and
+    * bulk_pop are copied as T, a caller passing anything else
+    * would read or write past the end of its array.
+    * @param   item_size - const std::size_t
+    * @throws  PortTypeMismatchException - if item_size isn't sizeof( T )
+    */
+   static void check_item_size( const std::size_t item_size )
+   {
+      if( item_size != sizeof( T ) )
+      {
+         throw PortTypeMismatchException( 
+            "Bulk access with items of " + std::to_string( item_size ) + 
+            " bytes on a FIFO of " + std::to_string( sizeof( T ) ) + 
+            " byte items" );
+      }
+   }
+
+   /**
+    * bulk_insert - waits for room, copies as much of the range
+    * as fits in with (at most) two memcpy calls and publishes 
+    * it with a single update of the write index, repeats till 
+    * everything is on the queue. Never waits for more than one
+    * slot, the consumer may be waiting on a bulk pop of its own.
+    */
+   template < class U,
+              typename std::enable_if< bulk_copy_alloc< U >::value >::type* = nullptr >
+   void bulk_insert( const void *items,
+                     const std::size_t n,
+                     const std::size_t item_size,
+                     const raft::signal &signal )
+   {
+      check_item_size( item_size );
+      auto *src( reinterpret_cast< const T* >( items ) );
+      std::size_t done( 0 );
+      while( done < n )
+      {
+         std::size_t chunk( 0 );
+         auto wait( (this)->producer_backoff() );
+         for( ;; )
+         {
+            (this)->datamanager.enterBuffer( dm::push );
+            if( (this)->datamanager.notResizing() && 
+                (this)->local_space_avail( 1 ) )
+            {
+               chunk = std::min( n - done, (this)->space_avail() );
+               break;
+            }
+            (this)->datamanager.exitBuffer( dm::push );
+            auto &wr_stats( (this)->producer_data.write_stats->bec.blocked );
+            if( wr_stats == 0 )
+            {
+               wr_stats = 1;
+            }
+            (this)->producer_wait( wait, 1 );
+         }
+         const std::size_t write_index( (this)->write_index() );
+         raft::span_pair< T > range;
+         make_span( (void*) &range, write_index, chunk );
+         std::memcpy( range.first.ptr, src + done, 
+                      range.first.length * sizeof( T ) );
+         std::memcpy( range.second.ptr, src + done + range.first.length,
+                      range.second.length * sizeof( T ) );
+         done += chunk;
+         if( done == n )
+         {
+            (this)->write_signal( signal, chunk - 1 );
+         }
+         (this)->commit_write( chunk );
+         (this)->producer_data.write_stats->bec.count += chunk;
+         (this)->datamanager.exitBuffer( dm::push );
+      }
+   }
+
+   template < class U,
+              typename std::enable_if< ! bulk_copy_alloc< U >::value >::type* = nullptr >
+   void bulk_insert( const void *items,
+                     const std::size_t n,
+                     const std::size_t item_size,
+                     const raft::signal &signal )
+   {
+      check_item_size( item_size );
+      FIFO::local_insert_n( items, n, item_size, signal );
+   }
+
+   /**
+    * wait_items - consumer side, waits till there's at least
+    * one item and returns how many of the n wanted can be 
+    * taken now. Leaves the buffer entered with dm::pop, throws
+    * like pop does if the producer is done and it's empty.
+    */
+   std::size_t wait_items( const std::size_t n )
+   {
+      auto wait( (this)->consumer_backoff() );
+      for( ;; )
+      {
+         (this)->datamanager.enterBuffer( dm::pop );
+         if( (this)->datamanager.notResizing() )
+         {
+            if( (this)->local_size( 1 ) )
+            {
+               return( std::min( n, (this)->local_used() ) );
+            }
+            else if( (this)->is_invalid() && (this)->local_used() == 0 )
+            {
+               (this)->datamanager.exitBuffer( dm::pop );
+               throw ClosedPortAccessException(
+                  "Accessing closed port with pop_range call, exiting!!" );
+            }
+         }
+         (this)->datamanager.exitBuffer( dm::pop );
+         auto &rd_stats( (this)->consumer_data.read_stats->bec.blocked );
+         if( rd_stats == 0 )
+         {
+            rd_stats = 1;
+         }
+         (this)->consumer_wait( wait, 1 );
+      }
+   }
+
+   /** 
+    * release_items - moves the read index past the chunk
+    * items copied out after wait_items and leaves the buffer.
+    */
+   void release_items( const std::size_t chunk )
+   {
+      (this)->commit_read( chunk );
+      (this)->consumer_data.read_stats->bec.count += chunk;
+      (this)->datamanager.exitBuffer( dm::pop );
+   }
+
+   template < class U,
+              typename std::enable_if< bulk_copy_alloc< U >::value >::type* = nullptr >
+   void bulk_pop( void *items,
+                  const std::size_t n,
+                  const std::size_t item_size,
+                  raft::signal *signals )
+   {
+      check_item_size( item_size );
+      auto *dst( reinterpret_cast< T* >( items ) );
+      std::size_t done( 0 );
+      while( done < n )
+      {
+         const auto chunk( wait_items( n - done ) );
+         const std::size_t read_index( (this)->read_index() );
+         raft::span_pair< T > range;
+         make_span( (void*) &range, read_index, chunk );
+         std::memcpy( dst + done, range.first.ptr, 
+                      range.first.length * sizeof( T ) );
+         std::memcpy( dst + done + range.first.length, range.second.ptr,
+                      range.second.length * sizeof( T ) );
+         if( signals != nullptr )
+         {
+            std::fill( signals + done, signals + done + chunk, raft::none );
+         }
+         (this)->take_signals( chunk, [&]( const std::size_t i, const raft::signal sig )
+         {
+            if( signals != nullptr )
+            {
+               signals[ done + i ] = sig;
+            }
+         } );
+         done += chunk;
+         release_items( chunk );
+      }
+   }
+
+   template < class U,
+              typename std::enable_if< ! bulk_copy_alloc< U >::value >::type* = nullptr >
+   void bulk_pop( void *items,
+                  const std::size_t n,
+                  const std::size_t item_size,
+                  raft::signal *signals )
+   {
+      check_item_size( item_size );
+      FIFO::local_pop_n( items, n, item_size, signals );
+   }
+
+   /** same as bulk_pop but into the pairs pop_range uses **/
+   template < class U,
+              typename std::enable_if< bulk_copy_alloc< U >::value >::type* = nullptr >
+   void pop_pairs( std::vector< std::pair< T, raft::signal > > &items )
+   {
+      std::size_t done( 0 );
+      const auto n( items.size() );
+      while( done < n )
+      {
+         const auto chunk( wait_items( n - done ) );
+         const std::size_t read_index( (this)->read_index() );
+         raft::span_pair< T > range;
+         make_span( (void*) &range, read_index, chunk );
+         for( std::size_t i( 0 ); i < chunk; i++ )
+         {
+            items[ done + i ].first  = range[ i ];
+            items[ done + i ].second = raft::none;
+         }
+         (this)->take_signals( chunk, [&]( const std::size_t i, const raft::signal sig )
+         {
+            items[ done + i ].second = sig;
+         } );
+         done += chunk;
+         release_items( chunk );
+      }
+   }
+
+   template < class U,
+              typename std::enable_if< ! bulk_copy_alloc< U >::value >::type* = nullptr >
+   void pop_pairs( std::vector< std::pair< T, raft::signal > > &items )
+   {
+      for( auto &pair : items )
       {
          (this)->pop( pair.first, &(pair.second) );
       }
-      return;
    }
 };
 
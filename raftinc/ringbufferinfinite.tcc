@@ -1,10 +1,17 @@
 /**
- * ringbufferinfinite.tcc - 
+ * ringbufferinfinite.tcc - unbounded FIFO, the producer never
+ * blocks. Items are kept in the segmented queue implemented by
+ * Buffer::Data< T, Type::Infinite >, segments are linked in as
+ * the producer needs them and handed back through a free list
+ * once the consumer is done with them. There's a single version
+ * for all three allocation classes, the few places where they
+ * differ (constructing, destroying and reclaiming items) are
+ * split out below.
  * @author: Jonathan Beard
  * @version: Sun Sep  7 07:39:56 2014
- * 
+ *
  * Copyright 2014 Jonathan Beard
- * 
+ *
  * Licensed under the Apache License, Version 2.0 (the "License");
  * you may not use this file except in compliance with the License.
  * You may obtain a copy of the License at:
@@ -19,15 +26,21 @@
  */
 #ifndef RAFTRINGBUFFERINFINITE_TCC
 #define RAFTRINGBUFFERINFINITE_TCC  1
+#include <limits>
+#include <algorithm>
+#include <vector>
+#include <string>
 #include "alloc_traits.tcc"
-
-//TODO -> fixme
+#include "portexception.hpp"
+#include "sysschedutil.hpp"
+#include "ringspan.hpp"
 
 template < class T >
-class RingBufferBase< T, Type::Infinite, 
-           typename std::enable_if< inline_nonclass_alloc< T >::value >::type >
+class RingBufferBase< T, Type::Infinite >
 : public FIFOAbstract< T, Type::Infinite >
 {
+   using buffer_t = Buffer::Data< T, Type::Infinite >;
+   using type_t   = typename buffer_t::type_t;
 public:
    /**
     * RingBuffer - default constructor, initializes basic
@@ -36,224 +49,748 @@ public:
    RingBufferBase() : FIFOAbstract< T, Type::Infinite >()
    {
    }
-   
+
    virtual ~RingBufferBase() = default;
 
+   /** makes the local_* calls directly, see channel.hpp **/
+   template < class, Type::RingBufferType > friend class raft::channel;
 
    /**
-    * size - as you'd expect it returns the number of 
+    * size - as you'd expect it returns the number of
     * items currently in the queue.
     * @return size_t
     */
    virtual std::size_t   size()
    {
-      return( 1 );
-   }
-
-   virtual raft::signal get_signal() 
-   {
-#if 0   
-      /** FIXME, reimplement this function **/
-#endif      
-      return( raft::none );
-   }
-
-   virtual bool send_signal( const raft::signal   &signal )
-   {
-      UNUSED( signal );
-      return( true );
+      return( (this)->datamanager.get()->size() );
    }
 
    /**
-    * space_avail - returns the amount of space currently
-    * available in the queue.  This is the amount a user
-    * can expect to write without blocking
+    * space_avail - the queue grows to fit whatever is
+    * written, so there's always room.
     * @return  size_t
     */
    virtual std::size_t   space_avail()
    {
-      return( (this)->datamanager.get()->max_cap );
+      return( std::numeric_limits< std::size_t >::max() );
    }
 
-  
    /**
-    * capacity - returns the capacity of this queue which is 
-    * set at compile time by the constructor.
+    * capacity - unbounded, see space_avail.
     * @return size_t
     */
    virtual std::size_t   capacity()
    {
-      return( (this)->datamanager.get()->max_cap );
+      return( std::numeric_limits< std::size_t >::max() );
+   }
+
+   virtual void invalidate()
+   {
+      (this)->datamanager.get()->is_valid = false;
+      /** a parked consumer needs to see this to exit **/
+      (this)->wake_all();
+   }
+
+   virtual bool is_invalid()
+   {
+      return( ! (this)->datamanager.get()->is_valid );
+   }
+
+   virtual void get_zero_read_stats( Blocked &copy )
+   {
+      auto &buff_ptr_stats( (this)->datamanager.get()->read_stats.all );
+      copy.all       = buff_ptr_stats;
+      buff_ptr_stats = 0;
    }
 
-   
+   virtual void get_zero_write_stats( Blocked &copy )
+   {
+      auto &buff_ptr_stats( (this)->datamanager.get()->write_stats.all );
+      copy.all       = buff_ptr_stats;
+      buff_ptr_stats = 0;
+   }
+
+   /** the producer never blocks so this never asks for a resize **/
+   virtual float get_frac_write_blocked()
+   {
+      return( 0.0 );
+   }
+
+   virtual std::size_t get_suggested_count()
+   {
+      return( 0 );
+   }
+
+   /**
+    * footprint - bytes held in segments, including the
+    * ones waiting on the free list.
+    * @return  std::size_t
+    */
+   virtual std::size_t footprint()
+   {
+      return( (this)->datamanager.get()->bytes() );
+   }
+
+   virtual std::size_t high_water_mark()
+   {
+      return( (this)->datamanager.get()->high_water_mark() );
+   }
+
+   virtual void deallocate()
+   {
+      if( ! (this)->producer_data.allocate_called )
+      {
+         return;
+      }
+      for( auto &slot : pending_items.first )
+      {
+         discard_allocated( slot );
+      }
+      for( auto &slot : pending_items.second )
+      {
+         discard_allocated( slot );
+      }
+      (this)->producer_data.allocate_called = false;
+   }
 
    /**
     * send - releases the last item allocated by allocate() to
     * the queue.  Function will imply return if allocate wasn't
     * called prior to calling this function.
-    * @param signal - const raft::signal signal, default: raft::signal::none
+    * @param signal - const raft::signal signal, default: raft::none
     */
    virtual void send( const raft::signal signal = raft::none )
    {
-      if( ! (this)->allocate_called ) return;
-      (this)->datamanager.get()->signal[ 0 ].sig = signal;
-      (this)->write_stats.count += (this)->n_allocated;
-      (this)->allocate_called = false;
-      (this)->n_allocated = 1;
+      if( R_UNLIKELY( ! (this)->producer_data.allocate_called ) )
+      {
+         return;
+      }
+      pending_sigs[ 0 ] = signal;
+      (this)->datamanager.get()->commit( 1 );
+      (this)->wake_consumer();
+      (this)->producer_data.write_stats->bec.count++;
+      (this)->producer_data.allocate_called = false;
    }
 
-   /** TODO, add send_range func to match fifo.hpp **/
+   /**
+    * send_range - releases the items allocated by allocate_range
+    * or allocate_span, the signal goes with the last one.
+    * @param signal - const raft::signal signal, default: raft::none
+    */
+   virtual void send_range( const raft::signal signal = raft::none )
+   {
+      if( ! (this)->producer_data.allocate_called )
+      {
+         return;
+      }
+      auto &n_allocated( (this)->producer_data.n_allocated );
+      if( n_allocated > 0 )
+      {
+         pending_sigs[ n_allocated - 1 ] = signal;
+         (this)->datamanager.get()->commit( n_allocated );
+         (this)->wake_consumer();
+      }
+      (this)->producer_data.write_stats->bec.count += n_allocated;
+      (this)->producer_data.allocate_called = false;
+      n_allocated = 0;
+   }
 
    /**
-    * recycle - remove ``range'' items from the head of the
-    * queue and discard them.  Can be used in conjunction with
-    * the peek operator.
-    * @param   range - const size_t, default = 1
+    * unpeek - nothing is pinned on this queue, only
+    * the copies made for a peek_range or peek_span that
+    * covered too many segments need to be cleaned up.
     */
-   virtual void recycle( const std::size_t range = 1 )
+   virtual void unpeek()
    {
-      (this)->read_stats.count += range;
+      release_scratch();
    }
 
-   virtual void get_zero_read_stats( Blocked &copy )
+protected:
+   /**
+    * local_wait - consumer side, spins till there are at
+    * least n items. If the producer is done and there will
+    * never be n items then throws, or returns false when
+    * closed_ok is set.
+    * @param   n - const std::size_t
+    * @param   call - const char*, for the exception message
+    * @param   closed_ok - const bool
+    * @return  bool
+    */
+   bool local_wait( const std::size_t n,
+                    const char * const call,
+                    const bool closed_ok = false )
    {
-      copy.all       = (this)->read_stats.all;
-      (this)->read_stats.all = 0;
+      auto * const buff_ptr( (this)->datamanager.get() );
+      auto wait( (this)->consumer_backoff() );
+      for( ;; )
+      {
+         if( buff_ptr->size() >= n )
+         {
+            return( true );
+         }
+         if( (this)->is_invalid() )
+         {
+            /** check again, items may have landed before the close **/
+            const auto avail( buff_ptr->size() );
+            if( avail >= n )
+            {
+               return( true );
+            }
+            if( closed_ok )
+            {
+               return( false );
+            }
+            if( avail == 0 )
+            {
+               throw ClosedPortAccessException(
+                  std::string( "Accessing closed port with " ) + call +
+                     " call, exiting!!" );
+            }
+            throw NoMoreDataException( "Too few items left on closed port, kernel exiting" );
+         }
+         auto &rd_stats( (this)->consumer_data.read_stats->bec.blocked );
+         if( rd_stats == 0 )
+         {
+            rd_stats = 1;
+         }
+         (this)->consumer_wait( wait, n );
+      }
+      return( false ); /** keep some compilers happy **/
    }
 
-   virtual void get_zero_write_stats( Blocked &copy )
+   /**
+    * local_reserve - producer side, never waits, the
+    * reservation stays pending till send/send_range.
+    */
+   void local_reserve( const std::size_t n )
    {
-      copy.all       = (this)->write_stats.all;
-      (this)->write_stats.all = 0;
+      (this)->datamanager.get()->reserve( n, pending_items, pending_sigs );
+      std::fill( pending_sigs.first.begin(),  pending_sigs.first.end(),  raft::none );
+      std::fill( pending_sigs.second.begin(), pending_sigs.second.end(), raft::none );
    }
 
-protected:
-   
-   virtual void  local_allocate( void **ptr )
+   virtual void local_allocate( void **ptr )
    {
-      (this)->allocate_called = true;
-      *ptr = (void*)&((this)->datamanager.get()->store[ 0 ]);
+      local_reserve( 1 );
+      *ptr = (void*)&( pending_items[ 0 ] );
+      (this)->producer_data.allocate_called = true;
    }
 
-   virtual std::size_t local_allocate_n( void *ptr, const std::size_t n )
+   virtual void local_allocate_n( void *ptr, const std::size_t n )
    {
-      std::size_t output( n <= (this)->capacity() ? n : (this)->capacity() );
-      auto *container( reinterpret_cast< std::vector< std::reference_wrapper< T > >* >( ptr ) );
-      for( std::size_t index( 0 ); index < output; index++ )
-      {
-         container->push_back( (this)->datamanager.get()->store[ 0 ] );
-      }
-      (this)->allocate_called = true;
-      (this)->n_allocated     = output;
-      return( output );
+      local_allocate_refs< T >( ptr, n );
    }
-   
-   virtual void  local_push( void *ptr, const raft::signal &signal )
+
+   virtual void local_allocate_span( void *range,
+                                     const std::size_t n )
    {
-      T *item (reinterpret_cast< T* >( ptr ) );
-      (this)->datamanager.get()->store [ 0 ]  = *item;
-      /** a bit awkward since it gives the same behavior as the actual queue **/
-      (this)->datamanager.get()->signal[ 0 ].sig  = signal;
-      (this)->write_stats.count++;
+      local_reserve( n );
+      *reinterpret_cast< raft::span_pair< type_t >* >( range ) = pending_items;
+      (this)->producer_data.n_allocated =
+         static_cast< decltype( (this)->producer_data.n_allocated ) >( n );
+      (this)->producer_data.allocate_called = true;
    }
 
-   template< class iterator_type >
-   void local_insert_helper( iterator_type begin, 
-                             iterator_type end, 
-                             const raft::signal signal )
+   virtual void local_push( void *ptr, const raft::signal &signal )
    {
-      while( begin != end )
+      push_item( ptr, signal, false );
+   }
+
+   virtual void local_push_move( void *ptr, const raft::signal &signal )
+   {
+      push_item( ptr, signal, true );
+   }
+
+   void push_item( void *ptr, const raft::signal &signal, const bool move )
+   {
+      local_reserve( 1 );
+      if( ptr != nullptr )
+      {
+         store_item( pending_items[ 0 ], ptr, move );
+         (this)->producer_data.write_stats->bec.count++;
+      }
+      else
+      {
+         mark_empty( pending_items[ 0 ] );
+      }
+      pending_sigs[ 0 ] = signal;
+      (this)->datamanager.get()->commit( 1 );
+      (this)->wake_consumer();
+   }
+
+   template < class iterator_type >
+   void local_insert_helper( iterator_type begin,
+                             iterator_type end,
+                             const raft::signal &signal )
+   {
+      auto dist( std::distance( begin, end ) );
+      const raft::signal dummy( raft::none );
+      while( dist-- )
       {
-         (this)->datamanager.get()->store[ 0 ] = (*begin);
-         begin++;
-         (this)->write_stats.count++;
+         /** add signal to last el only **/
+         (this)->local_push( (void*)&(*begin), dist == 0 ? signal : dummy );
+         ++begin;
       }
-      (this)->datamanager.get()->signal[ 0 ].sig = signal;
       return;
    }
-   
 
    virtual void local_insert( void *begin_ptr,
                               void *end_ptr,
                               const raft::signal  &signal,
                               const std::size_t iterator_type )
    {
-      typedef typename std::list< T >::iterator   it_list;
-      typedef typename std::vector< T >::iterator it_vec;
-         
-      const std::map< std::size_t, 
-                std::function< void (void*,void*,const raft::signal&) > > func_map
-                  = {{ typeid( it_list ).hash_code(), 
-                       [ & ]( void *b_ptr, void *e_ptr, const raft::signal &sig )
-                       {
-                           it_list *begin( reinterpret_cast< it_list* >( b_ptr ) );
-                           it_list *end  ( reinterpret_cast< it_list* >( e_ptr   ) );
-                           local_insert_helper( *begin, *end, sig );
-                       } },
-                     { typeid( it_vec ).hash_code(),
-                       [ & ]( void *b_ptr, void *e_ptr, const raft::signal &sig )
-                       {
-                           it_vec *begin( reinterpret_cast< it_vec* >( b_ptr ) );
-                           it_vec *end  ( reinterpret_cast< it_vec* >( e_ptr   ) );
-                           local_insert_helper( *begin, *end, sig );
-
-                       } } };
-      auto f( func_map.find( iterator_type ) );
-      if( f != func_map.end() )
-      {
-         (*f).second( begin_ptr, end_ptr, signal );
+      using it_list = typename std::list< T >::iterator;
+      using it_vec  = typename std::vector< T >::iterator;
+
+      if( iterator_type == typeid( it_list ).hash_code() )
+      {
+         local_insert_helper( *reinterpret_cast< it_list* >( begin_ptr ),
+                              *reinterpret_cast< it_list* >( end_ptr ),
+                              signal );
+      }
+      else if( iterator_type == typeid( it_vec ).hash_code() )
+      {
+         local_insert_helper( *reinterpret_cast< it_vec* >( begin_ptr ),
+                              *reinterpret_cast< it_vec* >( end_ptr ),
+                              signal );
       }
       else
       {
-         /** TODO, throw exception **/
+         throw PortTypeMismatchException( 
+            "insert with an iterator type this FIFO doesn't take, only "
+            "std::list and std::vector iterators of the port type are" );
       }
       return;
    }
 
+   /**
+    * local_pop - if ptr == nullptr the item is thrown away,
+    * used by signal_pop.
+    */
    virtual void local_pop( void *ptr, raft::signal *signal )
    {
-      T *item( reinterpret_cast< T* >( ptr ) );
-      *item  = (this)->datamanager.get()->store[ 0 ];
+      local_wait( 1, "pop" );
+      auto * const buff_ptr( (this)->datamanager.get() );
+      raft::span_pair< type_t >         items;
+      raft::span_pair< Buffer::Signal > sigs;
+      buff_ptr->front( 1, items, sigs );
       if( signal != nullptr )
       {
-         *signal = (this)->datamanager.get()->signal[ 0 ].sig;
+         *signal = sigs[ 0 ];
       }
-      (this)->read_stats.count++;
+      take_item( items[ 0 ], ptr );
+      (this)->consumer_data.read_stats->bec.count++;
+      buff_ptr->consume( 1 );
    }
-  
+
    virtual void local_pop_range( void *ptr_data,
                                  const std::size_t n_items )
    {
-      UNUSED( ptr_data );
+      assert( ptr_data != nullptr );
+      auto *items(
+         reinterpret_cast<
+            std::vector< std::pair< T, raft::signal > >* >( ptr_data ) );
+      /** just in case **/
+      assert( items->size() == n_items );
       UNUSED( n_items );
-      //assert( ptr_data != nullptr );
-      //auto *items( reinterpret_cast< T* >( ptr_data ) );
-
-      //if( signal != nullptr )
-      //{
-      //   for( size_t i( 0 ); i < n_items; i++ )
-      //   {
-      //      items [ i ]  = (this)->datamanager.get()->store [ 0 ];
-      //   }
-      //}
-      //else
-      //{
-      //   for( size_t i( 0 ); i < n_items; i++ )
-      //   {
-      //      items [ i ]  = (this)->datamanager.get()->store [ 0 ];
-      //   }
-      //}
+      for( auto &pair : (*items) )
+      {
+         (this)->local_pop( (void*) &pair.first, &pair.second );
+      }
+      return;
    }
 
-
    virtual void local_peek( void **ptr, raft::signal  *signal )
    {
-      *ptr = (void*)&( (this)->datamanager.get()->store[ 0 ] );
+      local_wait( 1, "local_peek" );
+      raft::span_pair< type_t >         items;
+      raft::span_pair< Buffer::Signal > sigs;
+      (this)->datamanager.get()->front( 1, items, sigs );
       if( signal != nullptr )
       {
-         *signal = (this)->datamanager.get()->signal[  0  ].sig;
+         *signal = sigs[ 0 ];
+      }
+      *ptr = (void*)&( items[ 0 ] );
+      mark_peeked( items[ 0 ] );
+   }
+
+   /**
+    * local_peek_range - the autorelease< T, peekrange > object
+    * needs the range in one piece, fine as long as it's inside
+    * the head segment, otherwise it gets a copy (see
+    * copy_to_scratch).
+    */
+   virtual void local_peek_range( void **ptr,
+                                  void **sig,
+                                  const std::size_t n,
+                                  std::size_t &curr_pointer_loc ,
+                                  std::size_t &queue_size )
+   {
+      local_wait( n, "local_peek_range" );
+      auto * const buff_ptr( (this)->datamanager.get() );
+      raft::span_pair< type_t >         items;
+      raft::span_pair< Buffer::Signal > sigs;
+      curr_pointer_loc = 0;
+      /** always in one piece, never wraps **/
+      queue_size       = std::max( n, std::size_t( 1 ) );
+      if( n <= buff_ptr->max_cap )
+      {
+         buff_ptr->front( n, items, sigs );
+      }
+      type_t *range( nullptr );
+      if( n == 0 || ( items.size() == n && items.contiguous() ) )
+      {
+         range = items.first.ptr;
+         *sig  = (void*) sigs.first.ptr;
+      }
+      else
+      {
+         copy_to_scratch( n );
+         range = scratch_items();
+         *sig  = (void*) scratch_sigs.data();
+      }
+      for( std::size_t i( 0 ); i < n; i++ )
+      {
+         mark_peeked( range[ i ] );
+      }
+      *ptr = (void*) range;
+   }
+
+   virtual void local_peek_span( void *range,
+                                 const std::size_t n )
+   {
+      local_wait( n, "local_peek_span" );
+      auto * const buff_ptr( (this)->datamanager.get() );
+      auto &out( *reinterpret_cast< raft::span_pair< type_t >* >( range ) );
+      raft::span_pair< Buffer::Signal > sigs;
+      if( buff_ptr->front( n, out, sigs ) )
+      {
+         return;
+      }
+      copy_to_scratch( n );
+      out = raft::span_pair< type_t >( scratch_items(), n, 0, n );
+   }
+
+   virtual void local_recycle( std::size_t range )
+   {
+      auto * const buff_ptr( (this)->datamanager.get() );
+      while( range > 0 )
+      {
+         if( ! local_wait( 1, "recycle", true ) )
+         {
+            return;
+         }
+         /**
+          * every segment holds at least max_cap, so a run
+          * this long covers at most two of them
+          */
+         const std::size_t n( std::min( { range,
+                                          buff_ptr->size(),
+                                          buff_ptr->max_cap } ) );
+         raft::span_pair< type_t >         items;
+         raft::span_pair< Buffer::Signal > sigs;
+         buff_ptr->front( n, items, sigs );
+         for( auto &item : items.first )
+         {
+            drop_item( item );
+         }
+         for( auto &item : items.second )
+         {
+            drop_item( item );
+         }
+         buff_ptr->consume( n );
+         range -= n;
+      }
+   }
+
+   virtual raft::signal signal_peek()
+   {
+      auto * const buff_ptr( (this)->datamanager.get() );
+      if( buff_ptr->size() == 0 )
+      {
+         return( raft::none );
+      }
+      raft::span_pair< type_t >         items;
+      raft::span_pair< Buffer::Signal > sigs;
+      buff_ptr->front( 1, items, sigs );
+      return( sigs[ 0 ] );
+   }
+
+   virtual void signal_pop()
+   {
+      (this)->local_pop( nullptr, nullptr );
+   }
+
+   virtual void inline_signal_send( const raft::signal sig )
+   {
+      (this)->local_push( nullptr, sig );
+   }
+
+   virtual void setPtrMap( ptr_map_t * const in )
+   {
+       assert( in != nullptr );
+       (this)->consumer_data.in = in;
+   }
+
+   virtual void setPtrSet( ptr_set_t * const out )
+   {
+       assert( out != nullptr );
+       (this)->producer_data.out = out;
+   }
+
+   virtual void setInPeekSet( ptr_set_t * const peekset )
+   {
+       assert( peekset != nullptr );
+       (this)->consumer_data.in_peek = peekset;
+   }
+
+   virtual void setOutPeekSet( ptr_set_t * const peekset )
+   {
+       assert( peekset != nullptr );
+       (this)->producer_data.out_peek = peekset;
+   }
+
+private:
+   /**
+    * items stored in line, copy (or move) constructed into 
+    * the slot and destroyed when popped or recycled
+    */
+   template < class U = T,
+              typename std::enable_if< inline_alloc< U >::value >::type* = nullptr >
+   void store_item( type_t &slot, void * const ptr, const bool move )
+   {
+      T * const item( reinterpret_cast< T* >( ptr ) );
+      if( move )
+      {
+         new (&slot) T( std::move( *item ) );
+      }
+      else
+      {
+         new (&slot) T( *item );
+      }
+   }
+
+   template < class U = T,
+              typename std::enable_if< inline_alloc< U >::value >::type* = nullptr >
+   void mark_empty( type_t &slot ) noexcept
+   {
+      /** junk, same as the heap queue **/
+      UNUSED( slot );
+   }
+
+   template < class U = T,
+              typename std::enable_if< inline_alloc< U >::value >::type* = nullptr >
+   void take_item( type_t &slot, void * const ptr )
+   {
+      if( ptr != nullptr )
+      {
+         *reinterpret_cast< T* >( ptr ) = std::move( slot );
+      }
+      slot.~T();
+   }
+
+   template < class U = T,
+              typename std::enable_if< inline_alloc< U >::value >::type* = nullptr >
+   void drop_item( type_t &slot )
+   {
+      slot.~T();
+   }
+
+   template < class U = T,
+              typename std::enable_if< inline_alloc< U >::value >::type* = nullptr >
+   void discard_allocated( type_t &slot )
+   {
+      slot.~T();
+   }
+
+   template < class U = T,
+              typename std::enable_if< inline_alloc< U >::value >::type* = nullptr >
+   void mark_peeked( type_t &slot ) noexcept
+   {
+      UNUSED( slot );
+   }
+
+   template < class U = T,
+              typename std::enable_if< inline_alloc< U >::value >::type* = nullptr >
+   void local_allocate_refs( void * const ptr, const std::size_t n )
+   {
+      local_reserve( n );
+      auto *container(
+         reinterpret_cast< std::vector< std::reference_wrapper< T > >* >( ptr ) );
+      container->reserve( n );
+      for( auto &slot : pending_items.first )
+      {
+         container->emplace_back( slot );
+      }
+      for( auto &slot : pending_items.second )
+      {
+         container->emplace_back( slot );
       }
+      (this)->producer_data.n_allocated =
+         static_cast< decltype( (this)->producer_data.n_allocated ) >( n );
+      (this)->producer_data.allocate_called = true;
    }
+
+   /**
+    * externally allocated items, the queue holds pointers to
+    * objects from raft::slab_pool, same rules as the heap queue
+    */
+   template < class U = T,
+              typename std::enable_if< ext_alloc< U >::value >::type* = nullptr >
+   void store_item( type_t &slot, void * const ptr, const bool move )
+   {
+      T *item( reinterpret_cast< T* >( ptr ) );
+      /** only a handful of peeks per run, linear search is fine **/
+      auto &peeked( *(this)->producer_data.out_peek );
+      if( std::find( peeked.cbegin(), peeked.cend(),
+                     reinterpret_cast< std::uintptr_t >( item ) ) !=
+             peeked.cend() )
+      {
+         /** this was from a previous peek call **/
+         (this)->producer_data.out->push_back( reinterpret_cast< std::uintptr_t >( item ) );
+         slot = item;
+      }
+      else if( move )
+      {
+         slot = raft::slab_pool< T >::make( std::move( *item ) );
+      }
+      else
+      {
+         slot = raft::slab_pool< T >::make( *item );
+      }
+   }
+
+   template < class U = T,
+              typename std::enable_if< ext_alloc< U >::value >::type* = nullptr >
+   void mark_empty( type_t &slot ) noexcept
+   {
+      /** segments are reused, don't leave a stale pointer **/
+      slot = nullptr;
+   }
+
+   template < class U = T,
+              typename std::enable_if< ext_alloc< U >::value >::type* = nullptr >
+   void take_item( type_t &slot, void * const ptr )
+   {
+      if( slot == nullptr )
+      {
+         return;
+      }
+      if( ptr != nullptr )
+      {
+         *reinterpret_cast< T* >( ptr ) = std::move( *slot );
+      }
+      raft::slab_pool< T >::destroy( slot );
+   }
+
+   template < class U = T,
+              typename std::enable_if< ext_alloc< U >::value >::type* = nullptr >
+   void drop_item( type_t &slot )
+   {
+      if( slot == nullptr )
+      {
+         return;
+      }
+      /** might still be referenced downstream, let the gc have it **/
+      (this)->consumer_data.in->emplace_back(
+         reinterpret_cast< std::uintptr_t >( slot ),
+         &raft::slab_pool< T >::reclaim );
+   }
+
+   template < class U = T,
+              typename std::enable_if< ext_alloc< U >::value >::type* = nullptr >
+   void discard_allocated( type_t &slot )
+   {
+      raft::slab_pool< T >::destroy( slot );
+   }
+
+   template < class U = T,
+              typename std::enable_if< ext_alloc< U >::value >::type* = nullptr >
+   void mark_peeked( type_t &slot )
+   {
+      (this)->consumer_data.in_peek->push_back(
+         reinterpret_cast< ptr_t >( slot ) );
+   }
+
+   template < class U = T,
+              typename std::enable_if< ext_alloc< U >::value >::type* = nullptr >
+   void local_allocate_refs( void * const ptr, const std::size_t n )
+   {
+      local_reserve( n );
+      auto *container(
+         reinterpret_cast< std::vector< std::reference_wrapper< T > >* >( ptr ) );
+      container->reserve( container->size() + n );
+      /** a fresh object for each slot, as with allocate() **/
+      for( auto &slot : pending_items.first )
+      {
+         slot = raft::slab_pool< T >::make();
+         container->emplace_back( *slot );
+      }
+      for( auto &slot : pending_items.second )
+      {
+         slot = raft::slab_pool< T >::make();
+         container->emplace_back( *slot );
+      }
+      (this)->producer_data.n_allocated =
+         static_cast< decltype( (this)->producer_data.n_allocated ) >( n );
+      (this)->producer_data.allocate_called = true;
+   }
+
+   /**
+    * copy_to_scratch - copies the n items at the head of the
+    * queue (and their signals) into one contiguous block for
+    * the peek calls. The copies are only views, changes made
+    * through them don't reach the queue. Released by unpeek.
+    * @param   n - const std::size_t
+    */
+   void copy_to_scratch( const std::size_t n )
+   {
+      release_scratch();
+      if( scratch.size() < n )
+      {
+         scratch.resize( n );
+      }
+      scratch_sigs.resize( n );
+      auto * const out( scratch_items() );
+      std::size_t index( 0 );
+      (this)->datamanager.get()->visit( n,
+         [&]( const raft::span< type_t > items,
+              const raft::span< Buffer::Signal > sigs )
+         {
+            for( std::size_t i( 0 ); i < items.size(); i++, index++ )
+            {
+               new (&out[ index ]) type_t( items[ i ] );
+               scratch_sigs[ index ].sig   = sigs[ i ].sig;
+               scratch_sigs[ index ].index = sigs[ i ].index;
+            }
+         } );
+      scratch_live = n;
+   }
+
+   void release_scratch()
+   {
+      auto * const out( scratch_items() );
+      for( std::size_t index( 0 ); index < scratch_live; index++ )
+      {
+         out[ index ].~type_t();
+      }
+      scratch_live = 0;
+   }
+
+   type_t* scratch_items() noexcept
+   {
+      return( reinterpret_cast< type_t* >( scratch.data() ) );
+   }
+
+   /** producer side, set by local_reserve **/
+   raft::span_pair< type_t >            pending_items;
+   raft::span_pair< Buffer::Signal >    pending_sigs;
+
+   /** consumer side, see copy_to_scratch **/
+   std::vector< typename std::aligned_storage< sizeof( type_t ),
+                                               alignof( type_t ) >::type >
+                                        scratch;
+   std::vector< Buffer::Signal >        scratch_sigs;
+   std::size_t                          scratch_live = 0;
 };
 #endif /* END RAFTRINGBUFFERINFINITE_TCC */
@@ -415,7 +415,8 @@ protected:
    virtual void local_peek_range( void **ptr,
                                   void **sig,
                                   const std::size_t n,
-                                  std::size_t &curr_pointer_loc )
+                                  std::size_t &curr_pointer_loc ,
+                                  std::size_t &queue_size )
    {
       for(;;)
       {
@@ -456,6 +457,7 @@ protected:
       auto * const buff_ptr( (this)->datamanager.get() );
       const std::size_t cpl( Pointer::val( buff_ptr->read_pt ) );
       curr_pointer_loc = cpl;
+      queue_size       = buff_ptr->max_cap;
       *sig =  reinterpret_cast< void* >(  &buff_ptr->signal[ cpl ] );
       *ptr =  buff_ptr->store;
       return;
@@ -851,7 +853,8 @@ protected:
    virtual void local_peek_range( void **ptr,
                                   void **sig,
                                   const std::size_t n,
-                                  std::size_t &curr_pointer_loc )
+                                  std::size_t &curr_pointer_loc ,
+                                  std::size_t &queue_size )
    {
       for(;;)
       {
@@ -892,6 +895,7 @@ protected:
       auto * const buff_ptr( (this)->datamanager.get() );
       const auto cpl( Pointer::val( buff_ptr->read_pt ) );
       curr_pointer_loc = cpl;
+      queue_size       = buff_ptr->max_cap;
       *sig =  reinterpret_cast< void* >(  &buff_ptr->signal[ cpl ] );
       *ptr =  buff_ptr->store;
       return;
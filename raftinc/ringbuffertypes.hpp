@@ -1,13 +1,46 @@
-#ifndef RAFTRINGBUFFERTYPES_HPP 
+#ifndef RAFTRINGBUFFERTYPES_HPP
 #define RAFTRINGBUFFERTYPES_HPP 1
+#include <type_traits>
 
 namespace Type{
-   enum RingBufferType { Heap, 
-                         SharedMemory, 
-                         TCP, 
-                         Infinite, 
+   /**
+    * RingBufferType - each of these has a corresponding
+    * entry in Port::initializeConstMap. Heap is the default
+    * for every edge, SPSC is the same heap storage but the
+    * producer and consumer each keep a private copy of the
+    * other side's index so that the shared pointers are only
+    * read when the cached copy says full (producer) or empty
+    * (consumer). Mirrored is again the heap implementation but
+    * the store is mapped twice back to back (see mirrormem.hpp),
+    * so any range of items is contiguous in memory.
+    * Infinite never blocks the producer, items go into a linked
+    * list of segments that grows as needed (the buffer size given
+    * for the edge is the number of items per segment).
+    * FanIn lets several producers link to one input port, each
+    * gets its own Heap ring and the consumer reads from all of
+    * them through a FanIn (see fanin.hpp).
+    * Broadcast is the other way round, one output port linked to
+    * several input ports, all of which see every item from a 
+    * single shared store (see broadcast.tcc).
+    */
+   enum RingBufferType { Heap,
+                         SharedMemory,
+                         TCP,
+                         Infinite,
+                         SPSC,
+                         Mirrored,
+                         FanIn,
+                         Broadcast,
                          N };
+
+   /**
+    * heap_backed - true for the types that share the
+    * Buffer::Data< T, Type::Heap > storage and the heap
+    * implementation in ringbufferheap.tcc.
+    */
+   template < RingBufferType type > struct heap_backed :
+      std::integral_constant< bool, type == Heap || type == SPSC || type == Mirrored >{};
 }
-   
+
    enum Direction { Producer, Consumer };
 #endif
@@ -0,0 +1,129 @@
+/**
+ * ringspan.hpp - raw views of items sitting in a ring buffer's
+ * store. A range of n items starting at some index can wrap past
+ * the end of the store, so it's handed out as at most two
+ * contiguous spans, the first runs from the index to either the
+ * end of the range or the end of the store, the second (possibly
+ * empty) picks up at the start of the store.
+ * @author: agent
+ * @version: Fri Oct 16 22:21:21 2026
+ *
+ * Copyright 2026 agent
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at:
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef RAFTRINGSPAN_HPP
+#define RAFTRINGSPAN_HPP  1
+#include <cstddef>
+#include <cassert>
+
+namespace raft
+{
+
+template < class T > struct span
+{
+   constexpr span() noexcept = default;
+
+   constexpr span( T * const ptr, const std::size_t length ) noexcept :
+      ptr( ptr ),
+      length( length )
+   {}
+
+   T* begin() const noexcept
+   {
+      return( ptr );
+   }
+
+   T* end() const noexcept
+   {
+      return( ptr + length );
+   }
+
+   T& operator []( const std::size_t index ) const noexcept
+   {
+      assert( index < length );
+      return( ptr[ index ] );
+   }
+
+   std::size_t size() const noexcept
+   {
+      return( length );
+   }
+
+   bool empty() const noexcept
+   {
+      return( length == 0 );
+   }
+
+   T           *ptr     = nullptr;
+   std::size_t  length  = 0;
+};
+
+template < class T > struct span_pair
+{
+   constexpr span_pair() noexcept = default;
+
+   /**
+    * span_pair - split the n items starting at index
+    * of a store that is cap items long (twice the queue 
+    * capacity for a mirrored store, which never splits).
+    * @param   store - T* const, start of the store
+    * @param   cap   - const std::size_t, store length
+    * @param   index - const std::size_t, index of first item
+    * @param   n     - const std::size_t, number of items
+    */
+   span_pair( T * const store,
+              const std::size_t cap,
+              const std::size_t index,
+              const std::size_t n ) noexcept
+   {
+      assert( index < cap || n == 0 );
+      assert( n <= cap );
+      const std::size_t to_end( cap - index );
+      if( n <= to_end )
+      {
+         first  = span< T >( store + index, n );
+      }
+      else
+      {
+         first  = span< T >( store + index, to_end );
+         second = span< T >( store, n - to_end );
+      }
+   }
+
+   /**
+    * operator [] - index across both spans, slower than
+    * looping over first then second but handy.
+    */
+   T& operator []( const std::size_t index ) const noexcept
+   {
+      return( index < first.length ? first.ptr[ index ] :
+                                     second[ index - first.length ] );
+   }
+
+   std::size_t size() const noexcept
+   {
+      return( first.length + second.length );
+   }
+
+   bool contiguous() const noexcept
+   {
+      return( second.empty() );
+   }
+
+   span< T > first;
+   span< T > second;
+};
+
+} /** end namespace raft **/
+#endif /* END RAFTRINGSPAN_HPP */
@@ -24,11 +24,13 @@
 #include "systemsignalhandler.hpp"
 #include "rafttypes.hpp"
 #include <set>
+#include <vector>
 #include "kernelkeeper.tcc"
 #include "defs.hpp"
 
 namespace raft {
    class kernel;
+   class kernel_batch;
    class map;
 }
 
@@ -57,6 +59,13 @@ public:
     */
    virtual void start() = 0;
 
+   /**
+    * runs_fused - true if start() runs each fused chain on one
+    * thread (see MapBase::set_fusion), exe() only fuses the
+    * map for schedulers that do.
+    */
+   static constexpr bool runs_fused = false;
+
   
    /** 
     * init - call to pre-process all kernels, this function
@@ -78,6 +87,18 @@ public:
    static bool kernelRun( raft::kernel * const kernel,
                           volatile bool       &finished );
 
+   /**
+    * batchRun - kernelRun for a raft::kernel_batch, counts
+    * what's queued on each input port once and hands the counts
+    * to run_batch(). Checks whether the kernel is done only
+    * when nothing was queued.
+    * @param   kernel - raft::kernel_batch* const
+    * @param   finished - volatile bool&, set true when done
+    * @return  true
+    */
+   static bool batchRun( raft::kernel_batch * const kernel,
+                         volatile bool             &finished );
+
    //TODO, get rid of jmp_buf, no longer needed 
    /**
     * scheduleKernel - adds the kernel "kernel" to the
@@ -93,6 +114,28 @@ public:
     * @param kernel - raft::kernel*
     */
    virtual void scheduleKernel( raft::kernel * const kernel );
+
+   /**
+    * gc_counters - fifo_gc totals over all scheduler threads,
+    * counts only, nothing here is timed. runs_without_gc are 
+    * kernel runs after which fifo_gc wasn't called since none
+    * of the kernel's ports carry externally allocated types,
+    * items_reclaimed the items fifo_gc gave back.
+    */
+   struct gc_counters
+   {
+      std::uint64_t runs_with_gc    = 0;
+      std::uint64_t runs_without_gc = 0;
+      std::uint64_t items_reclaimed = 0;
+   };
+
+   /**
+    * get_gc_counters - totals as of the last scheduler thread
+    * to exit, each thread adds its own counts when it's done.
+    * @return gc_counters
+    */
+   static gc_counters get_gc_counters() noexcept;
+
 protected:
    virtual void handleSchedule( raft::kernel * const kernel ) = 0; 
    /**
@@ -126,6 +169,45 @@ protected:
    
    static void invalidateOutputPorts( raft::kernel *kernel );
 
+   /**
+    * flushPorts - publish everything the kernel has written
+    * to (read from) batched edges, called when it goes idle.
+    * flushDuePorts only publishes writes that have been held
+    * longer than the latency bound of their edge.
+    * @param kernel - raft::kernel*
+    */
+   static void flushPorts( raft::kernel *kernel );
+   static void flushDuePorts( raft::kernel *kernel );
+
+   /**
+    * fusedChain - the kernels a thread started for kernel runs,
+    * kernel and then the rest of its fused chain in order (see
+    * MapBase::set_fusion), or just kernel if it isn't fused.
+    * Only call from the thread that runs them, the FIFOs 
+    * between them are marked as having both ends on one 
+    * thread (FIFO::set_fused).
+    * @param kernel - raft::kernel* const, head of the chain
+    * @return std::vector< raft::kernel* >
+    */
+   static std::vector< raft::kernel* > fusedChain( raft::kernel * const kernel );
+
+   /**
+    * runByChain - true if kernel is on a fused chain behind
+    * another kernel and so is run by that kernel's thread.
+    * @param kernel - raft::kernel* const
+    * @return bool
+    */
+   static bool runByChain( raft::kernel * const kernel ) noexcept;
+
+   /**
+    * fusedOutputFull - true if the FIFO to the next kernel of
+    * the chain has no room, the chain should run that one 
+    * before this one again, and not before.
+    * @param kernel - raft::kernel* const, on a fused chain
+    * @return bool
+    */
+   static bool fusedOutputFull( raft::kernel * const kernel );
+
    /** 
     * kernelHasInputData - check each input port for available
     * data, returns true if any of the input ports has available
@@ -159,19 +241,37 @@ protected:
     * ones to be put in these sets, need to be "garbage
     * collected"
     * @param kernel - raft::kernel* the one we're registering
-    * @param in     - set_t*, the input set
-    * @param out    - set_t*, the output set
-    * @return void
+    * @param in     - ptr_map_t*, the input list
+    * @param out    - ptr_set_t*, the output list
+    * @return bool  - true if any port of the kernel can put
+    *                 items on these lists, if false fifo_gc
+    *                 never needs to be called for it.
     */
-   static void setPtrSets( raft::kernel * const kernel,
+   static bool setPtrSets( raft::kernel * const kernel,
                            ptr_map_t    * const in,
                            ptr_set_t    * const out,
                            ptr_set_t    * const peekset );
 
-   
-   static void fifo_gc( ptr_map_t * const in,
-                        ptr_set_t * const out,
-                        ptr_set_t * const peekset );
+   /**
+    * fifo_gc - free every item recycled by the kernel (in)
+    * that it didn't forward on to an output port (out), then
+    * clear all three lists.
+    * @return std::size_t - number of items freed
+    */
+   static std::size_t fifo_gc( ptr_map_t * const in,
+                               ptr_set_t * const out,
+                               ptr_set_t * const peekset );
+
+   /** initial capacity of each of the setPtrSets lists **/
+   static constexpr std::size_t gc_reserve = 64;
+
+   /**
+    * add_gc_counters - called by each scheduler thread
+    * on exit with its local counts.
+    * @param   local - const gc_counters&
+    */
+   static void add_gc_counters( const gc_counters &local ) noexcept;
+
    /**
     * signal handlers
     */
@@ -0,0 +1,156 @@
+/**
+ * signalqueue.hpp - sparse side queue for the signals of a
+ * heap backed ring. Almost every item goes through with
+ * raft::none, so instead of reading and writing a signal slot
+ * for every item the producer only records the others here,
+ * tagged with the position (sequence number) of their item.
+ * The consumer checks for an entry matching the item it's
+ * reading, which costs a load of a line that only changes
+ * when a signal is sent. Each signal is in exactly one place,
+ * only the ones that don't fit here go to a per slot array
+ * the buffer allocates the first time that happens.
+ * @author: agent
+ * @version: Fri Oct 16 23:47:16 2026
+ *
+ * Copyright 2026 agent
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at:
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef RAFTSIGNALQUEUE_HPP
+#define RAFTSIGNALQUEUE_HPP  1
+#include <atomic>
+#include <cstdint>
+#include <cstddef>
+#include "defs.hpp"
+#include "internaldefs.hpp"
+#include "signalvars.hpp"
+
+/**
+ * SIGNAL_QUEUE_SIZE - number of signals a ring can have in
+ * flight in its side queue, must be a power of two. Once it's
+ * full the producer records further signals in their slot 
+ * instead and the consumer reads slots till it's past them.
+ */
+#ifndef SIGNAL_QUEUE_SIZE
+#define SIGNAL_QUEUE_SIZE 64
+#endif
+
+namespace Buffer
+{
+
+class SignalQueue
+{
+public:
+   SignalQueue() = default;
+
+   struct entry
+   {
+      std::uint64_t seq = 0;
+      raft::signal  sig = raft::none;
+   };
+
+   /**
+    * push - producer only, record sig for the item at position
+    * seq, positions have to be pushed in increasing order.
+    * @param   seq - const std::uint64_t
+    * @param   sig - const raft::signal
+    * @return  bool - false if full, nothing was recorded, write
+    *          the slot and call overflow( seq )
+    */
+   bool push( const std::uint64_t seq, const raft::signal sig ) noexcept
+   {
+      const auto t( tail.load( std::memory_order_relaxed ) );
+      if( R_UNLIKELY( t - head.load( std::memory_order_acquire ) == SIGNAL_QUEUE_SIZE ) )
+      {
+         return( false );
+      }
+      entries[ t & mask ].seq = seq;
+      entries[ t & mask ].sig = sig;
+      tail.store( t + 1, std::memory_order_release );
+      return( true );
+   }
+
+   /**
+    * overflow - producer only, the signal for position seq
+    * is in its slot, call once the slot is written.
+    * @param   seq - const std::uint64_t
+    */
+   void overflow( const std::uint64_t seq ) noexcept
+   {
+      overflow_end.store( seq + 1, std::memory_order_release );
+   }
+
+   /**
+    * pending - true if any signal sent at or after position
+    * from hasn't been taken yet, consumer side.
+    * @param   from - const std::uint64_t, read position
+    * @return  bool
+    */
+   bool pending( const std::uint64_t from ) const noexcept
+   {
+      return( tail.load( std::memory_order_acquire ) !=
+                  head.load( std::memory_order_relaxed ) ||
+              overflowed( from ) );
+   }
+
+   /**
+    * overflowed - true if some signal at or after position
+    * from is only in its slot, consumer side.
+    * @param   from - const std::uint64_t
+    * @return  bool
+    */
+   bool overflowed( const std::uint64_t from ) const noexcept
+   {
+      return( overflow_end.load( std::memory_order_acquire ) > from );
+   }
+
+   /**
+    * front - consumer side, sets e to the oldest entry not
+    * yet taken, offset entries in.
+    * @param   e - entry&
+    * @param   offset - const std::size_t
+    * @return  bool - false if there aren't that many
+    */
+   bool front( entry &e, const std::size_t offset = 0 ) const noexcept
+   {
+      const auto h( head.load( std::memory_order_relaxed ) + offset );
+      if( h == tail.load( std::memory_order_acquire ) )
+      {
+         return( false );
+      }
+      e = entries[ h & mask ];
+      return( true );
+   }
+
+   /** pop_front - consumer side, drop the entry front returned **/
+   void pop_front() noexcept
+   {
+      head.store( head.load( std::memory_order_relaxed ) + 1,
+                  std::memory_order_release );
+   }
+
+private:
+   static constexpr std::size_t mask = SIGNAL_QUEUE_SIZE - 1;
+   static_assert( ( SIGNAL_QUEUE_SIZE & mask ) == 0,
+                  "SIGNAL_QUEUE_SIZE must be a power of two" );
+
+   /** producer's line **/
+   ALIGN( L1D_CACHE_LINE_SIZE ) std::atomic< std::uint64_t > tail = { 0 };
+   std::atomic< std::uint64_t > overflow_end = { 0 };
+   /** consumer's line **/
+   ALIGN( L1D_CACHE_LINE_SIZE ) std::atomic< std::uint64_t > head = { 0 };
+   ALIGN( L1D_CACHE_LINE_SIZE ) entry entries[ SIGNAL_QUEUE_SIZE ];
+};
+
+} /** end namespace Buffer **/
+#endif /* END RAFTSIGNALQUEUE_HPP */
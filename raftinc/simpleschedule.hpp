@@ -37,6 +37,9 @@ public:
    virtual ~simple_schedule();
 
    virtual void start(); 
+
+   /** simple_run runs each fused chain on one thread **/
+   static constexpr bool runs_fused = true;
    
 protected:
    void handleSchedule( raft::kernel * const kernel ); 
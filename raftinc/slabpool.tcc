@@ -0,0 +1,424 @@
+/**
+ * slabpool.tcc - storage for the items of FIFOs whose type doesn't
+ * fit in a cache line (see ext_alloc in alloc_traits.tcc), the
+ * queue only holds pointers to these. Item slots are carved out of
+ * large slabs and recycled through a free list so that a push/pop
+ * pair doesn't hit malloc/free.
+ *
+ * @author: agent
+ * @version: Fri Oct 16 21:18:58 2026
+ *
+ * Copyright 2026 agent
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at:
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef RAFTSLABPOOL_TCC
+#define RAFTSLABPOOL_TCC  1
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <cerrno>
+#include <iostream>
+#include <mutex>
+#include <new>
+#include <utility>
+#include "alloc_traits.tcc"
+#include "defs.hpp"
+
+/**
+ * SLAB_POOL_SLAB_BYTES - target size of each slab, a slab always
+ * has at least SLAB_POOL_MIN_ITEMS slots no matter how big T is.
+ */
+#ifndef SLAB_POOL_SLAB_BYTES
+#define SLAB_POOL_SLAB_BYTES ( 1 << 16 )
+#endif
+
+#ifndef SLAB_POOL_MIN_ITEMS
+#define SLAB_POOL_MIN_ITEMS 4
+#endif
+
+/**
+ * SLAB_POOL_BATCH - number of free slots a thread moves to or
+ * from the shared depot at once. A thread keeps at most twice
+ * this many free slots for itself.
+ */
+#ifndef SLAB_POOL_BATCH
+#define SLAB_POOL_BATCH 32
+#endif
+
+/**
+ * SLAB_POOL_IDLE_SLABS - number of slabs with no slot in use
+ * the depot keeps for the next burst, any more are freed.
+ */
+#ifndef SLAB_POOL_IDLE_SLABS
+#define SLAB_POOL_IDLE_SLABS 2
+#endif
+
+namespace raft
+{
+
+/**
+ * slab_pool - one pool per type. Each thread keeps a private
+ * free list so the common case (allocate or release on a thread
+ * that has free slots) takes no locks. Producers and consumers
+ * are normally different threads, so released slots pile up
+ * on the consumer, once a thread's list holds more than
+ * 2 x SLAB_POOL_BATCH slots a batch goes back to the shared depot
+ * where the producer picks it up when it runs dry. New slabs are
+ * only allocated when the depot is empty too.
+ *
+ * The depot keeps its free slots on the slab they belong to (a
+ * slab is aligned to its size, so that's found from the slot's
+ * address). A slab whose slots are all back in the depot is idle,
+ * past SLAB_POOL_IDLE_SLABS of those it's freed, so a burst on an
+ * edge doesn't keep its peak memory for the rest of the run. The
+ * depot itself is never freed, a FIFO in a static map can release
+ * items after the pool would otherwise be gone.
+ */
+template < class T > class slab_pool
+{
+public:
+   slab_pool() = delete;
+
+   /**
+    * make - construct a T from params in a pooled slot.
+    * @param   params - constructor arguments for T
+    * @return  T*
+    */
+   template < class... Args >
+   static T* make( Args&&... params )
+   {
+      void * const slot( slab_pool< T >::acquire() );
+      return( new ( slot ) T( std::forward< Args >( params )... ) );
+   }
+
+   /**
+    * destroy - call the destructor of ptr and return its slot
+    * to the pool, ptr must have come from make().
+    * @param   ptr - T*
+    */
+   static void destroy( T * const ptr )
+   {
+      ptr->~T();
+      slab_pool< T >::release( ptr );
+   }
+
+   /**
+    * reclaim - same as destroy, with the signature the
+    * scheduler uses for deferred frees (recyclefunc_t).
+    * @param   ptr - void*, object made by make()
+    */
+   static void reclaim( void * const ptr )
+   {
+      slab_pool< T >::destroy( reinterpret_cast< T* >( ptr ) );
+   }
+
+   /**
+    * slabs - number of slabs allocated from the system right 
+    * now, for all threads.
+    * @return  std::size_t
+    */
+   static std::size_t slabs()
+   {
+      auto &d( depot() );
+      std::lock_guard< std::mutex > lock( d.mutex );
+      return( d.slabs );
+   }
+
+private:
+   /** free slots are linked through their first bytes **/
+   struct node
+   {
+      node *next;
+   };
+
+   static constexpr std::size_t align =
+      alignof( T ) > L1D_CACHE_LINE_SIZE ? alignof( T ) : L1D_CACHE_LINE_SIZE;
+   /** slot size, rounded up so every slot starts on a cache line **/
+   static constexpr std::size_t stride =
+      ( ( sizeof( T ) + align - 1 ) / align ) * align;
+
+   static constexpr std::size_t pow2_at_least( const std::size_t n )
+   {
+      std::size_t p( 1 );
+      while( p < n )
+      {
+         p <<= 1;
+      }
+      return( p );
+   }
+
+   /** 
+    * slab size, a power of two so the slab of a slot is its 
+    * address rounded down, the first align bytes are the header
+    */
+   static constexpr std::size_t slab_bytes =
+      pow2_at_least( SLAB_POOL_SLAB_BYTES > align + SLAB_POOL_MIN_ITEMS * stride ?
+                        SLAB_POOL_SLAB_BYTES : align + SLAB_POOL_MIN_ITEMS * stride );
+   static constexpr std::size_t slab_items = ( slab_bytes - align ) / stride;
+   static constexpr std::size_t batch = SLAB_POOL_BATCH;
+
+   static_assert( sizeof( T ) >= sizeof( node ),
+                  "slab_pool slots must be able to hold a free list link" );
+
+   /** intrusive list of free slots with its length **/
+   struct free_list
+   {
+      node        *head  = nullptr;
+      std::size_t  count = 0;
+
+      inline void push( node * const n ) noexcept
+      {
+         n->next = head;
+         head    = n;
+         count++;
+      }
+
+      inline node* pop() noexcept
+      {
+         node * const n( head );
+         head = n->next;
+         count--;
+         return( n );
+      }
+
+      /**
+       * take - move up to n slots from the front of other
+       * onto this list.
+       */
+      inline void take( free_list &other, std::size_t n ) noexcept
+      {
+         while( n-- > 0 && other.head != nullptr )
+         {
+            push( other.pop() );
+         }
+      }
+   };
+
+   /** 
+    * slab - header at the start of each slab, its slots that
+    * are in the depot, only touched with the depot locked.
+    */
+   struct slab
+   {
+      free_list    free;
+      /** slabs with free slots in the depot **/
+      slab        *prev   = nullptr;
+      slab        *next   = nullptr;
+      bool         listed = false;
+   };
+
+   static_assert( sizeof( slab ) <= align,
+                  "slab_pool slab header must fit before the first slot" );
+
+   /** shared between all threads, guarded by mutex **/
+   struct depot_t
+   {
+      std::mutex   mutex;
+      /** slabs with at least one free slot, idle ones included **/
+      slab        *head  = nullptr;
+      std::size_t  idle  = 0;
+      std::size_t  slabs = 0;
+   };
+
+   /**
+    * thread_cache - gives whatever it holds back to the depot
+    * when the thread exits so the slots aren't lost.
+    */
+   struct thread_cache : free_list
+   {
+      ~thread_cache()
+      {
+         auto &d( depot() );
+         std::lock_guard< std::mutex > lock( d.mutex );
+         give_back( d, *this, (this)->count );
+      }
+   };
+
+   static depot_t& depot()
+   {
+      /** leaked on purpose, see class comment **/
+      static depot_t * const d( new depot_t() );
+      return( *d );
+   }
+
+   static free_list& local()
+   {
+      static thread_local thread_cache cache;
+      return( cache );
+   }
+
+   static void* acquire()
+   {
+      auto &cache( local() );
+      if( R_UNLIKELY( cache.head == nullptr ) )
+      {
+         refill( cache );
+      }
+      return( cache.pop() );
+   }
+
+   static void release( void * const ptr )
+   {
+      auto &cache( local() );
+      cache.push( reinterpret_cast< node* >( ptr ) );
+      if( R_UNLIKELY( cache.count > ( batch << 1 ) ) )
+      {
+         auto &d( depot() );
+         std::lock_guard< std::mutex > lock( d.mutex );
+         give_back( d, cache, batch );
+      }
+   }
+
+   static slab* slab_of( node * const n ) noexcept
+   {
+      return( reinterpret_cast< slab* >( 
+         reinterpret_cast< std::uintptr_t >( n ) & ~( slab_bytes - 1 ) ) );
+   }
+
+   static void link( depot_t &d, slab * const s ) noexcept
+   {
+      s->prev = nullptr;
+      s->next = d.head;
+      if( d.head != nullptr )
+      {
+         d.head->prev = s;
+      }
+      d.head    = s;
+      s->listed = true;
+   }
+
+   static void unlink( depot_t &d, slab * const s ) noexcept
+   {
+      if( s->prev != nullptr )
+      {
+         s->prev->next = s->next;
+      }
+      else
+      {
+         d.head = s->next;
+      }
+      if( s->next != nullptr )
+      {
+         s->next->prev = s->prev;
+      }
+      s->listed = false;
+   }
+
+   /**
+    * give_back - move up to n slots from the front of cache to
+    * their slabs in the depot, frees slabs that become idle once
+    * the depot has enough of those. Depot must be locked.
+    */
+   static void give_back( depot_t &d, free_list &cache, std::size_t n )
+   {
+      while( n-- > 0 && cache.head != nullptr )
+      {
+         node * const slot( cache.pop() );
+         slab * const s( slab_of( slot ) );
+         s->free.push( slot );
+         if( ! s->listed )
+         {
+            link( d, s );
+         }
+         if( s->free.count < slab_items )
+         {
+            continue;
+         }
+         if( d.idle < SLAB_POOL_IDLE_SLABS )
+         {
+            d.idle++;
+            continue;
+         }
+         unlink( d, s );
+         release_slab( d, s );
+      }
+   }
+
+   static void release_slab( depot_t &d, slab * const s ) noexcept
+   {
+      s->~slab();
+#if (defined _WIN64 ) || (defined _WIN32)
+      _aligned_free( s );
+#else
+      free( s );
+#endif
+      d.slabs--;
+   }
+
+   /**
+    * refill - pull a batch from the depot, if it's empty
+    * carve up a new slab first.
+    */
+   static void refill( free_list &cache )
+   {
+      auto &d( depot() );
+      std::lock_guard< std::mutex > lock( d.mutex );
+      if( d.head == nullptr )
+      {
+         link( d, new_slab( d ) );
+      }
+      while( cache.count < batch && d.head != nullptr )
+      {
+         slab * const s( d.head );
+         if( s->free.count == slab_items )
+         {
+            d.idle--;
+         }
+         cache.take( s->free, batch - cache.count );
+         if( s->free.head == nullptr )
+         {
+            unlink( d, s );
+         }
+      }
+   }
+
+   /** new_slab - all its slots are free, so it starts out idle **/
+   static slab* new_slab( depot_t &d )
+   {
+      void *mem( nullptr );
+#if (defined __linux ) || (defined __APPLE__ )
+      const auto ret_val( posix_memalign( &mem, slab_bytes, slab_bytes ) );
+      if( ret_val != 0 )
+      {
+         std::cerr << "posix_memalign returned error code (" << ret_val << ")";
+         std::cerr << " with message: \n" << strerror( ret_val ) << "\n";
+         throw std::bad_alloc();
+      }
+#elif (defined _WIN64 ) || (defined _WIN32)
+      mem = _aligned_malloc( slab_bytes, slab_bytes );
+#else
+      mem = aligned_alloc( slab_bytes, slab_bytes );
+#endif
+      if( mem == nullptr )
+      {
+         throw std::bad_alloc();
+      }
+      auto * const s( new ( mem ) slab() );
+      auto * const base( reinterpret_cast< char* >( mem ) + align );
+      /** push in reverse so the slab is handed out front to back **/
+      for( std::size_t i( slab_items ); i > 0; i-- )
+      {
+         s->free.push( reinterpret_cast< node* >( base + ( ( i - 1 ) * stride ) ) );
+      }
+      d.slabs++;
+      /** till refill takes from it, right away **/
+      d.idle++;
+      return( s );
+   }
+};
+
+} /** end namespace raft **/
+
+#endif /* END RAFTSLABPOOL_TCC */
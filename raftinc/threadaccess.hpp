@@ -19,7 +19,9 @@
  */
 #ifndef RAFTTHREADACCESS_HPP
 #define RAFTTHREADACCESS_HPP  1
+#include <atomic>
 #include <cstdint>
+#include <climits>
 #include "defs.hpp"
 #include "internaldefs.hpp"
 
@@ -42,37 +44,128 @@ enum access_key : key_t { allocate       = 0,
                           peek           = 6, 
                           size           = 7,
                           N };
+
+/**
+ * side - returns the index of the endpoint (0 - producer,
+ * 1 - consumer) that uses the access key.
+ * @param   key - const access_key
+ * @return  std::size_t
+ */
+constexpr std::size_t side( const access_key key ) noexcept
+{
+   return( key <= push ? 0 : 1 );
+}
+
+/**
+ * holds - returns true if the access key leaves the caller
+ * holding a reference into the buffer after the call returns,
+ * i.e., allocate until send, peek until recycle/unpeek.
+ * @param   key - const access_key
+ * @return  bool
+ */
+constexpr bool holds( const access_key key ) noexcept
+{
+   return( key == allocate || key == allocate_range || key == peek );
+}
+
 }
 
+/**
+ * ThreadAccess - per thread record for the resize protocol in
+ * DataManager. Each thread that touches a FIFO gets one (see
+ * local()), on its own cache line. A resizer publishes a new
+ * global epoch with request(), every thread acknowledges the
+ * newest epoch it has seen the next time it enters any FIFO,
+ * at which point it can't be in the middle of an access to any
+ * other FIFO. References held across calls (allocate, peek) are
+ * tracked per port in DataManager. With no resize pending the
+ * only stores are the held bits for allocate and peek, on the
+ * caller's own cache line.
+ */
 struct ALIGN( L1D_CACHE_LINE_SIZE ) ThreadAccess
 {
     ThreadAccess() = default;
 
-    constexpr ThreadAccess( const ThreadAccess  &other )
+    /**
+     * local - returns the calling thread's record, the record
+     * is marked offline when the thread exits and is never
+     * freed so that DataManager can keep a pointer to it.
+     * @return  ThreadAccess&
+     */
+    static ThreadAccess& local() noexcept;
+
+    /**
+     * request - called by a resizer, starts a new epoch.
+     * @return  std::uint64_t - the new epoch
+     */
+    static std::uint64_t request() noexcept;
+
+    /**
+     * quiesce - call at a point where the calling thread is not
+     * in the middle of a FIFO access, acknowledges the current
+     * epoch if it hasn't been already.  Only loads with no 
+     * resize pending.
+     */
+    inline void quiesce() noexcept
     {
-        (this)->whole = other.whole;
+        const auto epoch( global_epoch.load( std::memory_order_acquire ) );
+        const auto last( acked.load( std::memory_order_relaxed ) );
+        if( R_UNLIKELY( epoch != last ) )
+        {
+            if( last == offline )
+            {
+                /**
+                 * coming back online, a resizer may have read
+                 * offline and let us through already. Our store
+                 * has to be visible before the caller looks at 
+                 * the resize flag in notResizing(), otherwise 
+                 * the two can pass each other (see passed()).
+                 */
+                acked.store( epoch, std::memory_order_seq_cst );
+                std::atomic_thread_fence( std::memory_order_seq_cst );
+            }
+            else
+            {
+                acked.store( epoch, std::memory_order_release );
+            }
+        }
     }
-    
-    constexpr ThreadAccess& operator = (const ThreadAccess &other ) noexcept
+
+    /**
+     * go_offline - call before the thread blocks for a while
+     * (e.g., parked in raft::wait::backoff) while not in the 
+     * middle of a FIFO access, counts as having passed every
+     * epoch till the next quiesce() call.
+     */
+    inline void go_offline() noexcept
     {
-        /** ignore the case of 'this' == other **/
-        (this)->whole = other.whole;
-        return( *this );
+        acked.store( offline, std::memory_order_release );
     }
-    
-    /** 
-     * technically not needed but this makes debugging
-     * a bit easier. - jcb July 2019
-     */
-    ~ThreadAccess(){ (this)->whole = 0; }
 
-    union
+    /**
+     * passed - returns true if this thread has acknowledged
+     * epoch, or has exited.
+     * @param   epoch - const std::uint64_t
+     * @return  bool
+     */
+    inline bool passed( const std::uint64_t epoch ) noexcept
     {
-        std::uint64_t whole = 0;
-        dm::key_t     flag[ 8 ];
-    };
+        /** 
+         * seq_cst, pairs with the resize flag store before 
+         * request() and the fence in quiesce() 
+         */
+        return( acked.load( std::memory_order_seq_cst ) >= epoch );
+    }
 
+    /** acked value for a thread that has exited **/
+    static constexpr std::uint64_t offline = UINT64_MAX;
+
+    /** last epoch this thread acknowledged **/
+    std::atomic< std::uint64_t > acked = { 0 };
+    
     raft::byte_t    padding[ L1D_CACHE_LINE_SIZE - 8 /** padd to cache line **/ ]   = {};
+
+    static std::atomic< std::uint64_t > global_epoch;
 };
 
 
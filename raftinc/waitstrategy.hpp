@@ -0,0 +1,177 @@
+/**
+ * waitstrategy.hpp - how a FIFO endpoint waits when the queue
+ * is full (producer) or empty (consumer). Every strategy starts
+ * out spinning with pause, spin keeps doing that, spin_yield
+ * gives up the core with raft::yield() after WAIT_SPIN_LIMIT
+ * tries, and park goes to sleep on a futex till the other end
+ * of the queue publishes something (or WAIT_PARK_TIMEOUT_US goes
+ * by). The other end only makes the wake system call if somebody
+ * is actually parked, so a busy queue doesn't pay for it.
+ * @author: agent
+ * @version: Fri Oct 16 22:51:38 2026
+ * 
+ * Copyright 2026 agent
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at:
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef RAFTWAITSTRATEGY_HPP
+#define RAFTWAITSTRATEGY_HPP  1
+#include <atomic>
+#include <cstdint>
+#include "defs.hpp"
+#include "internaldefs.hpp"
+#include "sysschedutil.hpp"
+#include "threadaccess.hpp"
+
+/**
+ * WAIT_SPIN_LIMIT - number of pause/retry rounds before
+ * spin_yield and park stop spinning.
+ */
+#ifndef WAIT_SPIN_LIMIT
+#define WAIT_SPIN_LIMIT 128
+#endif
+
+/**
+ * WAIT_PARK_TIMEOUT_US - longest a parked endpoint sleeps
+ * before checking the queue again on its own, only matters
+ * if a wake up is missed (e.g., the queue was resized while
+ * we were asleep), normally the other end wakes us.
+ */
+#ifndef WAIT_PARK_TIMEOUT_US
+#define WAIT_PARK_TIMEOUT_US 50000
+#endif
+
+namespace raft
+{
+
+namespace wait
+{
+
+enum strategy : std::uint8_t { spin,
+                               spin_yield,
+                               park,
+                               /** 
+                                * for MapBase::link only, use the map's 
+                                * default (see MapBase::set_wait).
+                                */
+                               inherit };
+
+/**
+ * spot - where the endpoint waiting on one direction of a 
+ * FIFO parks. seq is the futex word, bumped on each wake so
+ * a sleeper that read it before the wake won't go to sleep.
+ */
+struct ALIGN( L1D_CACHE_LINE_SIZE ) spot
+{
+   /**
+    * notify - call after publishing (the write or read
+    * position), wakes the other end if it's parked. The
+    * fence pairs with the one in backoff::idle, either we
+    * see parked != 0 or the waiter sees what we published.
+    */
+   inline void notify() noexcept
+   {
+      std::atomic_thread_fence( std::memory_order_seq_cst );
+      if( R_UNLIKELY( parked.load( std::memory_order_relaxed ) != 0 ) )
+      {
+         wake();
+      }
+   }
+
+   /** wake - unconditional, wakes every sleeper **/
+   void wake() noexcept;
+   
+   /**
+    * sleep - blocks till the next wake() or the timeout,
+    * returns straight away if seq has moved past expected.
+    * @param   expected - const std::uint32_t, seq before
+    *          the caller last checked the queue
+    */
+   void sleep( const std::uint32_t expected ) noexcept;
+
+   std::atomic< std::uint32_t > seq     = { 0 };
+   std::atomic< std::uint32_t > parked  = { 0 };
+};
+
+/**
+ * single_core - true if there's only one hardware thread, 
+ * then spinning only burns the time slice the other end of 
+ * the queue needs, so spin_yield and park skip straight
+ * to yielding/parking.
+ */
+bool single_core() noexcept;
+
+/**
+ * backoff - state for one blocking call, construct before
+ * the retry loop and call idle() each time the queue isn't
+ * ready.
+ */
+class backoff
+{
+public:
+   backoff( const strategy s, spot &where ) noexcept : s( s ),
+                                                      where( where ),
+      spins( single_core() ? WAIT_SPIN_LIMIT : 0 )
+   {}
+
+   /**
+    * idle - wait a bit, ready is only called when we're 
+    * about to park and must return true if the queue is now
+    * ready (or closed) so that we don't sleep through it.
+    * @param   ready - F&&, bool()
+    */
+   template < class F > void idle( F &&ready )
+   {
+      if( s == spin || spins < WAIT_SPIN_LIMIT )
+      {
+         spins++;
+#if __x86_64
+         __asm__ volatile("\
+           pause"
+           :
+           :
+           : );
+#endif
+         return;
+      }
+      if( s != park )
+      {
+         raft::yield();
+         return;
+      }
+      const auto seq( where.seq.load( std::memory_order_acquire ) );
+      where.parked.fetch_add( 1, std::memory_order_relaxed );
+      std::atomic_thread_fence( std::memory_order_seq_cst );
+      if( ! ready() )
+      {
+         /** 
+          * not holding anything from a FIFO, don't make a 
+          * resize wait on us, the next enterBuffer brings 
+          * this thread back.
+          */
+         ThreadAccess::local().go_offline();
+         where.sleep( seq );
+      }
+      where.parked.fetch_sub( 1, std::memory_order_relaxed );
+   }
+
+private:
+   const strategy    s;
+   spot             &where;
+   std::uint32_t     spins = 0;
+};
+
+} /** end namespace wait **/
+
+} /** end namespace raft **/
+#endif /* END RAFTWAITSTRATEGY_HPP */
@@ -57,21 +57,53 @@ public:
                             "avail_data size must be unsigned" );
             if( avail_data != 0 )
             {
-                auto alldata( port.template peek_range< T >( avail_data ) );
-
-                using index_type = std::remove_const_t<decltype(avail_data)>;
-                for( index_type index( 0 ); index < avail_data; index++ )
-                {
-                   (*inserter) = alldata[ index ].ele;
-                   /** hope the iterator defined overloaded ++ **/
-                   ++inserter;
-                }
-                port.recycle( avail_data  );
+                write_range< T >( port, avail_data );
             }
         }
         return( raft::proceed );
     }
 private:
+    /**
+     * write_range - inline types are copied straight out of the
+     * queue's store, at most two contiguous runs.
+     */
+    template < class U,
+               typename std::enable_if< 
+                  inline_alloc< U >::value >::type* = nullptr >
+    void write_range( FIFO &port, const std::size_t avail_data )
+    {
+        const auto alldata( port.template peek_span< U >( avail_data ) );
+        for( const auto &item : alldata.first )
+        {
+           (*inserter) = item;
+           /** hope the iterator defined overloaded ++ **/
+           ++inserter;
+        }
+        for( const auto &item : alldata.second )
+        {
+           (*inserter) = item;
+           ++inserter;
+        }
+        port.unpeek();
+        port.recycle( avail_data );
+    }
+
+    template < class U,
+               typename std::enable_if< 
+                  ext_alloc< U >::value >::type* = nullptr >
+    void write_range( FIFO &port, const std::size_t avail_data )
+    {
+        auto alldata( port.template peek_range< U >( avail_data ) );
+        using index_type = std::remove_const_t<decltype(avail_data)>;
+        for( index_type index( 0 ); index < avail_data; index++ )
+        {
+           (*inserter) = alldata[ index ].ele;
+           /** hope the iterator defined overloaded ++ **/
+           ++inserter;
+        }
+        port.recycle( avail_data  );
+    }
+
     BackInsert inserter;
 };
 
@@ -23,14 +23,18 @@
 #include "fifo.hpp"
 
 #include "allocate.hpp"
+#include "fanin.hpp"
+#include "broadcast.tcc"
 #include "port_info.hpp"
 #include "map.hpp"
 #include "portexception.hpp"
+#include "placemem.hpp"
 
 Allocate::Allocate( raft::map &map, volatile bool &exit_alloc ) :
    source_kernels( map.source_kernels ),
    all_kernels(    map.all_kernels ),
-   exit_alloc( exit_alloc )
+   exit_alloc( exit_alloc ),
+   default_wait( map.default_wait )
 {
 }
 
@@ -62,32 +66,144 @@ Allocate::initialize( PortInfo * const src,
    assert( fifo != nullptr );
    assert( dst  != nullptr );
    assert( src  != nullptr );
+   if( src->buffer_type == Type::Broadcast )
+   {
+      broadcast( src, dst, fifo );
+      return;
+   }
    if( src->getFIFO() != nullptr )
    {
       throw PortDoubleInitializeException(
          "Source port \"" + src->my_name + "\" already initialized!" );
    }
+   if( src->buffer_type == Type::FanIn )
+   {
+      fan_in( src, dst, fifo );
+      return;
+   }
    if( dst->getFIFO() !=  nullptr )
    {
       throw PortDoubleInitializeException(
          "Destination port \"" + dst->my_name +  "\" already initialized!" );
    }
+   fifo->set_wait_strategy( src->wait != raft::wait::inherit ? 
+                               src->wait : default_wait );
+   set_batch( src, dst, fifo );
+   set_placement( src, dst, fifo );
    src->setFIFO( fifo );
    dst->setFIFO( fifo );
    /** NOTE: this list simply speeds up the monitoring if we want it **/
    allocated_fifo.insert( fifo );
 }
 
+void
+Allocate::fan_in( PortInfo * const src,
+                  PortInfo * const dst,
+                  FIFO * const fifo )
+{
+   const auto wait( src->wait != raft::wait::inherit ? 
+                       src->wait : default_wait );
+   if( dst->getFIFO() == nullptr )
+   {
+      FIFO * const merge( FanIn::make_new_fifo( 0, 0, nullptr ) );
+      merge->set_wait_strategy( wait );
+      dst->setFIFO( merge );
+      allocated_fifo.insert( merge );
+   }
+   auto * const merge( dynamic_cast< FanIn* >( dst->getFIFO() ) );
+   if( merge == nullptr )
+   {
+      throw PortDoubleInitializeException(
+         "Destination port \"" + dst->my_name +  
+            "\" already initialized with a FIFO that isn't Type::FanIn!" );
+   }
+   fifo->set_wait_strategy( wait );
+   set_batch( src, dst, fifo );
+   set_placement( src, dst, fifo );
+   merge->add_source( fifo );
+   src->setFIFO( fifo );
+   allocated_fifo.insert( fifo );
+}
+
+void
+Allocate::broadcast( PortInfo * const src,
+                     PortInfo * const dst,
+                     FIFO * const fifo )
+{
+   if( src->getFIFO() == nullptr )
+   {
+      fifo->set_wait_strategy( src->wait != raft::wait::inherit ? 
+                                  src->wait : default_wait );
+      src->setFIFO( fifo );
+      allocated_fifo.insert( fifo );
+   }
+   else if( src->getFIFO() != fifo )
+   {
+      throw PortDoubleInitializeException(
+         "Source port \"" + src->my_name + "\" already initialized!" );
+   }
+   if( dst->getFIFO() !=  nullptr )
+   {
+      throw PortDoubleInitializeException(
+         "Destination port \"" + dst->my_name +  "\" already initialized!" );
+   }
+   auto * const shared( dynamic_cast< BroadcastBase* >( fifo ) );
+   assert( shared != nullptr );
+   /** reader is owned by the producer's FIFO **/
+   FIFO * const reader( shared->add_reader() );
+   reader->set_wait_strategy( src->wait != raft::wait::inherit ? 
+                                 src->wait : default_wait );
+   dst->setFIFO( reader );
+}
+
+void
+Allocate::set_batch( PortInfo * const src,
+                     PortInfo * const dst,
+                     FIFO * const fifo )
+{
+   if( src->batch.items == 0 )
+   {
+      return;
+   }
+   fifo->set_batch( src->batch );
+   src->my_kernel->batched_ports = true;
+   dst->my_kernel->batched_ports = true;
+}
+
+void
+Allocate::set_placement( PortInfo * const src,
+                         PortInfo * const dst,
+                         FIFO * const fifo )
+{
+   auto place( src->place );
+   if( place.policy == raft::numa::consumer )
+   {
+      /** partitioning is done before allocation, core is set if any **/
+      place.node = raft::placemem::node_of( 
+         static_cast< int >( dst->my_kernel->getCoreAssignment() ) );
+   }
+   if( place.is_default() )
+   {
+      return;
+   }
+   fifo->set_placement( place );
+}
+
 
 void
 Allocate::allocate( PortInfo &a, PortInfo &b, void *data )
 {
    UNUSED( data );
    FIFO *fifo( nullptr );
-   auto &func_map( a.const_map[ Type::Heap ] );
+   auto &func_map( a.const_map[ a.buffer_type ] );
    auto test_func( (*func_map)[ false ] );
 
-   if( a.existing_buffer != nullptr )
+   if( a.buffer_type == Type::Broadcast && a.getFIFO() != nullptr )
+   {
+      /** one store for every destination of a broadcast edge **/
+      fifo = a.getFIFO();
+   }
+   else if( a.existing_buffer != nullptr )
    {
       fifo = test_func( a.nitems,
                         a.start_index,
@@ -96,9 +212,9 @@ Allocate::allocate( PortInfo &a, PortInfo &b, void *data )
    else
    {
       /** if fixed buffer size, use that, else use INITIAL_ALLOC_SIZE **/
-      const auto alloc_size( 
+      const auto alloc_size( capacity_for( 
          a.fixed_buffer_size != 0 ? a.fixed_buffer_size : INITIAL_ALLOC_SIZE 
-      );
+      ) );
       fifo = test_func( alloc_size            /* items */,
                         ALLOC_ALIGN_WIDTH     /* align */,
                         nullptr );
@@ -106,3 +222,14 @@ Allocate::allocate( PortInfo &a, PortInfo &b, void *data )
    initialize( &a, &b, fifo );
    return;
 }
+
+std::size_t
+Allocate::capacity_for( const std::size_t n ) noexcept
+{
+   std::size_t cap( 1 );
+   while( cap < n )
+   {
+      cap <<= 1;
+   }
+   return( cap );
+}
@@ -22,10 +22,12 @@
 #include <iostream>
 #include <iomanip>
 #include <map>
+#include <algorithm>
 #include <cassert>
 
 #include "graphtools.hpp"
 #include "dynalloc.hpp"
+#include "map.hpp"
 
 #ifndef INITIAL_ALLOC_SIZE
 #warn   "Initial alloc size must be defined in allocate.hpp"
@@ -34,7 +36,8 @@
 
 dynalloc::dynalloc( raft::map &map,
                     volatile bool &exit_alloc ) :
-                        Allocate( map, exit_alloc )
+                        Allocate( map, exit_alloc ),
+                        shrink( map.shrink )
 {
 }
 
@@ -61,6 +64,18 @@ dynalloc::hash( PortInfo &a, PortInfo &b )
 }
 
 
+std::size_t
+dynalloc::footprint() const noexcept
+{
+   return( curr_footprint.load( std::memory_order_relaxed ) );
+}
+
+std::size_t
+dynalloc::peak_footprint() const noexcept
+{
+   return( max_footprint.load( std::memory_order_relaxed ) );
+}
+
 void
 dynalloc::run()
 {
@@ -75,16 +90,58 @@ dynalloc::run()
    GraphTools::BFS( container, alloc_func );
    (this)->source_kernels.release();
    (this)->setReady();
-   std::map< std::size_t, int > size_map;
+   std::map< std::size_t, edge_stats > stats_map;
+   std::size_t pass_footprint( 0 );
+
+   /** 
+    * a broadcast edge is visited once per destination but there's
+    * only the one store, which isn't resizable anyway.
+    */
+   auto first_visit = []( PortInfo &a, PortInfo &b ) -> bool
+   {
+      return( a.buffer_type != Type::Broadcast || 
+              b.my_kernel == a.other_kernel );
+   };
+
+   auto foot_func = [&]( PortInfo &a, PortInfo &b, void *data ) -> void
+   {
+      (void) data;
+      if( first_visit( a, b ) )
+      {
+         pass_footprint += a.getFIFO()->footprint();
+      }
+   };
+
+   auto record_footprint = [&]()
+   {
+      pass_footprint = 0;
+      auto &container( (this)->source_kernels.acquire() );
+      GraphTools::BFS( container, foot_func );
+      (this)->source_kernels.release();
+      curr_footprint.store( pass_footprint, std::memory_order_relaxed );
+      if( pass_footprint > max_footprint.load( std::memory_order_relaxed ) )
+      {
+         max_footprint.store( pass_footprint, std::memory_order_relaxed );
+      }
+   };
 
    /**
     * make this a fixed quantity right now, if size > .75% at
     * montor interval three times or more then increase size.
+    * If the occupancy stays under shrink.watermark for 
+    * shrink.window passes then halve it, never going below the
+    * initial size or the largest request the consumer has made
+    * (get_suggested_count()).
     */
 
    auto mon_func = [&]( PortInfo &a, PortInfo &b, void *data ) -> void
    {
       (void) data;
+      if( ! first_visit( a, b ) )
+      {
+         return;
+      }
+      auto * const buff_ptr( a.getFIFO() );
       /** 
        * return if fixed buffer specified for this link
        * fixed buffer is always taken from the source port
@@ -96,35 +153,82 @@ dynalloc::run()
          return;
       }
 
-      const auto hash_val( dynalloc::hash( a, b ) );
+      const auto key( dynalloc::hash( a, b ) );
+      auto found( stats_map.find( key ) );
+      if( found == stats_map.end() )
+      {
+         edge_stats fresh;
+         fresh.holdoff = (this)->shrink.holdoff;
+         found = stats_map.emplace( key, fresh ).first;
+      }
+      auto &stats( found->second );
+      if( stats.holdoff > 0 )
+      {
+         stats.holdoff--;
+      }
       /** TODO, the values might wrap if no monitoring on **/
-      const auto realized_ratio( a.getFIFO()->get_frac_write_blocked() );
+      const auto realized_ratio( buff_ptr->get_frac_write_blocked() );
       const auto ratio( 0.8 );
+      const auto cap( buff_ptr->capacity() );
       if( realized_ratio >= ratio )
       {
-         const auto curr_count( size_map[ hash_val ]++ );
+         stats.low_count = 0;
+         const auto curr_count( stats.grow_count++ );
          if( curr_count  > 2 )
          {
-            /** get initializer function **/
-            auto * const buff_ptr( a.getFIFO() );
-            const auto cap( buff_ptr->capacity() );
-            buff_ptr->resize( cap * 2, ALLOC_ALIGN_WIDTH, exit_alloc );
-            size_map[ hash_val ] = 0;
+            /** doubling keeps the capacity a power of two **/
+            buff_ptr->resize( capacity_for( cap * 2 ), 
+                              ALLOC_ALIGN_WIDTH, 
+                              exit_alloc );
+            stats.grow_count = 0;
+            stats.holdoff    = (this)->shrink.holdoff;
          }
+         return;
       }
+      const auto occupancy( static_cast< double >( buff_ptr->size() ) / 
+                            static_cast< double >( cap ) );
+      if( occupancy >= (this)->shrink.watermark )
+      {
+         stats.low_count = 0;
+         return;
+      }
+      if( ++stats.low_count < (this)->shrink.window || stats.holdoff > 0 )
+      {
+         return;
+      }
+      stats.low_count = 0;
+      const std::size_t floor( 
+         std::max( static_cast< std::size_t >( INITIAL_ALLOC_SIZE ),
+                   capacity_for( buff_ptr->get_suggested_count() ) ) );
+      if( cap / 2 < floor )
+      {
+         return;
+      }
+      /** 
+       * if the queue filled back up since the size() call above 
+       * the resize is abandoned and the capacity stays the same
+       */
+      buff_ptr->resize( cap / 2, ALLOC_ALIGN_WIDTH, exit_alloc );
+      stats.holdoff = (this)->shrink.holdoff;
       return;
    };
+   /** so an app that's done before the first pass still has one **/
+   record_footprint();
    /** start monitor loop **/
    while( ! exit_alloc )
    {
       /** monitor fifo's **/
-      std::chrono::microseconds dura( 3000 );
+      std::chrono::microseconds dura( DYNALLOC_MONITOR_INTERVAL_US );
       std::this_thread::sleep_for( dura );
 
       auto &container( (this)->source_kernels.acquire() );
       GraphTools::BFS( container, mon_func );
       (this)->source_kernels.release();
-
+      record_footprint();
    }
+#ifdef DYNALLOC_REPORT_FOOTPRINT
+   std::cerr << "dynalloc FIFO footprint, last: " << footprint() << 
+      " bytes, peak: " << peak_footprint() << " bytes\n";
+#endif
    return;
 }
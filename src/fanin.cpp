@@ -0,0 +1,438 @@
+/**
+ * fanin.cpp -
+ * @author: agent
+ * @version: Fri Oct 16 22:57:42 2026
+ *
+ * Copyright 2026 agent
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at:
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <cassert>
+#include <algorithm>
+#include <string>
+#include "fanin.hpp"
+#include "portexception.hpp"
+#include "defs.hpp"
+
+void
+FanIn::add_source( FIFO * const fifo )
+{
+   assert( fifo != nullptr );
+   source.emplace_back( fifo );
+}
+
+std::size_t
+FanIn::sources() const noexcept
+{
+   return( source.size() );
+}
+
+std::size_t
+FanIn::size()
+{
+   std::size_t total( 0 );
+   for( auto * const fifo : source )
+   {
+      total += fifo->size();
+   }
+   return( total );
+}
+
+std::size_t
+FanIn::space_avail()
+{
+   std::size_t total( 0 );
+   for( auto * const fifo : source )
+   {
+      total += fifo->space_avail();
+   }
+   return( total );
+}
+
+std::size_t
+FanIn::capacity()
+{
+   std::size_t total( 0 );
+   for( auto * const fifo : source )
+   {
+      total += fifo->capacity();
+   }
+   return( total );
+}
+
+void
+FanIn::producer_call( const char * const name )
+{
+   throw PortTypeMismatchException( std::string( name ) +
+      " called on the consumer end of a Type::FanIn edge, each "
+      "producer writes to its own ring through its own port" );
+}
+
+/**
+ * producer side calls, the producers each have their own ring
+ * so these can't be reached through a port.
+ */
+void
+FanIn::deallocate()
+{
+   producer_call( "deallocate" );
+}
+
+void
+FanIn::send( const raft::signal sig )
+{
+   UNUSED( sig );
+   producer_call( "send" );
+}
+
+void
+FanIn::send_range( const raft::signal sig )
+{
+   UNUSED( sig );
+   producer_call( "send_range" );
+}
+
+void
+FanIn::inline_signal_send( const raft::signal sig )
+{
+   UNUSED( sig );
+   producer_call( "inline_signal_send" );
+}
+
+void
+FanIn::local_allocate( void **ptr )
+{
+   UNUSED( ptr );
+   producer_call( "allocate" );
+}
+
+void
+FanIn::local_allocate_n( void *ptr, const std::size_t n )
+{
+   UNUSED( ptr );
+   UNUSED( n );
+   producer_call( "allocate_range" );
+}
+
+void
+FanIn::local_allocate_span( void *range, const std::size_t n )
+{
+   UNUSED( range );
+   UNUSED( n );
+   producer_call( "allocate_span" );
+}
+
+void
+FanIn::local_push( void *ptr, const raft::signal &signal )
+{
+   UNUSED( ptr );
+   UNUSED( signal );
+   producer_call( "push" );
+}
+
+void
+FanIn::local_insert( void *ptr_begin,
+                     void *ptr_end,
+                     const raft::signal &signal,
+                     const std::size_t iterator_type )
+{
+   UNUSED( ptr_begin );
+   UNUSED( ptr_end );
+   UNUSED( signal );
+   UNUSED( iterator_type );
+   producer_call( "insert" );
+}
+
+void
+FanIn::resize( const std::size_t n_items,
+               const std::size_t align,
+               volatile bool &exit_alloc )
+{
+   /** each ring is resized through its producer's port **/
+   UNUSED( n_items );
+   UNUSED( align );
+   UNUSED( exit_alloc );
+}
+
+float
+FanIn::get_frac_write_blocked()
+{
+   return( 0.0 );
+}
+
+std::size_t
+FanIn::get_suggested_count()
+{
+   std::size_t count( 0 );
+   for( auto * const fifo : source )
+   {
+      count = std::max( count, fifo->get_suggested_count() );
+   }
+   return( count );
+}
+
+std::size_t
+FanIn::footprint()
+{
+   return( 0 );
+}
+
+void
+FanIn::invalidate()
+{
+   for( auto * const fifo : source )
+   {
+      fifo->invalidate();
+   }
+}
+
+bool
+FanIn::is_invalid()
+{
+   for( auto * const fifo : source )
+   {
+      if( ! fifo->is_invalid() )
+      {
+         return( false );
+      }
+   }
+   return( true );
+}
+
+bool
+FanIn::reclaims_items() const noexcept
+{
+   for( const auto * const fifo : source )
+   {
+      if( fifo->reclaims_items() )
+      {
+         return( true );
+      }
+   }
+   return( false );
+}
+
+void
+FanIn::set_wait_strategy( const raft::wait::strategy s )
+{
+   assert( s != raft::wait::inherit );
+   wait_strategy = ( s == raft::wait::park ? raft::wait::spin_yield : s );
+}
+
+void
+FanIn::flush_reads()
+{
+   for( auto * const fifo : source )
+   {
+      fifo->flush_reads();
+   }
+}
+
+FIFO*
+FanIn::make_new_fifo( const std::size_t n_items,
+                      const std::size_t align,
+                      void * const data )
+{
+   UNUSED( n_items );
+   UNUSED( align );
+   UNUSED( data );
+   return( new FanIn() );
+}
+
+void
+FanIn::setPtrMap( ptr_map_t * const in )
+{
+   for( auto * const fifo : source )
+   {
+      fifo->setPtrMap( in );
+   }
+}
+
+void
+FanIn::setPtrSet( ptr_set_t * const out )
+{
+   UNUSED( out );
+}
+
+void
+FanIn::setInPeekSet( ptr_set_t * const peekset )
+{
+   for( auto * const fifo : source )
+   {
+      fifo->setInPeekSet( peekset );
+   }
+}
+
+void
+FanIn::setOutPeekSet( ptr_set_t * const peekset )
+{
+   UNUSED( peekset );
+}
+
+raft::signal
+FanIn::signal_peek()
+{
+   /** only called by the scheduler once size() != 0 **/
+   if( current == nullptr || current->size() == 0 )
+   {
+      current = select( 1 );
+   }
+   return( current->signal_peek() );
+}
+
+bool
+FanIn::has_signal()
+{
+   for( auto * const fifo : source )
+   {
+      if( fifo->has_signal() )
+      {
+         return( true );
+      }
+   }
+   return( false );
+}
+
+void
+FanIn::signal_pop()
+{
+   assert( current != nullptr );
+   current->signal_pop();
+}
+
+void
+FanIn::local_pop( void *ptr, raft::signal *signal )
+{
+   current = select( 1 );
+   current->local_pop( ptr, signal );
+}
+
+void
+FanIn::local_pop_range( void *ptr_data, const std::size_t n_items )
+{
+   current = select( n_items );
+   current->local_pop_range( ptr_data, n_items );
+}
+
+void
+FanIn::local_pop_n( void *items,
+                    const std::size_t n,
+                    const std::size_t item_size,
+                    raft::signal *signals )
+{
+   /** 
+    * no order across producers, so take whatever each ring 
+    * has rather than waiting for one to hold all n
+    */
+   auto *dst( reinterpret_cast< char* >( items ) );
+   std::size_t done( 0 );
+   while( done < n )
+   {
+      current = select( 1 );
+      const auto count( std::min( n - done, 
+                                  std::max( current->size(), 
+                                            std::size_t( 1 ) ) ) );
+      current->local_pop_n( dst + done * item_size, 
+                            count, 
+                            item_size, 
+                            signals != nullptr ? signals + done : nullptr );
+      done += count;
+   }
+}
+
+void
+FanIn::local_peek( void **ptr, raft::signal *signal )
+{
+   current = select( 1 );
+   current->local_peek( ptr, signal );
+}
+
+void
+FanIn::local_peek_range( void **ptr,
+                         void **sig,
+                         const std::size_t n_items,
+                         std::size_t &curr_pointer_loc ,
+                         std::size_t &queue_size )
+{
+   current = select( n_items );
+   /** the ring's own capacity, peek_range wraps in it **/
+   current->local_peek_range( ptr, sig, n_items, curr_pointer_loc, queue_size );
+}
+
+void
+FanIn::local_peek_span( void *range, const std::size_t n )
+{
+   current = select( n );
+   current->local_peek_span( range, n );
+}
+
+void
+FanIn::unpeek()
+{
+   if( current != nullptr )
+   {
+      current->unpeek();
+   }
+}
+
+void
+FanIn::local_recycle( std::size_t range )
+{
+   /**
+    * after a peek the items are on the ring that was peeked,
+    * otherwise they're just being skipped, take them from
+    * wherever there are enough.
+    */
+   if( current == nullptr || current->size() < range )
+   {
+      current = select( range );
+   }
+   current->local_recycle( range );
+}
+
+FIFO*
+FanIn::select( const std::size_t n )
+{
+   assert( ! source.empty() );
+   raft::wait::backoff wait( wait_strategy, unused_spot );
+   for(;;)
+   {
+      /**
+       * check closed first, a ring can't gain items once
+       * its producer is done so if they're all closed and
+       * the scan below comes up empty nothing more will come.
+       */
+      const bool closed( is_invalid() );
+      const auto count( source.size() );
+      for( std::size_t i( 0 ); i < count; i++ )
+      {
+         const auto index( ( next + i ) % count );
+         if( source[ index ]->size() >= n )
+         {
+            next = ( index + 1 ) % count;
+            return( source[ index ] );
+         }
+      }
+      if( closed )
+      {
+         return( *std::max_element( source.begin(), source.end(),
+            []( FIFO * const a, FIFO * const b )
+            {
+               return( a->size() < b->size() );
+            } ) );
+      }
+      /** the producers can't see what a batched ring has read **/
+      flush_reads();
+      wait.idle( []{ return( true ); } );
+   }
+}
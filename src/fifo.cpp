@@ -18,6 +18,7 @@
  * limitations under the License.
  */
 #include "fifo.hpp"
+#include "portexception.hpp"
 
 
 void
@@ -36,6 +37,26 @@ FIFO::get_zero_write_stats( Blocked &copy )
    return;
 }
 
+std::size_t
+FIFO::high_water_mark()
+{
+    /** not tracked by bounded queues **/
+    return( 0 );
+}
+
+bool
+FIFO::reclaims_items() const noexcept
+{
+    return( false );
+}
+
+void
+FIFO::set_wait_strategy( const raft::wait::strategy s )
+{
+    UNUSED( s );
+    return;
+}
+
 void
 FIFO::setPtrMap( ptr_map_t * const in )
 {
@@ -63,3 +84,111 @@ FIFO::setOutPeekSet( ptr_set_t * const peekset )
     UNUSED( peekset );
     return;
 }
+
+void
+FIFO::local_push_move( void *ptr, const raft::signal &signal )
+{
+    /** no way to move into this queue, copy instead **/
+    local_push( ptr, signal );
+    return;
+}
+
+void
+FIFO::local_insert_n( const void *items,
+                      const std::size_t n,
+                      const std::size_t item_size,
+                      const raft::signal &signal )
+{
+    auto *curr( reinterpret_cast< const char* >( items ) );
+    for( std::size_t i( 0 ); i < n; i++, curr += item_size )
+    {
+        local_push( (void*) curr, i + 1 == n ? signal : raft::none );
+    }
+    return;
+}
+
+void
+FIFO::local_pop_n( void *items,
+                   const std::size_t n,
+                   const std::size_t item_size,
+                   raft::signal *signals )
+{
+    auto *curr( reinterpret_cast< char* >( items ) );
+    for( std::size_t i( 0 ); i < n; i++, curr += item_size )
+    {
+        local_pop( (void*) curr, signals != nullptr ? &signals[ i ] : nullptr );
+    }
+    return;
+}
+
+bool
+FIFO::has_signal()
+{
+    return( true );
+}
+
+void
+FIFO::set_batch( const raft::batch &b )
+{
+    UNUSED( b );
+    return;
+}
+
+void
+FIFO::set_fused( const bool fused )
+{
+    UNUSED( fused );
+    return;
+}
+
+void
+FIFO::set_placement( const raft::placement &place )
+{
+    UNUSED( place );
+    return;
+}
+
+void
+FIFO::flush()
+{
+    return;
+}
+
+void
+FIFO::flush_reads()
+{
+    return;
+}
+
+void
+FIFO::flush_due()
+{
+    return;
+}
+
+raft::byte_span
+FIFO::local_allocate_bytes( const std::size_t n )
+{
+    UNUSED( n );
+    throw PortTypeMismatchException( 
+        "allocate_bytes called on a port that isn't of type raft::bytes" );
+    return( raft::byte_span() );
+}
+
+void
+FIFO::local_send_bytes( const std::size_t used, const raft::signal signal )
+{
+    UNUSED( used );
+    UNUSED( signal );
+    throw PortTypeMismatchException( 
+        "send_bytes called on a port that isn't of type raft::bytes" );
+}
+
+raft::record
+FIFO::local_peek_record( raft::signal *signal )
+{
+    UNUSED( signal );
+    throw PortTypeMismatchException( 
+        "peek_record called on a port that isn't of type raft::bytes" );
+    return( raft::record() );
+}
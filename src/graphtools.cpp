@@ -140,6 +140,17 @@ GraphTools::__BFS( std::queue< raft::kernel* > &queue,
             queue.push( source.other_kernel );
             visited_set.insert( source.other_kernel );
          }
+         /** rest of the destinations of a broadcast edge **/
+         for( auto &other : source.broadcast_to )
+         {
+            PortInfo &dst( other.first->input.getPortInfoFor( other.second ) );
+            func( source, dst, data );
+            if( visited_set.find( other.first ) == visited_set.end() )
+            {
+               queue.push( other.first );
+               visited_set.insert( other.first );
+            }
+         }
       }
       k->output.portmap.mutex_map.unlock();
    }
@@ -181,6 +192,14 @@ GraphTools::__BFS( std::queue< raft::kernel* > &queue,
                visited_set.insert( source.other_kernel );
             }
          }
+         for( auto &other : source.broadcast_to )
+         {
+            if( visited_set.find( other.first ) == visited_set.end() )
+            {
+               queue.push( other.first );
+               visited_set.insert( other.first );
+            }
+         }
       }
       source->output.portmap.mutex_map.unlock();
    }
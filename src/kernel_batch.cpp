@@ -0,0 +1,72 @@
+/**
+ * kernel_batch.cpp - 
+ * @author: agent
+ * @version: Sat Oct 17 00:48:10 2026
+ * 
+ * Copyright 2026 agent
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at:
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <algorithm>
+#include <limits>
+#include "kernel_batch.hpp"
+#include "portexception.hpp"
+
+using namespace raft;
+
+std::size_t
+ready::operator[]( const std::string &port_name ) const
+{
+    for( const auto &c : counts )
+    {
+        if( *c.first == port_name )
+        {
+            return( c.second );
+        }
+    }
+    throw PortNotFoundException( "Port not found for name \"" + port_name + "\"" );
+}
+
+kernel_batch::kernel_batch() : raft::kernel()
+{
+    batch_run = true;
+}
+
+raft::kstatus
+kernel_batch::run()
+{
+    count();
+    return( run_batch( avail ) );
+}
+
+bool
+kernel_batch::count()
+{
+    avail.counts.clear();
+    avail.least = std::numeric_limits< std::size_t >::max();
+    avail.sum   = 0;
+    for( auto it( input.begin() ); it != input.end(); ++it )
+    {
+        const auto n( (*it).consumer_size() );
+        avail.counts.emplace_back( &it.name(), n );
+        avail.least = std::min( avail.least, n );
+        avail.sum  += n;
+    }
+    if( avail.counts.empty() )
+    {
+        /** only output ports, keep calling till it stops **/
+        avail.least = 0;
+        return( true );
+    }
+    return( sched_behav == raft::all_port ? avail.least > 0 : avail.sum > 0 );
+}
@@ -73,6 +73,84 @@ raft::map::checkEdges()
     return;
 }
 
+/**
+ * fusable - true if the edge leaving through a can be inside
+ * a fused chain, only plain rings without batching or out of
+ * order delivery.
+ */
+static bool
+fusable( const PortInfo &a )
+{
+    return( ( a.buffer_type == Type::Heap || a.buffer_type == Type::SPSC ) &&
+            a.batch.items == 0 && 
+            ! a.out_of_order &&
+            a.other_kernel != nullptr );
+}
+
+void
+raft::map::fuseChains()
+{
+    auto &container( all_kernels.acquire() );
+    /** next - kernel after k on its chain, or nullptr **/
+    auto next( []( raft::kernel * const k ) -> raft::kernel*
+    {
+        /** 
+         * a kernel_batch moves as many items per call as are
+         * queued, more than a fused link is sure to have room for
+         */
+        if( k->dup_enabled || k->batch_run || k->output.count() != 1 )
+        {
+            return( nullptr );
+        }
+        auto &a( k->output.getPortInfo() );
+        if( ! fusable( a ) )
+        {
+            return( nullptr );
+        }
+        auto * const b( a.other_kernel );
+        if( b->dup_enabled || b->batch_run || b->input.count() != 1 )
+        {
+            return( nullptr );
+        }
+        return( b );
+    } );
+    /** prev - kernel before k on its chain, or nullptr **/
+    auto prev( [&]( raft::kernel * const k ) -> raft::kernel*
+    {
+        if( k->input.count() != 1 )
+        {
+            return( nullptr );
+        }
+        auto * const a( k->input.getPortInfo().other_kernel );
+        return( a != nullptr && next( a ) == k ? a : nullptr );
+    } );
+    for( auto * const head : container )
+    {
+        /** 
+         * walk from heads only, a kernel with a fusable edge in
+         * is on someone else's chain (a ring of them is skipped)
+         */
+        if( prev( head ) != nullptr )
+        {
+            continue;
+        }
+        for( auto *k( head ), *n( next( head ) ); n != nullptr; k = n, n = next( n ) )
+        {
+            auto &a( k->output.getPortInfo() );
+            auto &b( n->input.getPortInfo() );
+            if( a.fixed_buffer_size == 0 )
+            {
+                a.fixed_buffer_size = FUSED_BUFFER_ITEMS;
+                b.fixed_buffer_size = FUSED_BUFFER_ITEMS;
+            }
+            k->fused_next = n;
+            n->fused_prev = k;
+        }
+    }
+    all_kernels.release();
+    return;
+}
+
 /**
    void insert( raft::kernel &a,  PortInfo &a_out,
                 raft::kernel &b,  PortInfo &b_in,
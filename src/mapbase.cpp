@@ -76,18 +76,37 @@ MapBase::join( raft::kernel &a, const std::string name_a, PortInfo &a_info,
          " and " << common::printClassNameFromStr( b_info.type.name() ) << "\n"; 
       throw PortTypeMismatchException( ss.str() );
    }
-   if( a_info.other_kernel != nullptr )
+   /** Broadcast edges may have any number of destinations **/
+   const bool broadcast( a_info.buffer_type == Type::Broadcast &&
+                         b_info.buffer_type == Type::Broadcast );
+   if( a_info.other_kernel != nullptr && ! broadcast )
    {
       throw PortDoubleInitializeException( "port double initialized with: " + name_b );
    }
-   if( b_info.other_kernel != nullptr )
+   /** 
+    * FanIn edges are the exception, several producers share the
+    * input port, other_kernel is left at the first of them
+    */
+   const bool fan_in( a_info.buffer_type == Type::FanIn &&
+                      b_info.buffer_type == Type::FanIn );
+   if( b_info.other_kernel != nullptr && ! fan_in )
    {
       throw PortDoubleInitializeException( "port double initialized with: " + name_a );
    }
-   a_info.other_kernel = &b;
-   a_info.other_name   = name_b;
-   b_info.other_kernel = &a;
-   b_info.other_name   = name_a;
+   if( a_info.other_kernel == nullptr )
+   {
+      a_info.other_kernel = &b;
+      a_info.other_name   = name_b;
+   }
+   else
+   {
+      a_info.broadcast_to.emplace_back( &b, name_b );
+   }
+   if( b_info.other_kernel == nullptr )
+   {
+      b_info.other_kernel = &a;
+      b_info.other_name   = name_a;
+   }
 }
    
 void 
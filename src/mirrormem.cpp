@@ -0,0 +1,107 @@
+/**
+ * mirrormem.cpp - 
+ * @author: agent
+ * @version: Fri Oct 16 22:25:58 2026
+ * 
+ * Copyright 2026 agent
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at:
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <cstdint>
+#include "mirrormem.hpp"
+#include "defs.hpp"
+
+#if defined __linux
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#if defined __linux && defined SYS_memfd_create
+#define MIRRORMEM_AVAILABLE 1
+#endif
+
+std::size_t
+raft::mirror::granularity() noexcept
+{
+#ifdef MIRRORMEM_AVAILABLE
+    static const auto page( sysconf( _SC_PAGESIZE ) );
+    return( page > 0 ? static_cast< std::size_t >( page ) : 0 );
+#else
+    return( 0 );
+#endif
+}
+
+void*
+raft::mirror::alloc( const std::size_t length ) noexcept
+{
+#ifdef MIRRORMEM_AVAILABLE
+    const auto page( raft::mirror::granularity() );
+    if( page == 0 || length == 0 || length % page != 0 )
+    {
+        return( nullptr );
+    }
+    /** anonymous file, goes away once both mappings are gone **/
+    const int fd( static_cast< int >( 
+        syscall( SYS_memfd_create, "raft_mirror", 0 ) ) );
+    if( fd < 0 )
+    {
+        return( nullptr );
+    }
+    if( ftruncate( fd, static_cast< off_t >( length ) ) != 0 )
+    {
+        close( fd );
+        return( nullptr );
+    }
+    /** 
+     * reserve both halves first so nothing else can land in 
+     * the second half between the two fixed mappings
+     */
+    auto * const base( reinterpret_cast< std::uint8_t* >( 
+        mmap( nullptr, length << 1, PROT_NONE, 
+              MAP_PRIVATE | MAP_ANONYMOUS, -1, 0 ) ) );
+    if( reinterpret_cast< void* >( base ) == MAP_FAILED )
+    {
+        close( fd );
+        return( nullptr );
+    }
+    void * const lo( mmap( base, length, PROT_READ | PROT_WRITE,
+                           MAP_SHARED | MAP_FIXED, fd, 0 ) );
+    void * const hi( mmap( base + length, length, PROT_READ | PROT_WRITE,
+                           MAP_SHARED | MAP_FIXED, fd, 0 ) );
+    close( fd );
+    if( lo == MAP_FAILED || hi == MAP_FAILED )
+    {
+        munmap( base, length << 1 );
+        return( nullptr );
+    }
+    return( base );
+#else
+    UNUSED( length );
+    return( nullptr );
+#endif
+}
+
+void
+raft::mirror::free( void * const ptr, const std::size_t length ) noexcept
+{
+#ifdef MIRRORMEM_AVAILABLE
+    if( ptr != nullptr )
+    {
+        munmap( ptr, length << 1 );
+    }
+#else
+    UNUSED( ptr );
+    UNUSED( length );
+#endif
+}
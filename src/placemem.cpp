@@ -0,0 +1,299 @@
+/**
+ * placemem.cpp -
+ * @author: agent
+ * @version: Fri Oct 16 23:55:00 2026
+ *
+ * Copyright 2026 agent
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at:
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include "placemem.hpp"
+#include "defs.hpp"
+
+#if defined __linux
+#include <dirent.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#if defined __linux && defined MAP_ANONYMOUS
+#define PLACEMEM_AVAILABLE 1
+/** from numaif.h, so we don't need libnuma to build **/
+#ifndef MPOL_PREFERRED
+#define MPOL_PREFERRED 1
+#endif
+#ifndef MPOL_F_NODE
+#define MPOL_F_NODE    ( 1 << 0 )
+#define MPOL_F_ADDR    ( 1 << 1 )
+#endif
+#endif
+
+#ifdef PLACEMEM_AVAILABLE
+/**
+ * count_entries - number of entries in dir named prefix
+ * followed by a number, sets last to the number of the last
+ * one found.
+ */
+static int
+count_entries( const std::string &dir,
+               const std::string &prefix,
+               int &last ) noexcept
+{
+    DIR * const d( opendir( dir.c_str() ) );
+    if( d == nullptr )
+    {
+        return( 0 );
+    }
+    int count( 0 );
+    for( auto *ent( readdir( d ) ); ent != nullptr; ent = readdir( d ) )
+    {
+        const std::string name( ent->d_name );
+        if( name.size() > prefix.size() &&
+            name.compare( 0, prefix.size(), prefix ) == 0 &&
+            name.find_first_not_of( "0123456789", prefix.size() ) == std::string::npos )
+        {
+            last = std::atoi( name.c_str() + prefix.size() );
+            count++;
+        }
+    }
+    closedir( d );
+    return( count );
+}
+
+/**
+ * map_aligned - anonymous mapping of length rounded up to
+ * align, starting on a multiple of align. Maps align more
+ * than needed and trims both ends.
+ */
+static void*
+map_aligned( const std::size_t length,
+             const std::size_t align,
+             std::size_t &mapped ) noexcept
+{
+    const std::size_t len( ( length + align - 1 ) / align * align );
+    auto * const base( reinterpret_cast< std::uint8_t* >(
+        mmap( nullptr, len + align, PROT_READ | PROT_WRITE,
+              MAP_PRIVATE | MAP_ANONYMOUS, -1, 0 ) ) );
+    if( reinterpret_cast< void* >( base ) == MAP_FAILED )
+    {
+        return( nullptr );
+    }
+    const auto addr( reinterpret_cast< std::uintptr_t >( base ) );
+    const std::size_t head( ( align - addr % align ) % align );
+    if( head != 0 )
+    {
+        munmap( base, head );
+    }
+    munmap( base + head + len, align - head );
+    mapped = len;
+    return( base + head );
+}
+#endif
+
+int
+raft::placemem::nodes() noexcept
+{
+#ifdef PLACEMEM_AVAILABLE
+    static const int n( [](){
+        int last( 0 );
+        const auto count( count_entries( "/sys/devices/system/node", "node", last ) );
+        return( count > 0 ? count : 1 );
+    }() );
+    return( n );
+#else
+    return( 1 );
+#endif
+}
+
+int
+raft::placemem::node_of( const int core ) noexcept
+{
+#ifdef PLACEMEM_AVAILABLE
+    if( core < 0 )
+    {
+        return( -1 );
+    }
+    int node( -1 );
+    if( count_entries( "/sys/devices/system/cpu/cpu" + std::to_string( core ),
+                       "node", node ) != 1 )
+    {
+        return( -1 );
+    }
+    return( node );
+#else
+    UNUSED( core );
+    return( -1 );
+#endif
+}
+
+int
+raft::placemem::node_of( const void * const ptr ) noexcept
+{
+#if defined PLACEMEM_AVAILABLE && defined SYS_get_mempolicy
+    int node( -1 );
+    if( syscall( SYS_get_mempolicy, &node, nullptr, 0, ptr,
+                 MPOL_F_NODE | MPOL_F_ADDR ) != 0 )
+    {
+        return( -1 );
+    }
+    return( node );
+#else
+    UNUSED( ptr );
+    return( -1 );
+#endif
+}
+
+int
+raft::placemem::huge_pages( const void * const ptr ) noexcept
+{
+#ifdef PLACEMEM_AVAILABLE
+    /** 
+     * find the mapping in smaps, its VmFlags has ht for 
+     * explicit huge pages and hg once advised to use them
+     */
+    std::ifstream smaps( "/proc/self/smaps" );
+    const auto addr( reinterpret_cast< std::uintptr_t >( ptr ) );
+    bool found( false );
+    std::string line;
+    while( std::getline( smaps, line ) )
+    {
+        if( ! found )
+        {
+            std::uintptr_t begin( 0 ), end( 0 );
+            char dash( 0 );
+            std::istringstream ss( line );
+            ss >> std::hex >> begin >> dash >> end;
+            found = ( ! ss.fail() && dash == '-' && begin <= addr && addr < end );
+        }
+        else if( line.compare( 0, 8, "VmFlags:" ) == 0 )
+        {
+            std::istringstream ss( line.substr( 8 ) );
+            for( std::string flag; ss >> flag; )
+            {
+                if( flag == "ht" || flag == "hg" )
+                {
+                    return( 1 );
+                }
+            }
+            return( 0 );
+        }
+    }
+    return( -1 );
+#else
+    UNUSED( ptr );
+    return( -1 );
+#endif
+}
+
+void*
+raft::placemem::alloc( const std::size_t length,
+                       const raft::placement &place,
+                       std::size_t &mapped ) noexcept
+{
+#ifdef PLACEMEM_AVAILABLE
+    const bool huge( place.page != raft::pages::base &&
+                     length >= HUGE_PAGE_MIN_STORE );
+    /** nothing to bind to on a single node machine **/
+    const int node( raft::placemem::nodes() > 1 ? place.node : -1 );
+    if( length == 0 || ( ! huge && node < 0 ) )
+    {
+        return( nullptr );
+    }
+    void *ptr( nullptr );
+#ifdef MAP_HUGETLB
+    if( huge && place.page == raft::pages::huge )
+    {
+        const std::size_t len( ( length + HUGE_PAGE_SIZE - 1 ) /
+                                  HUGE_PAGE_SIZE * HUGE_PAGE_SIZE );
+        ptr = mmap( nullptr, len, PROT_READ | PROT_WRITE,
+                    MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0 );
+        if( ptr == MAP_FAILED )
+        {
+            /** no (or not enough) huge pages reserved, go transparent **/
+            ptr = nullptr;
+        }
+        else
+        {
+            mapped = len;
+        }
+    }
+#endif
+    if( ptr == nullptr && huge )
+    {
+        ptr = map_aligned( length, HUGE_PAGE_SIZE, mapped );
+#ifdef MADV_HUGEPAGE
+        if( ptr != nullptr )
+        {
+            madvise( ptr, mapped, MADV_HUGEPAGE );
+        }
+#endif
+    }
+    if( ptr == nullptr )
+    {
+        const auto page( sysconf( _SC_PAGESIZE ) );
+        ptr = map_aligned( length,
+                           page > 0 ? static_cast< std::size_t >( page ) : 4096,
+                           mapped );
+        if( ptr == nullptr )
+        {
+            return( nullptr );
+        }
+        madvise( ptr, mapped, MADV_SEQUENTIAL );
+    }
+#ifdef SYS_mbind
+    if( node >= 0 )
+    {
+        /**
+         * nothing is touched yet, so every page faults in on
+         * node. Preferred rather than bind so a full node falls
+         * back to the others instead of failing the fault, if the
+         * call fails it's left to first touch.
+         */
+        constexpr std::size_t bits( sizeof( unsigned long ) * 8 );
+        unsigned long mask[ 16 ] = { 0 };
+        if( static_cast< std::size_t >( node ) < sizeof( mask ) * 8 )
+        {
+            mask[ node / bits ] = 1UL << ( node % bits );
+            syscall( SYS_mbind, ptr, mapped, MPOL_PREFERRED, mask,
+                     sizeof( mask ) * 8 + 1, 0 );
+        }
+    }
+#endif
+    return( ptr );
+#else
+    UNUSED( length );
+    UNUSED( place );
+    UNUSED( mapped );
+    return( nullptr );
+#endif
+}
+
+void
+raft::placemem::free( void * const ptr, const std::size_t mapped ) noexcept
+{
+#ifdef PLACEMEM_AVAILABLE
+    if( ptr != nullptr )
+    {
+        munmap( ptr, mapped );
+    }
+#else
+    UNUSED( ptr );
+    UNUSED( mapped );
+#endif
+}
@@ -25,9 +25,9 @@
 Pointer::Pointer(const std::size_t cap, 
                  const wrap_t wrap_set ) : Pointer( cap )
 {
-    wrap_a = wrap_set;
+    a = wrap_set * cap;
 #ifdef JVEC_MACHINE
-    wrap_b = wrap_set;
+    b = wrap_set * cap;
 #endif    
 }
 
@@ -35,10 +35,15 @@ Pointer::Pointer(const std::size_t cap,
 Pointer::Pointer( Pointer &other, 
                   const std::size_t new_cap ) : Pointer( new_cap )
 {
-    const auto val(  Pointer::val( other ) );
-    a = val;
+    /** 
+     * keep the position, the items are copied into
+     * the new buffer by position (see DataBase::copyItems)
+     * so the index is recomputed for the new capacity.
+     */
+    const auto pos(  Pointer::position( other ) );
+    a = pos;
 #ifdef JVEC_MACHINE
-    b = val;
+    b = pos;
 #endif
     return;
 }
@@ -46,38 +51,28 @@ Pointer::Pointer( Pointer &other,
 std::size_t 
 Pointer::val( Pointer &ptr ) 
 {
-#ifdef JVEC_MACHINE
-   struct{
-      std::uint64_t a;
-      std::uint64_t b;
-   }copy;
-   do{
-      copy.a = ptr.a;
-      copy.b = ptr.b;
-   }while( copy.a !=  copy.b );
-   return( copy.b );
-#else
-   return( ptr.a );
-#endif
+   return( Pointer::index( ptr, Pointer::position( ptr ) ) );
+}
+
+std::size_t
+Pointer::index( Pointer &ptr, const std::uint64_t position ) noexcept
+{
+   if( R_LIKELY( ptr.mask != 0 ) )
+   {
+      return( position & ptr.mask );
+   }
+   /** non power of two, e.g., externally allocated buffers **/
+   return( position % ptr.max_cap );
 }
 
 void
 Pointer::inc( Pointer &ptr ) 
 {
 #ifdef JVEC_MACHINE
-   ptr.a = ( ptr.a + 1 ) % ptr.max_cap;
-   ptr.b = ( ptr.b + 1 ) % ptr.max_cap;
-   if( ptr.b == 0 )
-   {
-      ptr.wrap_a++;
-      ptr.wrap_b++;
-   }
+   ptr.a = ptr.a + 1;
+   ptr.b = ptr.b + 1;
 #else
-   ptr.a = ( ptr.a + 1 ) % ptr.max_cap;
-   if( ptr.a == 0 )
-   {
-      ptr.wrap_a++;
-   }
+   ptr.a = ptr.a + 1;
 #endif
 }
 
@@ -86,36 +81,27 @@ Pointer::incBy( Pointer &ptr,
                 const std::size_t in )
 {
 #ifdef JVEC_MACHINE
-   ptr.a = ( ptr.a + in ) % ptr.max_cap;
-   ptr.b = ( ptr.b + in ) % ptr.max_cap;
-   if( ptr.b < in )
-   {
-      ptr.wrap_a++;
-      ptr.wrap_b++;
-   }
+   ptr.a = ptr.a + in;
+   ptr.b = ptr.b + in;
 #else
-   ptr.a = ( ptr.a + in ) % ptr.max_cap;
-   if( ptr.a < in )
-   {
-      ptr.wrap_a++;
-   }
+   ptr.a = ptr.a + in;
 #endif
 }
 
-std::size_t 
-Pointer::wrapIndicator( Pointer &ptr ) 
+std::uint64_t
+Pointer::position( Pointer &ptr )
 {
 #ifdef JVEC_MACHINE
-    struct{
-       std::uint64_t a;
-       std::uint64_t b;
-    }copy;
-    do{
-       copy.a = ptr.wrap_a;
-       copy.b = ptr.wrap_b;
-    }while( copy.a != copy.b );
-    return( copy.b );
+   struct{
+      std::uint64_t a;
+      std::uint64_t b;
+   }copy;
+   do{
+      copy.a = ptr.a;
+      copy.b = ptr.b;
+   }while( copy.a !=  copy.b );
+   return( copy.b );
 #else
-    return( ptr.wrap_a );
+   return( ptr.a );
 #endif
 }
@@ -125,10 +125,11 @@ aligned_t pool_schedule::pool_run( void *data )
    ptr_set_t out;
    ptr_set_t peekset;
 
-   Schedule::setPtrSets( thread_d->k, 
-                        &in, 
-                        &out,
-                        &peekset );
+   const bool reclaims( Schedule::setPtrSets( thread_d->k, 
+                                              &in, 
+                                              &out,
+                                              &peekset ) );
+   Schedule::gc_counters counters;
 #if 0 //figure out pinning later                        
    if( thread_d->loc != -1 )
    {
@@ -152,11 +153,20 @@ aligned_t pool_schedule::pool_run( void *data )
       if( run_count++ == 20 || done )
       {
         run_count = 0;
-        //takes care of peekset clearing too
-        Schedule::fifo_gc( &in, &out, &peekset );
+        if( reclaims )
+        {
+           //takes care of peekset clearing too
+           counters.items_reclaimed += Schedule::fifo_gc( &in, &out, &peekset );
+           counters.runs_with_gc++;
+        }
+        else
+        {
+           counters.runs_without_gc++;
+        }
         qthread_yield();
       }
    }
+   Schedule::add_gc_counters( counters );
    thread_d->finished = true;
    return( 1 );
 }
@@ -28,6 +28,7 @@ PortInfo::PortInfo( const PortInfo &other ) : type( other.type )
    my_name        = other.my_name;
    other_kernel   = other.other_kernel;
    other_name     = other.other_name;
+   broadcast_to   = other.broadcast_to;
    out_of_order   = other.out_of_order;
    existing_buffer= other.existing_buffer;
    nitems         = other.nitems;
@@ -35,28 +36,16 @@ PortInfo::PortInfo( const PortInfo &other ) : type( other.type )
    split_func      = other.split_func;
    join_func       = other.join_func;
    fixed_buffer_size = other.fixed_buffer_size;
+   buffer_type       = other.buffer_type;
+   wait              = other.wait;
+   batch             = other.batch;
+   place             = other.place;
    const_map      = other.const_map;
 }
 
 
 
 
-FIFO* 
-PortInfo::getFIFO()
-{
-   struct{
-      FIFO *a;
-      FIFO *b;
-   }copy = { fifo_a, fifo_b };
-   /** for most architectures that don't need this, it'll be optimized out after the first iteration **/
-   while( copy.a != copy.b )
-   {
-      copy.a = fifo_a;
-      copy.b = fifo_b;
-   }
-   return( copy.a );
-}
-
 void 
 PortInfo::setFIFO( FIFO * const in )
 {
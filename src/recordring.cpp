@@ -0,0 +1,426 @@
+/**
+ * recordring.cpp -
+ * @author: agent
+ * @version: Sat Oct 17 00:01:59 2026
+ *
+ * Copyright 2026 agent
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at:
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <cassert>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include "recordring.hpp"
+#include "portexception.hpp"
+#include "defs.hpp"
+
+/** store_size - n rounded up to a power of two, at least the minimum **/
+static std::size_t
+store_size( const std::size_t n ) noexcept
+{
+    std::size_t cap( RECORD_RING_MIN_BYTES );
+    while( cap < n )
+    {
+        cap <<= 1;
+    }
+    return( cap );
+}
+
+RecordRing::RecordRing( const std::size_t n_bytes ) : FIFO(),
+                                                       cap( store_size( n_bytes ) ),
+                                                       mask( cap - 1 )
+{
+#if (defined __linux ) || (defined __APPLE__ )
+    const auto ret_val( posix_memalign( (void**) &store,
+                                        L1D_CACHE_LINE_SIZE,
+                                        cap ) );
+    if( ret_val != 0 )
+    {
+        std::cerr << "posix_memalign returned error code (" << ret_val << ")";
+        std::cerr << " with message: \n" << strerror( ret_val ) << "\n";
+        exit( EXIT_FAILURE );
+    }
+#else
+    store = reinterpret_cast< char* >( malloc( cap ) );
+#endif
+    //FIXME - this should be an exception
+    assert( store != nullptr );
+}
+
+RecordRing::~RecordRing()
+{
+    free( store );
+}
+
+FIFO*
+RecordRing::make_new_fifo( const std::size_t n_items,
+                           const std::size_t align,
+                           void * const data )
+{
+    UNUSED( align );
+    UNUSED( data );
+    assert( data == nullptr );
+    return( new RecordRing( n_items ) );
+}
+
+std::size_t
+RecordRing::size()
+{
+    /** consumer's count first, it can't pass the producer's **/
+    const auto out( consumer.count.load( std::memory_order_acquire ) );
+    const auto in( producer.count.load( std::memory_order_acquire ) );
+    return( static_cast< std::size_t >( in - out ) );
+}
+
+std::size_t
+RecordRing::space_avail()
+{
+    const auto head( consumer.head.load( std::memory_order_acquire ) );
+    const auto tail( producer.tail.load( std::memory_order_relaxed ) );
+    return( cap - static_cast< std::size_t >( tail - head ) );
+}
+
+std::size_t
+RecordRing::capacity()
+{
+    return( cap );
+}
+
+void
+RecordRing::deallocate()
+{
+    producer.allocated = false;
+    return;
+}
+
+void
+RecordRing::send( const raft::signal signal )
+{
+    local_send_bytes( producer.reserved, signal );
+    return;
+}
+
+void
+RecordRing::send_range( const raft::signal signal )
+{
+    local_send_bytes( producer.reserved, signal );
+    return;
+}
+
+void
+RecordRing::unpeek()
+{
+    /** nothing held, the record stays put till it's recycled **/
+    return;
+}
+
+void
+RecordRing::resize( const std::size_t n_items,
+                    const std::size_t align,
+                    volatile bool &exit_alloc )
+{
+    UNUSED( n_items );
+    UNUSED( align );
+    UNUSED( exit_alloc );
+    return;
+}
+
+float
+RecordRing::get_frac_write_blocked()
+{
+    return( 0.0 );
+}
+
+std::size_t
+RecordRing::get_suggested_count()
+{
+    return( 0 );
+}
+
+std::size_t
+RecordRing::footprint()
+{
+    return( cap );
+}
+
+void
+RecordRing::invalidate()
+{
+    valid.store( false, std::memory_order_release );
+    /** a parked consumer needs to see this to exit **/
+    if( wait_strategy == raft::wait::park )
+    {
+        data_ready.wake();
+        space_ready.wake();
+    }
+    return;
+}
+
+bool
+RecordRing::is_invalid()
+{
+    return( ! valid.load( std::memory_order_acquire ) );
+}
+
+void
+RecordRing::set_wait_strategy( const raft::wait::strategy s )
+{
+    assert( s != raft::wait::inherit );
+    wait_strategy = s;
+    return;
+}
+
+raft::signal
+RecordRing::signal_peek()
+{
+    if( size() == 0 )
+    {
+        return( raft::none );
+    }
+    return( at( record_at( consumer.head.load( std::memory_order_relaxed ) ) )->signal );
+}
+
+void
+RecordRing::signal_pop()
+{
+    local_recycle( 1 );
+    return;
+}
+
+void
+RecordRing::inline_signal_send( const raft::signal sig )
+{
+    /** an empty record carries it **/
+    local_allocate_bytes( 0 );
+    local_send_bytes( 0, sig );
+    return;
+}
+
+void
+RecordRing::typed_call( const char * const name )
+{
+    throw PortTypeMismatchException( std::string( name ) +
+        " called on a port of type raft::bytes, use the record calls "
+        "(allocate_bytes, push_bytes, peek_record, pop_record)" );
+}
+
+void
+RecordRing::local_allocate( void **ptr )
+{
+    UNUSED( ptr );
+    typed_call( "allocate" );
+}
+
+void
+RecordRing::local_allocate_n( void *ptr, const std::size_t n )
+{
+    UNUSED( ptr );
+    UNUSED( n );
+    typed_call( "allocate_range" );
+}
+
+void
+RecordRing::local_allocate_span( void *range, const std::size_t n )
+{
+    UNUSED( range );
+    UNUSED( n );
+    typed_call( "allocate_span" );
+}
+
+void
+RecordRing::local_push( void *ptr, const raft::signal &signal )
+{
+    UNUSED( ptr );
+    UNUSED( signal );
+    typed_call( "push" );
+}
+
+void
+RecordRing::local_insert( void *ptr_begin,
+                          void *ptr_end,
+                          const raft::signal &signal,
+                          const std::size_t iterator_type )
+{
+    UNUSED( ptr_begin );
+    UNUSED( ptr_end );
+    UNUSED( signal );
+    UNUSED( iterator_type );
+    typed_call( "insert" );
+}
+
+void
+RecordRing::local_pop( void *ptr, raft::signal *signal )
+{
+    UNUSED( ptr );
+    UNUSED( signal );
+    typed_call( "pop" );
+}
+
+void
+RecordRing::local_pop_range( void *ptr_data, const std::size_t n_items )
+{
+    UNUSED( ptr_data );
+    UNUSED( n_items );
+    typed_call( "pop_range" );
+}
+
+void
+RecordRing::local_peek( void **ptr, raft::signal *signal )
+{
+    UNUSED( ptr );
+    UNUSED( signal );
+    typed_call( "peek" );
+}
+
+void
+RecordRing::local_peek_range( void **ptr,
+                              void **sig,
+                              const std::size_t n_items,
+                              std::size_t &curr_pointer_loc ,
+                              std::size_t &queue_size )
+{
+    UNUSED( ptr );
+    UNUSED( sig );
+    UNUSED( n_items );
+    UNUSED( curr_pointer_loc );
+    UNUSED( queue_size );
+    typed_call( "peek_range" );
+}
+
+void
+RecordRing::local_peek_span( void *range, const std::size_t n )
+{
+    UNUSED( range );
+    UNUSED( n );
+    typed_call( "peek_span" );
+}
+
+void
+RecordRing::local_recycle( std::size_t range )
+{
+    auto head( consumer.head.load( std::memory_order_relaxed ) );
+    auto out( consumer.count.load( std::memory_order_relaxed ) );
+    for( ; range > 0 && size() > 0; range-- )
+    {
+        head = record_at( head );
+        head += footprint_of( at( head )->length );
+        out++;
+        consumer.head.store( head, std::memory_order_release );
+        consumer.count.store( out, std::memory_order_release );
+    }
+    wake_producer();
+    return;
+}
+
+raft::byte_span
+RecordRing::local_allocate_bytes( const std::size_t n )
+{
+    const auto need( footprint_of( n ) );
+    if( need > ( cap >> 1 ) )
+    {
+        throw RecordTooLargeException( "record of " + std::to_string( n ) +
+            " bytes doesn't fit a record ring of " + std::to_string( cap ) +
+            " bytes, give link a bigger buffer" );
+    }
+    auto pos( producer.tail.load( std::memory_order_relaxed ) );
+    const std::size_t off( pos & mask );
+    /** doesn't fit before the end, skip to the front **/
+    const std::size_t skip( off + need > cap ? cap - off : 0 );
+    auto ready( [&]() -> bool
+    {
+        return( space_avail() >= skip + need );
+    } );
+    raft::wait::backoff wait( wait_strategy, space_ready );
+    while( ! ready() )
+    {
+        wait.idle( ready );
+    }
+    if( skip != 0 )
+    {
+        /** not visible till the record after it is sent **/
+        at( pos )->length = wrap;
+        pos += skip;
+    }
+    producer.start     = pos;
+    producer.reserved  = n;
+    producer.allocated = true;
+    return( raft::byte_span( reinterpret_cast< char* >( at( pos ) + 1 ), n ) );
+}
+
+void
+RecordRing::local_send_bytes( const std::size_t used,
+                              const raft::signal signal )
+{
+    if( R_UNLIKELY( ! producer.allocated ) )
+    {
+        return;
+    }
+    assert( used <= producer.reserved );
+    auto * const h( at( producer.start ) );
+    h->length = static_cast< std::uint32_t >( used );
+    h->signal = signal;
+    producer.allocated = false;
+    producer.tail.store( producer.start + footprint_of( used ),
+                         std::memory_order_relaxed );
+    /** publishes the record (and any marker before it) **/
+    producer.count.store( producer.count.load( std::memory_order_relaxed ) + 1,
+                          std::memory_order_release );
+    wake_consumer();
+    return;
+}
+
+raft::record
+RecordRing::local_peek_record( raft::signal *signal )
+{
+    auto ready( [&]() -> bool
+    {
+        return( size() > 0 || is_invalid() );
+    } );
+    raft::wait::backoff wait( wait_strategy, data_ready );
+    while( size() == 0 )
+    {
+        if( is_invalid() && size() == 0 )
+        {
+            throw ClosedPortAccessException(
+               "Accessing closed port with peek_record call, exiting!!" );
+        }
+        wait.idle( ready );
+    }
+    const auto * const h( at( record_at(
+        consumer.head.load( std::memory_order_relaxed ) ) ) );
+    if( signal != nullptr )
+    {
+        *signal = h->signal;
+    }
+    return( raft::record( reinterpret_cast< const char* >( h + 1 ), h->length ) );
+}
+
+void
+RecordRing::wake_consumer() noexcept
+{
+    if( R_UNLIKELY( wait_strategy == raft::wait::park ) )
+    {
+        data_ready.notify();
+    }
+}
+
+void
+RecordRing::wake_producer() noexcept
+{
+    if( R_UNLIKELY( wait_strategy == raft::wait::park ) )
+    {
+        space_ready.notify();
+    }
+}
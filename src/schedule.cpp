@@ -1,9 +1,13 @@
 #include <iostream>
+#include <algorithm>
+#include <atomic>
 
 #include "kernel.hpp"
+#include "kernel_batch.hpp"
 #include "map.hpp"
 #include "schedule.hpp"
 #include "defs.hpp"
+#include "threadaccess.hpp"
 
 
 Schedule::Schedule( raft::map &map ) :  kernel_set( map.all_kernels ),
@@ -49,11 +53,37 @@ Schedule::invalidateOutputPorts( raft::kernel *kernel )
    auto &output_ports( kernel->output );
    for( auto &port : output_ports )
    {
+      /** nothing held back on a batched edge can be lost **/
+      port.flush();
       port.invalidate();
    }
    return;
 }
 
+void
+Schedule::flushPorts( raft::kernel *kernel )
+{
+   for( auto &port : kernel->output )
+   {
+      port.flush();
+   }
+   for( auto &port : kernel->input )
+   {
+      port.flush_reads();
+   }
+   return;
+}
+
+void
+Schedule::flushDuePorts( raft::kernel *kernel )
+{
+   for( auto &port : kernel->output )
+   {
+      port.flush_due();
+   }
+   return;
+}
+
 raft::kstatus
 Schedule::checkSystemSignal( raft::kernel * const kernel,
                              void *data,
@@ -63,7 +93,8 @@ Schedule::checkSystemSignal( raft::kernel * const kernel,
    raft::kstatus ret_signal( raft::proceed );
    for( auto &port : input_ports )
    {
-      if( port.size() == 0 )
+      /** no signal anywhere in the queue is the common case **/
+      if( ! port.has_signal() || port.consumer_size() == 0 )
       {
          continue;
       }
@@ -156,7 +187,7 @@ Schedule::kernelHasInputData( raft::kernel *kernel )
         {
             for( auto &port : port_list )
             {
-               const auto size( port.size() );
+               const auto size( port.consumer_size() );
                if( size > 0 )
                {
                   return( true );
@@ -168,7 +199,7 @@ Schedule::kernelHasInputData( raft::kernel *kernel )
         {
             for( auto &port : port_list )
             {
-               const auto size( port.size() );
+               const auto size( port.consumer_size() );
                /** no data avail on this port, return false **/
                if( size == 0 )
                {
@@ -208,10 +239,89 @@ Schedule::kernelHasNoInputPorts( raft::kernel *kernel )
 }
 
 
+bool
+Schedule::batchRun( raft::kernel_batch * const kernel,
+                    volatile bool             &finished )
+{
+   /** one pass over the ports, counts for run_batch and the data check **/
+   if( kernel->count() )
+   {
+      const auto sig_status( kernel->run_batch( kernel->avail ) );
+      if( sig_status == raft::stop )
+      {
+         invalidateOutputPorts( kernel );
+         finished = true;
+      }
+      else if( kernel->batched_ports )
+      {
+         flushDuePorts( kernel );
+      }
+      return( true );
+   }
+   if( kernel->batched_ports )
+   {
+      flushPorts( kernel );
+   }
+   /** nothing queued, done if nothing more can come **/
+   if( kernelHasNoInputPorts( kernel ) && ! kernelHasInputData( kernel ) )
+   {
+      invalidateOutputPorts( kernel );
+      finished = true;
+   }
+   return( true );
+}
+
+std::vector< raft::kernel* >
+Schedule::fusedChain( raft::kernel * const kernel )
+{
+   std::vector< raft::kernel* > chain;
+   for( auto *k( kernel ); k != nullptr; k = k->fused_next )
+   {
+      chain.emplace_back( k );
+      if( k->fused_next != nullptr )
+      {
+         /** only the one port, fuseChains checked **/
+         for( auto &port : k->output )
+         {
+            port.set_fused( true );
+         }
+      }
+   }
+   return( chain );
+}
+
+bool
+Schedule::runByChain( raft::kernel * const kernel ) noexcept
+{
+   return( kernel->fused_prev != nullptr );
+}
+
+bool
+Schedule::fusedOutputFull( raft::kernel * const kernel )
+{
+   assert( kernel->fused_next != nullptr );
+   /** only the one port, fuseChains checked **/
+   for( auto &port : kernel->output )
+   {
+      return( port.space_avail() == 0 );
+   }
+   return( false );
+}
+
 bool
 Schedule::kernelRun( raft::kernel * const kernel,
                      volatile bool       &finished )
 {
+   /** 
+    * between runs nothing is held but what DataManager tracks, 
+    * a kernel that doesn't touch its FIFOs in run() (e.g., an 
+    * idle source) would otherwise hold up every resize
+    */
+   ThreadAccess::local().quiesce();
+   if( kernel->batch_run )
+   {
+      return( batchRun( static_cast< raft::kernel_batch* >( kernel ), finished ) );
+   }
    if( kernelHasInputData( kernel ) )
    {
       const auto sig_status( kernel->run() );
@@ -220,6 +330,15 @@ Schedule::kernelRun( raft::kernel * const kernel,
          invalidateOutputPorts( kernel );
          finished = true;
       }
+      else if( kernel->batched_ports )
+      {
+         flushDuePorts( kernel );
+      }
+   }
+   else if( kernel->batched_ports )
+   {
+      /** idle, don't hold anything back from the neighbors **/
+      flushPorts( kernel );
    }
    /**
     * must recheck data items again after port valid check, there could
@@ -233,7 +352,7 @@ Schedule::kernelRun( raft::kernel * const kernel,
    return( true );
 }
 
-void
+bool
 Schedule::setPtrSets( raft::kernel * const kernel,
                       ptr_map_t    * const in,
                       ptr_set_t    * const out,
@@ -242,6 +361,10 @@ Schedule::setPtrSets( raft::kernel * const kernel,
     assert( in  != nullptr );
     assert( out != nullptr );
     assert( peekset != nullptr );
+    in->reserve( gc_reserve );
+    out->reserve( gc_reserve );
+    peekset->reserve( gc_reserve );
+    bool reclaims( false );
     /**
      * looks a bit odd initially, but the same
      * peekset is set for each kernel's FIFO's
@@ -252,44 +375,76 @@ Schedule::setPtrSets( raft::kernel * const kernel,
     {
         port.setPtrMap( in );
         port.setInPeekSet( peekset );
+        reclaims |= port.reclaims_items();
     }
     for( auto &port : kernel->output )
     {
         port.setPtrSet( out );
         port.setOutPeekSet( peekset );
+        reclaims |= port.reclaims_items();
     }
-    return;
+    return( reclaims );
 }
 
-void
+std::size_t
 Schedule::fifo_gc( ptr_map_t * const in,
                    ptr_set_t * const out,
                    ptr_set_t * const peekset )
 {
-    auto in_begin( in->begin() ), in_end( in->end() );
-    auto out_beg( out->begin() ), out_end( out->end() );
-    while( out_beg != out_end )
+    /**
+     * anything the kernel recycled that it didn't push on to 
+     * an output port is freed. Forwarding is rare and out is
+     * small so sort it and search it, keeps this linear in
+     * the common case of nothing forwarded.
+     */
+    std::size_t freed( 0 );
+    if( out->empty() )
     {
-        if( (*out_beg) != (*in_begin).first )
-        {
-            void * const ptr = reinterpret_cast< void* >( (*in_begin).first );
-            (*in_begin).second( ptr );
-            ++in_begin;
-        }
-        else
+        for( auto &item : *in )
         {
-            ++out_beg;
-            ++in_begin;
+            item.second( reinterpret_cast< void* >( item.first ) );
         }
+        freed = in->size();
     }
-    while( in_begin != in_end )
+    else
     {
-            void * const ptr = reinterpret_cast< void* >( (*in_begin).first );
-            (*in_begin).second( ptr );
-            ++in_begin;
+        std::sort( out->begin(), out->end() );
+        for( auto &item : *in )
+        {
+            if( ! std::binary_search( out->cbegin(), out->cend(), item.first ) )
+            {
+                item.second( reinterpret_cast< void* >( item.first ) );
+                freed++;
+            }
+        }
     }
     in->clear();
     out->clear();
     peekset->clear();
-    return;
+    return( freed );
+}
+
+namespace
+{
+    std::atomic< std::uint64_t > total_runs_with_gc    = { 0 };
+    std::atomic< std::uint64_t > total_runs_without_gc = { 0 };
+    std::atomic< std::uint64_t > total_reclaimed       = { 0 };
+}
+
+Schedule::gc_counters
+Schedule::get_gc_counters() noexcept
+{
+    gc_counters out;
+    out.runs_with_gc    = total_runs_with_gc.load( std::memory_order_relaxed );
+    out.runs_without_gc = total_runs_without_gc.load( std::memory_order_relaxed );
+    out.items_reclaimed = total_reclaimed.load( std::memory_order_relaxed );
+    return( out );
+}
+
+void
+Schedule::add_gc_counters( const gc_counters &local ) noexcept
+{
+    total_runs_with_gc.fetch_add( local.runs_with_gc, std::memory_order_relaxed );
+    total_runs_without_gc.fetch_add( local.runs_without_gc, std::memory_order_relaxed );
+    total_reclaimed.fetch_add( local.items_reclaimed, std::memory_order_relaxed );
 }
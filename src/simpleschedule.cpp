@@ -71,6 +71,11 @@ simple_schedule::start()
    auto &container( kernel_set.acquire() );
    for( auto * const k : container )
    {  
+      /** runs on the thread of the head of its chain **/
+      if( Schedule::runByChain( k ) )
+      {
+         continue;
+      }
       auto * const th_info( new thread_info_t( k ) );
       th_info->data.loc = k->getCoreAssignment();
       thread_map.emplace_back( th_info );
@@ -151,10 +156,17 @@ simple_schedule::simple_run( void * data )
    ptr_set_t out;
    ptr_set_t peekset;
 
-   Schedule::setPtrSets( thread_d->k, 
-                        &in, 
-                        &out,
-                        &peekset );
+   /** 
+    * one kernel unless it heads a fused chain, the lists are
+    * shared by the chain, they're emptied after every run
+    */
+   const auto chain( Schedule::fusedChain( thread_d->k ) );
+   bool reclaims( false );
+   for( auto * const k : chain )
+   {
+      reclaims |= Schedule::setPtrSets( k, &in, &out, &peekset );
+   }
+   Schedule::gc_counters counters;
    if( thread_d->loc != -1 )
    {
       /** call does nothing if not available **/
@@ -166,10 +178,71 @@ simple_schedule::simple_run( void * data )
        assert( false );
 #endif
    }
-   while( ! *(thread_d->finished) )
+   auto gc( [&]()
+   {
+      if( reclaims )
+      {
+         //takes care of peekset clearing too
+         counters.items_reclaimed += Schedule::fifo_gc( &in, &out, &peekset );
+         counters.runs_with_gc++;
+      }
+      else
+      {
+         counters.runs_without_gc++;
+      }
+   } );
+   if( chain.size() == 1 )
+   {
+      while( ! *(thread_d->finished) )
+      {
+         Schedule::kernelRun( thread_d->k, *(thread_d->finished) );
+         gc();
+      }
+   }
+   else
    {
-      Schedule::kernelRun( thread_d->k, *(thread_d->finished) );
-      //takes care of peekset clearing too
-      Schedule::fifo_gc( &in, &out, &peekset );
+      /** 
+       * last kernel first so each one finds room downstream,
+       * a kernel whose next is still running and full waits
+       * for the next pass. One behind a running kernel only
+       * gets to run once that one has filled the FIFO between
+       * them, so a run() that reads several items at once 
+       * (pop_range, peek_range, or just two pops) finds as 
+       * many as the link holds.
+       */
+      std::vector< std::uint8_t > done( chain.size(), 0 );
+      std::size_t remaining( chain.size() );
+      while( remaining > 0 )
+      {
+         for( auto i( chain.size() ); i-- > 0; )
+         {
+            if( done[ i ] != 0 )
+            {
+               continue;
+            }
+            if( i + 1 < chain.size() && 
+                done[ i + 1 ] == 0 && 
+                Schedule::fusedOutputFull( chain[ i ] ) )
+            {
+               continue;
+            }
+            if( i > 0 && 
+                done[ i - 1 ] == 0 && 
+                ! Schedule::fusedOutputFull( chain[ i - 1 ] ) )
+            {
+               continue;
+            }
+            volatile bool finished( false );
+            Schedule::kernelRun( chain[ i ], finished );
+            gc();
+            if( finished )
+            {
+               done[ i ] = 1;
+               remaining--;
+            }
+         }
+      }
+      *(thread_d->finished) = true;
    }
+   Schedule::add_gc_counters( counters );
 }
@@ -48,11 +48,16 @@ stdalloc::run()
 
       assert( a.type == b.type );
       /** assume everyone needs a heap for the moment to get working **/
-      auto &func_map( a.const_map[ Type::Heap ] );
+      auto &func_map( a.const_map[ a.buffer_type ] );
       FIFO *fifo( nullptr );
       auto test_func( (*func_map)[ false ] );
       /** check and see if a has a defined allocation **/
-      if( a.existing_buffer != nullptr )
+      if( a.buffer_type == Type::Broadcast && a.getFIFO() != nullptr )
+      {
+         /** one store for every destination of a broadcast edge **/
+         fifo = a.getFIFO();
+      }
+      else if( a.existing_buffer != nullptr )
       {
          fifo = test_func( a.nitems,
                            a.start_index,
@@ -61,8 +66,8 @@ stdalloc::run()
       else
       {
          /** check for pre-existing alloc size for test purposes **/
-         fifo = test_func( a.fixed_buffer_size != 0 ?
-                              a.fixed_buffer_size : 4    /** size **/,
+         fifo = test_func( capacity_for( a.fixed_buffer_size != 0 ?
+                              a.fixed_buffer_size : 4 )  /** size **/,
                            ALLOC_ALIGN_WIDTH             /** align **/,
                            nullptr                       /** data struct **/);
       }
@@ -0,0 +1,61 @@
+/**
+ * threadaccess.cpp - 
+ * @author: agent
+ * @version: Fri Oct 16 21:04:16 2026
+ * 
+ * Copyright 2026 agent
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at:
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "threadaccess.hpp"
+
+std::atomic< std::uint64_t > ThreadAccess::global_epoch = { 0 };
+
+namespace
+{
+/**
+ * local_record - owns the calling thread's record, on thread
+ * exit the record is marked offline so no resizer waits on it, 
+ * the memory itself is leaked on purpose since a DataManager 
+ * might still point at it.
+ */
+struct local_record
+{
+   local_record() : record( new ThreadAccess() )
+   {
+      /** nothing to ack for epochs started before we existed **/
+      record->acked = ThreadAccess::global_epoch.load();
+   }
+
+   ~local_record()
+   {
+      record->acked.store( ThreadAccess::offline, 
+                           std::memory_order_release );
+   }
+
+   ThreadAccess * const record;
+};
+}
+
+ThreadAccess&
+ThreadAccess::local() noexcept
+{
+   static thread_local local_record rec;
+   return( *rec.record );
+}
+
+std::uint64_t
+ThreadAccess::request() noexcept
+{
+   return( global_epoch.fetch_add( 1, std::memory_order_seq_cst ) + 1 );
+}
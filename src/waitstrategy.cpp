@@ -0,0 +1,83 @@
+/**
+ * waitstrategy.cpp - 
+ * @author: agent
+ * @version: Fri Oct 16 22:51:38 2026
+ * 
+ * Copyright 2026 agent
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at:
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <climits>
+#include <chrono>
+#include <thread>
+#include "waitstrategy.hpp"
+
+#if defined __linux
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <ctime>
+#endif
+
+#if defined __linux && defined SYS_futex
+#define WAITSTRATEGY_FUTEX 1
+#endif
+
+void
+raft::wait::spot::wake() noexcept
+{
+   seq.fetch_add( 1, std::memory_order_release );
+#ifdef WAITSTRATEGY_FUTEX
+   syscall( SYS_futex, 
+            reinterpret_cast< std::uint32_t* >( &seq ),
+            FUTEX_WAKE_PRIVATE, 
+            INT_MAX, 
+            nullptr, 
+            nullptr, 
+            0 );
+#endif
+}
+
+void
+raft::wait::spot::sleep( const std::uint32_t expected ) noexcept
+{
+#ifdef WAITSTRATEGY_FUTEX
+   struct timespec timeout;
+   timeout.tv_sec  = WAIT_PARK_TIMEOUT_US / 1000000;
+   timeout.tv_nsec = ( WAIT_PARK_TIMEOUT_US % 1000000 ) * 1000;
+   /** 
+    * EAGAIN if seq already moved, EINTR or ETIMEDOUT are all 
+    * fine, the caller checks the queue again either way 
+    */
+   syscall( SYS_futex, 
+            reinterpret_cast< std::uint32_t* >( &seq ),
+            FUTEX_WAIT_PRIVATE,
+            expected,
+            &timeout,
+            nullptr,
+            0 );
+#else
+   /** no futex, poll at a coarse interval instead **/
+   if( seq.load( std::memory_order_acquire ) == expected )
+   {
+      std::this_thread::sleep_for( std::chrono::microseconds( 100 ) );
+   }
+#endif
+}
+
+bool
+raft::wait::single_core() noexcept
+{
+   static const bool one( std::thread::hardware_concurrency() == 1 );
+   return( one );
+}
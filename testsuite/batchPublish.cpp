@@ -0,0 +1,201 @@
+#include <cassert>
+#include <iostream>
+#include <cstdint>
+#include <cstdlib>
+#include <atomic>
+#include <algorithm>
+#include <chrono>
+#include <thread>
+#include <raft>
+#include "edgecheck.tcc"
+
+/**
+ * batched edges, items have to come through in order and
+ * none can be held back for good. The lockstep modes only
+ * push the next group once the consumer has seen the last,
+ * so they hang unless the group gets published, either by
+ * an explicit flush() or by the latency bound. On a ring
+ * of its own the consumer mustn't see a group before it's
+ * full or flushed, or lose them in a resize. A slow
+ * consumer has to get the edge grown like any other.
+ */
+enum class mode { stream, flush, latency, grow };
+
+static std::atomic< std::int64_t > seen( 0 );
+
+class producer : public raft::kernel
+{
+public:
+   producer( const mode how, const std::int64_t count ) : raft::kernel(),
+                                                          how( how ),
+                                                          count( count )
+   {
+      output.addPort< std::int64_t >( "0" );
+   }
+
+   virtual raft::kstatus run()
+   {
+      if( ( how == mode::flush || how == mode::latency ) && seen.load() != next )
+      {
+         /** last group not through yet, don't block in here **/
+         return( raft::proceed );
+      }
+      for( int i( 0 ); i < group && next < count; i++ )
+      {
+         output[ "0" ].push( next++ );
+      }
+      if( how == mode::flush )
+      {
+         output[ "0" ].flush();
+      }
+      return( next == count ? raft::stop : raft::proceed );
+   }
+
+private:
+   const mode         how;
+   const std::int64_t count;
+   std::int64_t       next  = 0;
+   const int          group = 5;
+};
+
+class consumer : public raft::kernel
+{
+public:
+   consumer( const mode how ) : raft::kernel(), how( how )
+   {
+      input.addPort< std::int64_t >( "0" );
+   }
+
+   virtual raft::kstatus run()
+   {
+      auto &port( input[ "0" ] );
+      largest = std::max( largest, port.capacity() );
+      /** slow till dynalloc has grown the edge **/
+      if( how == mode::grow && largest <= INITIAL_ALLOC_SIZE )
+      {
+         std::this_thread::sleep_for( std::chrono::milliseconds( 4 ) );
+      }
+      std::int64_t item;
+      port.pop( item );
+      seq.seen( item );
+      seen.store( seq.expected );
+      return( raft::proceed );
+   }
+
+   raft::test::sequence seq;
+   std::size_t          largest = 0;
+
+private:
+   const mode           how;
+};
+
+template < Type::RingBufferType type > bool run( const mode how,
+                                                 const std::int64_t count,
+                                                 const char *name )
+{
+   seen.store( 0 );
+   producer p( how, count );
+   consumer c( how );
+   raft::map m;
+   /** dynalloc leaves fixed size edges alone **/
+   const std::size_t buffer( how == mode::grow ? 0 : 64 );
+   m.link< raft::order::in, type >( &p, &c, buffer, raft::batch( 16 ) );
+   m.exe();
+   if( how == mode::grow && c.largest <= INITIAL_ALLOC_SIZE )
+   {
+      std::cerr << name << ": batched edge never grew\n";
+      return( false );
+   }
+   return( c.seq.complete( name, count ) );
+}
+
+/**
+ * deferred - the first item goes out at once, nobody's
+ * waiting on the rest, they stay hidden till there's a full
+ * batch or a flush().
+ */
+template < Type::RingBufferType type > bool deferred( const char *name )
+{
+   auto *fifo( RingBuffer< std::int64_t, type, false >::make_new_fifo( 
+      64, 64, nullptr ) );
+   fifo->set_batch( raft::batch( 16 ) );
+   std::int64_t next( 0 );
+   auto push = [&]( const int n )
+   {
+      for( int i( 0 ); i < n; i++ )
+      {
+         fifo->push( next++ );
+      }
+      return( fifo->size() );
+   };
+   const auto early( push( 5 ) );
+   fifo->flush();
+   const auto flushed( fifo->size() );
+   const auto full( push( 16 ) );
+   delete( fifo );
+   if( early != 1 || flushed != 5 || full != 21 )
+   {
+      std::cerr << name << ": consumer saw " << early << ", " << flushed << 
+         ", " << full << " items, wanted 1, 5, 21\n";
+      return( false );
+   }
+   return( true );
+}
+
+/**
+ * resized - items written but not published yet have to
+ * survive a resize, and still go out on the next flush().
+ */
+template < Type::RingBufferType type > bool resized( const char *name )
+{
+   auto *fifo( RingBuffer< std::int64_t, type, false >::make_new_fifo( 
+      64, 64, nullptr ) );
+   fifo->set_batch( raft::batch( 16 ) );
+   for( std::int64_t i( 0 ); i < 5; i++ )
+   {
+      fifo->push( i );
+   }
+   /** we're both ends, let the resize through **/
+   ThreadAccess::local().go_offline();
+   volatile bool exit_alloc( false );
+   fifo->resize( 128, 64, exit_alloc );
+   const auto cap( fifo->capacity() );
+   fifo->flush();
+   raft::test::sequence seq;
+   const auto flushed( fifo->size() );
+   for( std::int64_t i( 0 ); i < 5; i++ )
+   {
+      std::int64_t item;
+      fifo->pop( item );
+      seq.seen( item );
+   }
+   delete( fifo );
+   if( cap != 128 || flushed != 5 )
+   {
+      std::cerr << name << ": capacity " << cap << ", " << flushed << 
+         " items after the flush, wanted 128 and 5\n";
+      return( false );
+   }
+   return( seq.complete( name, 5 ) );
+}
+
+int
+main()
+{
+   if( ! run< Type::Heap >( mode::stream,  100000, "heap stream" ) ||
+       ! run< Type::SPSC >( mode::stream,  100000, "spsc stream" ) ||
+       ! run< Type::Heap >( mode::flush,   2000,   "heap flush" ) ||
+       ! run< Type::SPSC >( mode::flush,   2000,   "spsc flush" ) ||
+       ! run< Type::Heap >( mode::latency, 2000,   "heap latency" ) ||
+       ! run< Type::SPSC >( mode::latency, 2000,   "spsc latency" ) ||
+       ! deferred< Type::Heap >( "heap deferred" ) ||
+       ! deferred< Type::SPSC >( "spsc deferred" ) ||
+       ! resized< Type::Heap >( "heap resized" ) ||
+       ! resized< Type::SPSC >( "spsc resized" ) ||
+       ! run< Type::Heap >( mode::grow,    1000,   "heap grow" ) ||
+       ! run< Type::SPSC >( mode::grow,    1000,   "spsc grow" ) )
+   {
+      return( EXIT_FAILURE );
+   }
+   return( EXIT_SUCCESS );
+}
@@ -0,0 +1,149 @@
+#include <cassert>
+#include <iostream>
+#include <cstdint>
+#include <cstdlib>
+#include <vector>
+#include <memory>
+#include <raft>
+#include "edgecheck.tcc"
+
+/** bigger than a cache line so the store holds pointers **/
+struct big_t
+{
+   big_t() = default;
+   big_t( const std::int64_t v ) : value( v )
+   {
+      for( auto &p : pad )
+      {
+         p = v;
+      }
+   }
+
+   std::int64_t value = 0;
+   std::int64_t pad[ 15 ];
+};
+
+static std::int64_t value_of( const std::int64_t v ){ return( v ); }
+static std::int64_t value_of( const big_t &v )
+{
+   /** make sure the whole item came through **/
+   return( v.pad[ 14 ] == v.value ? v.value : -1 );
+}
+
+/**
+ * every consumer has to see every item in order, each one
+ * reads a different way so they run at different speeds
+ * and the store can only be reused once the slowest is past.
+ * Before reading anything each one notes where the first
+ * item lives, with a single shared store that's the same
+ * address for all of them.
+ */
+template < class T > class consumer : public raft::kernel
+{
+public:
+   consumer( const int mode ) : raft::kernel(), mode( mode )
+   {
+      input.addPort< T >( "0" );
+   }
+
+   virtual raft::kstatus run()
+   {
+      auto &port( input[ "0" ] );
+      if( first == nullptr )
+      {
+         first = &port.template peek< T >();
+         port.unpeek();
+      }
+      switch( mode )
+      {
+         case( 0 ):
+         {
+            T item;
+            port.pop( item );
+            check( item );
+         }
+         break;
+         case( 1 ):
+         {
+            auto &item( port.template peek< T >() );
+            check( item );
+            port.unpeek();
+            port.recycle();
+         }
+         break;
+         default:
+         {
+            /** single items near the end, the stream may not divide by 3 **/
+            if( port.size() >= 3 )
+            {
+               auto range( port.template peek_range< T >( 3 ) );
+               for( std::size_t i( 0 ); i < 3; i++ )
+               {
+                  check( range[ i ].ele );
+               }
+               port.unpeek();
+               port.recycle( 3 );
+            }
+            else
+            {
+               T item;
+               port.pop( item );
+               check( item );
+            }
+         }
+      }
+      return( raft::proceed );
+   }
+
+   void check( const T &item )
+   {
+      seq.seen( value_of( item ) );
+   }
+
+   raft::test::sequence seq;
+   const T              *first = nullptr;
+private:
+   const int    mode;
+};
+
+template < class T > bool run( const std::int64_t count,
+                               const int          modes,
+                               const char         *name )
+{
+   const int consumers( 4 );
+   raft::test::source< T > p( count );
+   std::vector< std::unique_ptr< consumer< T > > > c;
+   raft::map m;
+   for( int i( 0 ); i < consumers; i++ )
+   {
+      c.emplace_back( new consumer< T >( i % modes ) );
+      m.link< raft::order::in, Type::Broadcast >( &p, c.back().get(), 64 );
+   }
+   m.exe();
+   for( const auto &consumer : c )
+   {
+      if( ! consumer->seq.complete( name, count ) )
+      {
+         return( false );
+      }
+      if( consumer->first != c.front()->first )
+      {
+         std::cerr << name << ": consumers read from different stores\n";
+         return( false );
+      }
+   }
+   return( true );
+}
+
+int
+main()
+{
+   const std::int64_t count( 50000 );
+   /** no peek_range for external types, skip that mode **/
+   if( ! run< std::int64_t >( count, 3, "inline" ) ||
+       ! run< big_t >( count, 2, "external" ) )
+   {
+      return( EXIT_FAILURE );
+   }
+   return( EXIT_SUCCESS );
+}
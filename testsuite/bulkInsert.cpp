@@ -0,0 +1,238 @@
+#include <cassert>
+#include <iostream>
+#include <cstdint>
+#include <cstdlib>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <deque>
+#include <raft>
+#include "edgecheck.tcc"
+
+/**
+ * bulk insert and pop_range with odd sized blocks so they
+ * wrap the 64 item queue at every offset, some bigger than
+ * the whole queue. Every item must come out in order. Items
+ * of the wrong size and iterators the queue doesn't take have
+ * to be refused, trivially copyable items must skip the item 
+ * at a time push and pop.
+ */
+static const std::int64_t total( 100000 );
+
+template < class T > T item_for( const std::int64_t i ){ return( static_cast< T >( i ) ); }
+template <> std::string item_for< std::string >( const std::int64_t i )
+{
+   return( std::to_string( i ) );
+}
+
+template < class T > class producer : public raft::kernel
+{
+public:
+   producer() : raft::kernel()
+   {
+      output.addPort< T >( "0" );
+   }
+
+   virtual raft::kstatus run()
+   {
+      const std::int64_t block( std::min( sizes[ round++ % 4 ], total - next ) );
+      std::vector< T > items;
+      for( std::int64_t i( 0 ); i < block; i++ )
+      {
+         items.emplace_back( item_for< T >( next++ ) );
+      }
+      /** pointer and length, and the iterator version **/
+      if( round % 2 == 0 )
+      {
+         output[ "0" ].insert( items.data(), items.size() );
+      }
+      else
+      {
+         output[ "0" ].insert( items.begin(), items.end() );
+      }
+      return( next == total ? raft::stop : raft::proceed );
+   }
+
+private:
+   const std::int64_t sizes[ 4 ] = { 13, 1, 150, 37 };
+   std::int64_t       next  = 0;
+   std::size_t        round = 0;
+};
+
+template < class T > class consumer : public raft::kernel
+{
+public:
+   consumer() : raft::kernel()
+   {
+      input.addPort< T >( "0" );
+   }
+
+   virtual raft::kstatus run()
+   {
+      const std::int64_t block( std::min( sizes[ round++ % 3 ], total - seq.expected ) );
+      if( round % 2 == 0 )
+      {
+         std::vector< T > items( block );
+         std::vector< raft::signal > sigs( block );
+         input[ "0" ].pop_range( items.data(), items.size(), sigs.data() );
+         for( const auto &item : items )
+         {
+            check( item );
+         }
+      }
+      else
+      {
+         std::vector< std::pair< T, raft::signal > > items( block );
+         input[ "0" ].pop_range( items, items.size() );
+         for( const auto &pair : items )
+         {
+            check( pair.first );
+         }
+      }
+      return( seq.expected == total ? raft::stop : raft::proceed );
+   }
+
+   void check( const T &item )
+   {
+      seq.check( item == item_for< T >( seq.expected ) );
+   }
+
+   raft::test::sequence seq;
+
+private:
+   const std::int64_t sizes[ 3 ] = { 7, 100, 64 };
+   std::size_t        round = 0;
+};
+
+template < class T > bool run( const char *name )
+{
+   producer< T > p;
+   consumer< T > c;
+   raft::map m;
+   m.link< raft::order::in, Type::Heap >( &p, &c, 64 );
+   m.exe();
+   return( c.seq.complete( name, total ) );
+}
+
+/** counting_ring - counts the items that go through one at a time **/
+template < class T > class counting_ring :
+   public RingBuffer< T, Type::Heap, false >
+{
+public:
+   counting_ring() : RingBuffer< T, Type::Heap, false >( 64, 64 )
+   {
+   }
+
+   virtual void local_push( void *ptr, const raft::signal &signal )
+   {
+      pushes++;
+      RingBuffer< T, Type::Heap, false >::local_push( ptr, signal );
+   }
+
+   virtual void local_pop( void *ptr, raft::signal *signal )
+   {
+      pops++;
+      RingBuffer< T, Type::Heap, false >::local_pop( ptr, signal );
+   }
+
+   std::size_t pushes = 0;
+   std::size_t pops   = 0;
+};
+
+template < class T > bool path( const bool bulk, const char *name )
+{
+   counting_ring< T > ring;
+   std::vector< T > items;
+   for( std::int64_t i( 0 ); i < 40; i++ )
+   {
+      items.emplace_back( item_for< T >( i ) );
+   }
+   ring.insert( items.data(), items.size() );
+   std::vector< T > out( items.size() );
+   ring.pop_range( out.data(), out.size() );
+   const std::size_t one_at_a_time( bulk ? 0 : items.size() );
+   if( out != items || 
+       ring.pushes != one_at_a_time || 
+       ring.pops   != one_at_a_time )
+   {
+      std::cerr << name << ": " << ring.pushes << " single pushes, " << 
+         ring.pops << " single pops for " << items.size() << " items\n";
+      return( false );
+   }
+   return( true );
+}
+
+static bool size_mismatch()
+{
+   auto *fifo( RingBuffer< std::int64_t, Type::Heap, false >::make_new_fifo( 
+      64, 64, nullptr ) );
+   std::int32_t items[ 4 ] = { 0, 1, 2, 3 };
+   bool insert_threw( false );
+   bool pop_threw( false );
+   try
+   {
+      fifo->insert( items, 4 );
+   }
+   catch( PortTypeMismatchException & )
+   {
+      insert_threw = true;
+   }
+   try
+   {
+      fifo->pop_range( items, 4 );
+   }
+   catch( PortTypeMismatchException & )
+   {
+      pop_threw = true;
+   }
+   const bool untouched( fifo->size() == 0 );
+   delete( fifo );
+   if( ! insert_threw || ! pop_threw || ! untouched )
+   {
+      std::cerr << "bulk access with the wrong item size wasn't refused\n";
+      return( false );
+   }
+   return( true );
+}
+
+/** unknown_iterator - only list and vector ranges can be inserted **/
+static bool unknown_iterator()
+{
+   auto *fifo( RingBuffer< std::int64_t, Type::Heap, false >::make_new_fifo( 
+      64, 64, nullptr ) );
+   std::deque< std::int64_t > items( 4, 1 );
+   bool threw( false );
+   try
+   {
+      fifo->insert( items.begin(), items.end() );
+   }
+   catch( PortTypeMismatchException & )
+   {
+      threw = true;
+   }
+   const bool untouched( fifo->size() == 0 );
+   delete( fifo );
+   if( ! threw || ! untouched )
+   {
+      std::cerr << "insert from a std::deque wasn't refused\n";
+      return( false );
+   }
+   return( true );
+}
+
+int
+main()
+{
+   /** memcpy path, then the item at a time fallback **/
+   if( ! run< float >( "float" ) ||
+       ! run< std::int64_t >( "int64" ) ||
+       ! run< std::string >( "string" ) ||
+       ! path< std::int64_t >( true, "int64" ) ||
+       ! path< std::string >( false, "string" ) ||
+       ! size_mismatch() ||
+       ! unknown_iterator() )
+   {
+      return( EXIT_FAILURE );
+   }
+   return( EXIT_SUCCESS );
+}
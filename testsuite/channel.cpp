@@ -0,0 +1,145 @@
+#include <cassert>
+#include <iostream>
+#include <cstdint>
+#include <cstdlib>
+#include <string>
+#include <raft>
+
+/**
+ * typed channels on both ends of an SPSC link of plain items
+ * and a Heap link of strings. Every call kind goes through the
+ * channel, signals included, and a channel of the wrong ring
+ * type has to throw on first use instead of touching the FIFO.
+ */
+static const std::int64_t total( 100000 );
+
+static raft::signal signal_for( const std::int64_t i )
+{
+   return( i % 99 == 0 ? static_cast< raft::signal >( raft::eof + 1 ) : raft::none );
+}
+
+class producer : public raft::kernel
+{
+public:
+   producer() : raft::kernel()
+   {
+      output.addPort< std::int64_t >( "0" );
+      output.addPort< std::string >( "1" );
+      nums = output.channel< std::int64_t, Type::SPSC >( "0" );
+      strs = output.channel< std::string >( "1" );
+   }
+
+   virtual raft::kstatus run()
+   {
+      switch( next % 3 )
+      {
+         case( 0 ):
+            nums.push( next, signal_for( next ) );
+            break;
+         case( 1 ):
+            nums.allocate() = next;
+            nums.send();
+            break;
+         default:
+         {
+            std::int64_t items[ 1 ] = { next };
+            nums.insert( items, 1 );
+         }
+      }
+      strs.push( std::to_string( next ) );
+      next++;
+      return( next == total ? raft::stop : raft::proceed );
+   }
+
+private:
+   raft::channel< std::int64_t, Type::SPSC > nums;
+   raft::channel< std::string >              strs;
+   std::int64_t next = 0;
+};
+
+class consumer : public raft::kernel
+{
+public:
+   consumer() : raft::kernel()
+   {
+      input.addPort< std::int64_t >( "0" );
+      input.addPort< std::string >( "1" );
+      nums  = input.channel< std::int64_t, Type::SPSC >( "0" );
+      wrong = input.channel< std::int64_t, Type::Heap >( "0" );
+      strs  = input.channel< std::string >( "1" );
+   }
+
+   virtual raft::kstatus run()
+   {
+      if( expected == 0 )
+      {
+         try
+         {
+            wrong.size();
+         }
+         catch( PortTypeMismatchException & )
+         {
+            threw = true;
+         }
+      }
+      std::int64_t v( -1 );
+      switch( expected % 3 )
+      {
+         case( 0 ):
+         {
+            raft::signal sig( raft::none );
+            nums.pop( v, &sig );
+            if( sig != signal_for( expected ) )
+            {
+               failed = true;
+            }
+            break;
+         }
+         case( 1 ):
+            v = nums.peek();
+            nums.unpeek();
+            nums.recycle();
+            break;
+         default:
+            nums.pop_range( &v, 1 );
+      }
+      std::string s;
+      strs.pop( s );
+      if( v != expected || s != std::to_string( expected ) )
+      {
+         failed = true;
+      }
+      expected++;
+      return( raft::proceed );
+   }
+
+   raft::channel< std::int64_t, Type::SPSC > nums;
+   raft::channel< std::int64_t, Type::Heap > wrong;
+   raft::channel< std::string >              strs;
+   std::int64_t expected = 0;
+   bool         failed   = false;
+   bool         threw    = false;
+};
+
+int
+main()
+{
+   producer p;
+   consumer c;
+   raft::map m;
+   m.link< raft::order::in, Type::SPSC >( &p, "0", &c, "0" );
+   m.link( &p, "1", &c, "1" );
+   m.exe();
+   if( ! c.threw )
+   {
+      std::cerr << "channel of the wrong ring type didn't throw\n";
+      return( EXIT_FAILURE );
+   }
+   if( c.failed || c.expected != total )
+   {
+      std::cerr << "items lost or out of order, got " << c.expected <<
+         " of " << total << "\n";
+      return( EXIT_FAILURE );
+   }
+   return( EXIT_SUCCESS );
+}
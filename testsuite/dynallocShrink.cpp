@@ -0,0 +1,153 @@
+#include <cassert>
+#include <iostream>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <thread>
+#include <raft>
+
+/**
+ * a slow consumer makes dynalloc grow the edge, then the
+ * producer goes idle so the edge drains and dynalloc has to
+ * halve it again, no sooner than the holdoff after the grow.
+ * With a holdoff longer than the run the edge must stay big,
+ * either way the map has to report the footprint.
+ */
+using clock_type = std::chrono::steady_clock;
+
+class producer : public raft::kernel
+{
+public:
+   producer( const clock_type::duration idle_for ) : raft::kernel(),
+                                                     idle_for( idle_for )
+   {
+      output.addPort< std::int64_t >( "0" );
+   }
+
+   virtual raft::kstatus run()
+   {
+      auto &port( output[ "0" ] );
+      const auto cap( port.capacity() );
+      if( ! grew )
+      {
+         port.push( next++ );
+         if( port.capacity() > cap )
+         {
+            grew    = true;
+            grew_at = clock_type::now();
+            largest = port.capacity();
+         }
+         return( raft::proceed );
+      }
+      /** idle, nothing goes out until the edge shrinks or time's up **/
+      if( cap < largest )
+      {
+         shrunk    = true;
+         shrunk_at = clock_type::now();
+         return( raft::stop );
+      }
+      if( clock_type::now() - grew_at > idle_for )
+      {
+         return( raft::stop );
+      }
+      std::this_thread::sleep_for( std::chrono::milliseconds( 1 ) );
+      return( raft::proceed );
+   }
+
+   bool                   grew    = false;
+   bool                   shrunk  = false;
+   clock_type::time_point grew_at;
+   clock_type::time_point shrunk_at;
+
+private:
+   const clock_type::duration idle_for;
+   std::int64_t next    = 0;
+   std::size_t  largest = 0;
+};
+
+class consumer : public raft::kernel
+{
+public:
+   consumer() : raft::kernel()
+   {
+      input.addPort< std::int64_t >( "0" );
+   }
+
+   virtual raft::kstatus run()
+   {
+      auto &port( input[ "0" ] );
+      /** slow until the edge has grown, then drain it **/
+      if( port.capacity() <= INITIAL_ALLOC_SIZE )
+      {
+         std::this_thread::sleep_for( std::chrono::milliseconds( 4 ) );
+      }
+      std::int64_t v;
+      port.pop( v );
+      if( v != expected++ )
+      {
+         in_order = false;
+      }
+      return( raft::proceed );
+   }
+
+   bool         in_order = true;
+   std::int64_t expected = 0;
+};
+
+static bool
+run_map( const std::size_t holdoff, const clock_type::duration idle_for,
+         const bool expect_shrink )
+{
+   producer p( idle_for );
+   consumer c;
+   raft::map m;
+   raft::shrink_policy policy;
+   policy.window  = 5;
+   policy.holdoff = holdoff;
+   m.set_shrink( policy );
+   m += p >> c;
+   m.exe();
+   if( ! p.grew || ! c.in_order || c.expected == 0 )
+   {
+      std::cerr << "edge never grew or items were lost\n";
+      return( false );
+   }
+   if( m.footprint() == 0 || m.peak_footprint() < m.footprint() )
+   {
+      std::cerr << "footprint not reported by the map\n";
+      return( false );
+   }
+   if( p.shrunk != expect_shrink )
+   {
+      std::cerr << "idle edge " << ( p.shrunk ? "shrunk" : "didn't shrink" ) <<
+         " with a holdoff of " << holdoff << " passes\n";
+      return( false );
+   }
+   if( ! expect_shrink )
+   {
+      return( m.peak_footprint() == m.footprint() );
+   }
+   /**
+    * every pass sleeps at least the interval, the grow is seen
+    * within a couple of them, a shrink before that is too soon
+    */
+   const auto holdoff_time( std::chrono::microseconds(
+      DYNALLOC_MONITOR_INTERVAL_US * ( holdoff - 2 ) ) );
+   if( p.shrunk_at - p.grew_at < holdoff_time )
+   {
+      std::cerr << "edge shrunk before the holdoff was up\n";
+      return( false );
+   }
+   return( m.peak_footprint() > m.footprint() );
+}
+
+int
+main()
+{
+   if( ! run_map( 40, std::chrono::seconds( 10 ), true ) ||
+       ! run_map( 1000000, std::chrono::milliseconds( 300 ), false ) )
+   {
+      return( EXIT_FAILURE );
+   }
+   return( EXIT_SUCCESS );
+}
@@ -0,0 +1,121 @@
+/**
+ * edgecheck.tcc - shared by the tests that send a numbered
+ * stream over an edge and check that it comes out whole and
+ * in order. Each test checks its own feature on top of that.
+ * @author: agent
+ * @version: Sat Oct 17 02:28:06 2026
+ *
+ * Copyright 2026 agent
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at:
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef EDGECHECK_TCC
+#define EDGECHECK_TCC  1
+#include <cstdint>
+#include <iostream>
+
+namespace raft
+{
+
+namespace test
+{
+
+/**
+ * sequence - consumer side, call check() (or seen()) for each
+ * item in the order they come out.
+ */
+struct sequence
+{
+   /** check - ok is false if item number expected was wrong **/
+   void check( const bool ok ) noexcept
+   {
+      if( ! ok )
+      {
+         failed = true;
+      }
+      expected++;
+   }
+
+   /** seen - the item carried number n **/
+   void seen( const std::int64_t n ) noexcept
+   {
+      check( n == expected );
+   }
+
+   /**
+    * complete - true if exactly count items came out and all
+    * were right, else says so on std::cerr.
+    * @param   name - const char*, for the message
+    * @param   count - const std::int64_t
+    * @return  bool
+    */
+   bool complete( const char * const name, const std::int64_t count ) const
+   {
+      if( failed || expected != count )
+      {
+         std::cerr << name << ": items lost, corrupted or out of order, got " <<
+            expected << " of " << count << "\n";
+         return( false );
+      }
+      return( true );
+   }
+
+   std::int64_t expected = 0;
+   bool         failed   = false;
+};
+
+/** source - pushes T( 0 ) ... T( count - 1 ), one per run() **/
+template < class T > class source : public raft::kernel
+{
+public:
+   source( const std::int64_t count ) : raft::kernel(),
+                                        count( count )
+   {
+      output.addPort< T >( "0" );
+   }
+
+   virtual raft::kstatus run()
+   {
+      output[ "0" ].push( T( next++ ) );
+      return( next == count ? raft::stop : raft::proceed );
+   }
+
+private:
+   const std::int64_t count;
+   std::int64_t       next = 0;
+};
+
+/** sink - pops one integer per run() into seq **/
+template < class T > class sink : public raft::kernel
+{
+public:
+   sink() : raft::kernel()
+   {
+      input.addPort< T >( "0" );
+   }
+
+   virtual raft::kstatus run()
+   {
+      T item;
+      input[ "0" ].pop( item );
+      seq.seen( static_cast< std::int64_t >( item ) );
+      return( raft::proceed );
+   }
+
+   sequence seq;
+};
+
+} /** end namespace test **/
+
+} /** end namespace raft **/
+#endif /* END EDGECHECK_TCC */
@@ -0,0 +1,157 @@
+#include <cassert>
+#include <iostream>
+#include <cstdint>
+#include <cstdlib>
+#include <algorithm>
+#include <raft>
+#include "edgecheck.tcc"
+
+/**
+ * allocate_range and peek_range on externally allocated (too
+ * big for a cache line) items. The middle kernel pushes the
+ * peeked objects on unchanged, so each one is handed over
+ * rather than copied, which the copies counter checks.
+ */
+struct tile
+{
+   tile() = default;
+
+   tile( const tile &other ) : id( other.id )
+   {
+      std::copy( other.pixels, other.pixels + 32, pixels );
+      copies++;
+   }
+
+   tile( tile &&other ) = default;
+
+   tile& operator = ( const tile &other )
+   {
+      id = other.id;
+      std::copy( other.pixels, other.pixels + 32, pixels );
+      copies++;
+      return( *this );
+   }
+
+   tile& operator = ( tile &&other ) = default;
+
+   std::int64_t id = -1;
+   std::int64_t pixels[ 32 ];
+
+   /** per thread, each kernel runs on its own **/
+   static thread_local std::size_t copies;
+};
+
+thread_local std::size_t tile::copies = 0;
+
+static const std::int64_t total( 12000 );
+
+class producer : public raft::kernel
+{
+public:
+   producer() : raft::kernel()
+   {
+      output.addPort< tile >( "0" );
+   }
+
+   virtual raft::kstatus run()
+   {
+      auto range( output[ "0" ].allocate_range< tile >( 4 ) );
+      for( tile &t : range )
+      {
+         t.id = next;
+         t.pixels[ 31 ] = next * 3;
+         next++;
+      }
+      output[ "0" ].send_range();
+      return( next == total ? raft::stop : raft::proceed );
+   }
+
+private:
+   std::int64_t next = 0;
+};
+
+class forward : public raft::kernel
+{
+public:
+   forward() : raft::kernel()
+   {
+      input.addPort< tile >( "0" );
+      output.addPort< tile >( "0" );
+   }
+
+   virtual raft::kstatus run()
+   {
+      auto &in( input[ "0" ] );
+      try
+      {
+         auto range( in.peek_range< tile >( 3 ) );
+         const auto before( tile::copies );
+         for( std::size_t i( 0 ); i < 3; i++ )
+         {
+            output[ "0" ].push( range[ i ].ele );
+         }
+         copies += tile::copies - before;
+      }
+      catch( ClosedPortAccessException & )
+      {
+         return( raft::stop );
+      }
+      in.recycle( 3 );
+      return( raft::proceed );
+   }
+
+   std::size_t copies = 0;
+};
+
+class consumer : public raft::kernel
+{
+public:
+   consumer() : raft::kernel()
+   {
+      input.addPort< tile >( "0" );
+   }
+
+   virtual raft::kstatus run()
+   {
+      tile t;
+      input[ "0" ].pop( t );
+      seq.check( t.id == seq.expected && t.pixels[ 31 ] == seq.expected * 3 );
+      return( raft::proceed );
+   }
+
+   raft::test::sequence seq;
+};
+
+template < Type::RingBufferType type > bool run( const char *name )
+{
+   producer p;
+   forward  f;
+   consumer c;
+   raft::map m;
+   m.link< raft::order::in, type >( &p, &f );
+   m.link< raft::order::in, type >( &f, &c );
+   m.exe();
+   if( ! c.seq.complete( name, total ) )
+   {
+      return( false );
+   }
+   if( f.copies != 0 )
+   {
+      std::cerr << name << ": " << f.copies << " tiles copied on the way through\n";
+      return( false );
+   }
+   return( true );
+}
+
+int
+main()
+{
+   static_assert( ext_alloc< tile >::value, "tile should be externally allocated" );
+   if( ! run< Type::Heap >( "heap" ) ||
+       ! run< Type::SPSC >( "spsc" ) ||
+       ! run< Type::Infinite >( "infinite" ) )
+   {
+      return( EXIT_FAILURE );
+   }
+   return( EXIT_SUCCESS );
+}
@@ -0,0 +1,185 @@
+#include <cassert>
+#include <iostream>
+#include <cstdint>
+#include <cstdlib>
+#include <vector>
+#include <memory>
+#include <raft>
+#include "fanin.hpp"
+
+using type_t = std::int64_t;
+
+/** producer id in the high bits, sequence number in the low **/
+static constexpr type_t shift( 32 );
+
+class producer : public raft::kernel
+{
+public:
+   producer( const type_t id, const type_t count ) : raft::kernel(),
+                                                     id( id ),
+                                                     count( count )
+   {
+      output.addPort< type_t >( "0" );
+   }
+
+   virtual raft::kstatus run()
+   {
+      output[ "0" ].push( ( id << shift ) | next++ );
+      return( next == count ? raft::stop : raft::proceed );
+   }
+
+private:
+   const type_t id;
+   const type_t count;
+   type_t       next = 0;
+};
+
+class consumer : public raft::kernel
+{
+public:
+   consumer( const std::size_t producers,
+             const type_t      range_stop ) : raft::kernel(),
+                                              expected( producers, 0 ),
+                                              range_stop( range_stop )
+   {
+      input.addPort< type_t >( "0" );
+   }
+
+   virtual raft::kstatus run()
+   {
+      auto &port( input[ "0" ] );
+      /** mix pops, peeks and peek_range to cover all paths **/
+      /**
+       * a range has to come from a single ring (see ranges()
+       * below), near the end the rings drain one by one so 
+       * stick to single items
+       */
+      const auto mode( total < range_stop ? round++ % 3 : 0 );
+      switch( mode )
+      {
+         case( 0 ):
+         {
+            type_t item;
+            port.pop( item );
+            check( item );
+         }
+         break;
+         case( 1 ):
+         {
+            auto &item( port.peek< type_t >() );
+            check( item );
+            port.unpeek();
+            port.recycle();
+         }
+         break;
+         default:
+         {
+            /** odd length so ranges wrap the 64 item rings **/
+            auto range( port.peek_range< type_t >( 3 ) );
+            for( std::size_t i( 0 ); i < 3; i++ )
+            {
+               check( range[ i ].ele );
+            }
+            port.unpeek();
+            port.recycle( 3 );
+         }
+      }
+      return( raft::proceed );
+   }
+
+   void check( const type_t item )
+   {
+      const auto id( static_cast< std::size_t >( item >> shift ) );
+      const auto seq( item & ( ( type_t( 1 ) << shift ) - 1 ) );
+      if( id >= expected.size() || expected[ id ] != seq )
+      {
+         failed = true;
+         return;
+      }
+      expected[ id ]++;
+      total++;
+   }
+
+   std::vector< type_t > expected;
+   type_t                total  = 0;
+   bool                  failed = false;
+private:
+   const type_t          range_stop;
+   std::size_t           round  = 0;
+};
+
+/**
+ * peek_range needs all of its items on one producer's ring, with
+ * two closed rings of two items each peek_range( 3 ) throws even
+ * though size() is 4, the array pop_range takes from both. The
+ * capacity is the sum over the rings whatever was read last, and
+ * producer calls on the consumer's end throw.
+ */
+static bool ranges()
+{
+   using ring = RingBuffer< type_t, Type::Heap, false >;
+   std::unique_ptr< FIFO > a( ring::make_new_fifo( 64, 64, nullptr ) );
+   std::unique_ptr< FIFO > b( ring::make_new_fifo( 64, 64, nullptr ) );
+   std::unique_ptr< FIFO > merge( FanIn::make_new_fifo( 0, 0, nullptr ) );
+   static_cast< FanIn* >( merge.get() )->add_source( a.get() );
+   static_cast< FanIn* >( merge.get() )->add_source( b.get() );
+   for( type_t i( 0 ); i < 2; i++ )
+   {
+      a->push( i );
+      b->push( ( type_t( 1 ) << shift ) | i );
+   }
+   a->invalidate();
+   b->invalidate();
+   bool ok( merge->size() == 4 && merge->capacity() == 128 );
+   try
+   {
+      merge->peek_range< type_t >( 3 );
+      ok = false;
+   }
+   catch( NoMoreDataException & )
+   {
+   }
+   type_t items[ 3 ];
+   merge->pop_range( items, 3 );
+   ok = ok && merge->size() == 1 && merge->capacity() == 128;
+   try
+   {
+      merge->push( items[ 0 ] );
+      ok = false;
+   }
+   catch( PortTypeMismatchException & )
+   {
+   }
+   if( ! ok )
+   {
+      std::cerr << "FanIn ranges, capacity or producer calls wrong\n";
+   }
+   return( ok );
+}
+
+int
+main()
+{
+   if( ! ranges() )
+   {
+      return( EXIT_FAILURE );
+   }
+   const std::size_t producers( 8 );
+   const type_t      count( 20000 );
+   std::vector< std::unique_ptr< producer > > p;
+   consumer c( producers, count );
+   raft::map m;
+   for( std::size_t i( 0 ); i < producers; i++ )
+   {
+      p.emplace_back( new producer( i, count ) );
+      m.link< raft::order::in, Type::FanIn >( p.back().get(), &c, 64 );
+   }
+   m.exe();
+   if( c.failed || c.total != count * static_cast< type_t >( producers ) )
+   {
+      std::cerr << "items lost or out of order per producer, got " << 
+         c.total << "\n";
+      return( EXIT_FAILURE );
+   }
+   return( EXIT_SUCCESS );
+}
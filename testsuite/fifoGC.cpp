@@ -0,0 +1,111 @@
+#include <cassert>
+#include <iostream>
+#include <cstdint>
+#include <cstdlib>
+#include <raft>
+
+/** bigger than a cache line so it takes the ext_alloc path **/
+struct record
+{
+   record( const std::int64_t v = 0 ) : value( v ){}
+
+   std::int64_t value;
+   char         pad[ L1D_CACHE_LINE_SIZE * 2 ];
+};
+
+template < class T > class producer : public raft::kernel
+{
+public:
+   producer( const std::int64_t count ) : raft::kernel(), count( count )
+   {
+      output.addPort< T >( "0" );
+   }
+
+   virtual raft::kstatus run()
+   {
+      for( std::int64_t i( 0 ); i < count; i++ )
+      {
+         T item( i );
+         output[ "0" ].push( item, i == count - 1 ? raft::eof : raft::none );
+      }
+      return( raft::stop );
+   }
+private:
+   const std::int64_t count;
+};
+
+/** 
+ * looks at each item then drops it, every one of these
+ * has to be freed by fifo_gc.
+ */
+template < class T > class consumer : public raft::kernel
+{
+public:
+   consumer() : raft::kernel()
+   {
+      input.addPort< T >( "0" );
+   }
+
+   virtual raft::kstatus run()
+   {
+      auto &item( input[ "0" ].template peek< T >() );
+      if( static_cast< std::int64_t >( item ) != expected++ )
+      {
+         failed = true;
+      }
+      input[ "0" ].recycle();
+      return( raft::proceed );
+   }
+
+   std::int64_t expected = 0;
+   bool         failed   = false;
+};
+
+/** lets the consumer template compare records and ints the same way **/
+struct record_item : record
+{
+   using record::record;
+   operator std::int64_t() const { return( value ); }
+};
+
+int
+main()
+{
+   const std::int64_t count( 1000 );
+   {
+      producer< record_item > p( count );
+      consumer< record_item > c;
+      raft::map m;
+      m += p >> c;
+      m.exe();
+      if( c.failed || c.expected != count )
+      {
+         std::cerr << "records out of order\n";
+         return( EXIT_FAILURE );
+      }
+   }
+   const auto after_ext( Schedule::get_gc_counters() );
+   if( after_ext.items_reclaimed != static_cast< std::uint64_t >( count ) ||
+       after_ext.runs_without_gc != 0 )
+   {
+      std::cerr << "expected " << count << " reclaimed, got " << 
+         after_ext.items_reclaimed << "\n";
+      return( EXIT_FAILURE );
+   }
+   {
+      producer< std::int64_t > p( count );
+      consumer< std::int64_t > c;
+      raft::map m;
+      m += p >> c;
+      m.exe();
+   }
+   const auto after_inline( Schedule::get_gc_counters() );
+   /** inline types never need the reclaim lists **/
+   if( after_inline.runs_with_gc != after_ext.runs_with_gc || 
+       after_inline.runs_without_gc == 0 )
+   {
+      std::cerr << "fifo_gc was run for a kernel with only inline ports\n";
+      return( EXIT_FAILURE );
+   }
+   return( EXIT_SUCCESS );
+}
@@ -0,0 +1,326 @@
+#include <cassert>
+#include <iostream>
+#include <cstdint>
+#include <cstdlib>
+#include <memory>
+#include <thread>
+#include <raft>
+
+/**
+ * source >> keep_even >> scale >> sink with fusion on has to
+ * give the same items, in the same order, with the same
+ * signals as without it, and with it on all four kernels have
+ * to run on the one thread. A fused kernel that reads several
+ * items per run has to get them, a kernel_batch is never fused,
+ * and a FIFO whose ends are both on the calling thread has to
+ * throw rather than wait on itself.
+ */
+static const std::int64_t total( 100000 );
+
+static raft::signal signal_for( const std::int64_t i )
+{
+   return( i % 100 == 0 ? static_cast< raft::signal >( raft::eof + 1 ) : raft::none );
+}
+
+class stage : public raft::kernel
+{
+public:
+   std::thread::id id;
+   bool            moved = false;
+
+protected:
+   void seen()
+   {
+      const auto me( std::this_thread::get_id() );
+      if( id != std::thread::id() && id != me )
+      {
+         moved = true;
+      }
+      id = me;
+   }
+};
+
+class source : public stage
+{
+public:
+   source() : stage()
+   {
+      output.addPort< std::int64_t >( "0" );
+   }
+
+   virtual raft::kstatus run()
+   {
+      seen();
+      output[ "0" ].push( next, signal_for( next ) );
+      next++;
+      return( next == total ? raft::stop : raft::proceed );
+   }
+
+private:
+   std::int64_t next = 0;
+};
+
+class keep_even : public stage
+{
+public:
+   keep_even() : stage()
+   {
+      input.addPort< std::int64_t >( "0" );
+      output.addPort< std::int64_t >( "0" );
+   }
+
+   virtual raft::kstatus run()
+   {
+      seen();
+      std::int64_t v;
+      raft::signal sig;
+      input[ "0" ].pop( v, &sig );
+      if( v % 2 == 0 )
+      {
+         output[ "0" ].push( v, sig );
+      }
+      return( raft::proceed );
+   }
+};
+
+class scale : public stage
+{
+public:
+   scale() : stage()
+   {
+      input.addPort< std::int64_t >( "0" );
+      output.addPort< std::int64_t >( "0" );
+   }
+
+   virtual raft::kstatus run()
+   {
+      seen();
+      std::int64_t v;
+      raft::signal sig;
+      input[ "0" ].pop( v, &sig );
+      output[ "0" ].push( v * 3, sig );
+      return( raft::proceed );
+   }
+};
+
+class sink : public stage
+{
+public:
+   sink() : stage()
+   {
+      input.addPort< std::int64_t >( "0" );
+   }
+
+   virtual raft::kstatus run()
+   {
+      seen();
+      std::int64_t v;
+      raft::signal sig;
+      input[ "0" ].pop( v, &sig );
+      if( v != expected * 3 || sig != signal_for( expected ) )
+      {
+         failed = true;
+      }
+      expected += 2;
+      return( raft::proceed );
+   }
+
+   std::int64_t expected = 0;
+   bool         failed   = false;
+};
+
+/** sums blocks of 8, one pop then a pop_range for the rest **/
+class block_sum : public stage
+{
+public:
+   block_sum() : stage()
+   {
+      input.addPort< std::int64_t >( "0" );
+      output.addPort< std::int64_t >( "0" );
+   }
+
+   virtual raft::kstatus run()
+   {
+      seen();
+      std::int64_t first;
+      input[ "0" ].pop( first );
+      std::int64_t rest[ 7 ];
+      input[ "0" ].pop_range( rest, 7 );
+      for( const auto v : rest )
+      {
+         first += v;
+      }
+      output[ "0" ].push( first );
+      return( raft::proceed );
+   }
+};
+
+class sum_sink : public stage
+{
+public:
+   sum_sink() : stage()
+   {
+      input.addPort< std::int64_t >( "0" );
+   }
+
+   virtual raft::kstatus run()
+   {
+      seen();
+      std::int64_t v;
+      input[ "0" ].pop( v );
+      if( v != 64 * blocks + 28 )
+      {
+         failed = true;
+      }
+      blocks++;
+      return( raft::proceed );
+   }
+
+   std::int64_t blocks = 0;
+   bool         failed = false;
+};
+
+class batch_pass : public raft::kernel_batch
+{
+public:
+   batch_pass() : raft::kernel_batch()
+   {
+      input.addPort< std::int64_t >( "0" );
+      output.addPort< std::int64_t >( "0" );
+   }
+
+   virtual raft::kstatus run_batch( const raft::ready &avail )
+   {
+      id = std::this_thread::get_id();
+      for( std::size_t i( 0 ); i < avail[ "0" ]; i++ )
+      {
+         std::int64_t v;
+         raft::signal sig;
+         input[ "0" ].pop( v, &sig );
+         output[ "0" ].push( v, sig );
+      }
+      return( raft::proceed );
+   }
+
+   std::thread::id id;
+};
+
+static bool run( const bool fuse )
+{
+   source    a;
+   keep_even b;
+   scale     c;
+   sink      d;
+   raft::map m;
+   m.set_fusion( fuse );
+   m += a >> b >> c >> d;
+   m.exe();
+   if( d.failed || d.expected != total )
+   {
+      std::cerr << ( fuse ? "fused" : "unfused" ) <<
+         ": items lost, out of order or with the wrong signal\n";
+      return( false );
+   }
+   const bool one_thread( a.id == b.id && b.id == c.id && c.id == d.id &&
+                          ! a.moved && ! b.moved && ! c.moved && ! d.moved );
+   if( fuse && ! one_thread )
+   {
+      std::cerr << "fused chain ran on more than one thread\n";
+      return( false );
+   }
+   if( ! fuse && one_thread )
+   {
+      std::cerr << "unfused chain ran on one thread\n";
+      return( false );
+   }
+   return( true );
+}
+
+static bool several_per_run()
+{
+   static_assert( total % 8 == 0, "blocks of 8" );
+   source    a;
+   block_sum b;
+   sum_sink  c;
+   raft::map m;
+   m.set_fusion( true );
+   m += a >> b >> c;
+   /** throws FusedChainBlockedException if b runs on too few items **/
+   m.exe();
+   if( c.failed || c.blocks != total / 8 || a.id != b.id || b.id != c.id )
+   {
+      std::cerr << "fused blocks of 8 wrong or not on one thread\n";
+      return( false );
+   }
+   return( true );
+}
+
+static bool batch_unfused()
+{
+   source     a;
+   batch_pass b;
+   sink       d;
+   raft::map m;
+   m.set_fusion( true );
+   m += a >> b >> d;
+   m.exe();
+   if( b.id == a.id || b.id == d.id )
+   {
+      std::cerr << "kernel_batch was fused\n";
+      return( false );
+   }
+   return( true );
+}
+
+/** both ends on this thread, as on a fused chain's thread **/
+static bool self_wait_throws()
+{
+   std::unique_ptr< FIFO > fifo(
+      RingBuffer< std::int64_t, Type::Heap, false >::make_new_fifo( 4, 64, nullptr ) );
+   fifo->set_fused( true );
+   std::int64_t v( 0 );
+   fifo->push( v );
+   fifo->pop( v );
+   while( fifo->space_avail() > 0 )
+   {
+      fifo->push( v );
+   }
+   bool threw( false );
+   try
+   {
+      fifo->push( v );
+   }
+   catch( FusedChainBlockedException & )
+   {
+      threw = true;
+   }
+   while( fifo->size() > 0 )
+   {
+      fifo->pop( v );
+   }
+   try
+   {
+      fifo->pop( v );
+      threw = false;
+   }
+   catch( FusedChainBlockedException & )
+   {
+   }
+   if( ! threw )
+   {
+      std::cerr << "fused FIFO waited on its own thread\n";
+      return( false );
+   }
+   return( true );
+}
+
+int
+main()
+{
+   if( ! run( false ) || ! run( true ) || ! several_per_run() || 
+       ! batch_unfused() || ! self_wait_throws() )
+   {
+      return( EXIT_FAILURE );
+   }
+   return( EXIT_SUCCESS );
+}
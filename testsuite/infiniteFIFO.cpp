@@ -0,0 +1,184 @@
+#include <cassert>
+#include <iostream>
+#include <cstdint>
+#include <cstdlib>
+#include <string>
+#include <atomic>
+#include <algorithm>
+#include <type_traits>
+#include <raft>
+
+/**
+ * the consumer doesn't read a thing till the producer is
+ * done, a bounded queue would deadlock here, Type::Infinite
+ * has to hold the whole stream.
+ */
+static std::atomic< bool > producer_done( false );
+
+template < class T > T make_item( const std::int64_t i );
+
+template <> std::int64_t make_item( const std::int64_t i )
+{
+   return( i );
+}
+
+template <> std::string make_item( const std::int64_t i )
+{
+   /** long enough to not fit in the small string buffer **/
+   return( std::string( "item number " ) + std::to_string( i ) +
+           " of the unbounded queue test" );
+}
+
+template < class T > class producer : public raft::kernel
+{
+public:
+   producer( const std::int64_t count ) : raft::kernel(), count( count )
+   {
+      output.template addPort< T >( "0" );
+   }
+
+   virtual raft::kstatus run()
+   {
+      auto &port( output[ "0" ] );
+      /** mix of single pushes and ranges **/
+      if( next % 3 == 0 && count - next > 5 )
+      {
+         write_five( port );
+      }
+      else
+      {
+         port.push( make_item< T >( next++ ) );
+      }
+      if( next == count )
+      {
+         producer_done = true;
+         return( raft::stop );
+      }
+      return( raft::proceed );
+   }
+
+private:
+   /** allocate_range hands out raw slots, only good for plain types **/
+   template < class U = T,
+              typename std::enable_if< ! std::is_class< U >::value >::type* = nullptr >
+   void write_five( FIFO &port )
+   {
+      auto range( port.template allocate_range< T >( 5 ) );
+      for( auto &item : range )
+      {
+         item.get() = make_item< T >( next++ );
+      }
+      port.send_range();
+   }
+
+   template < class U = T,
+              typename std::enable_if< std::is_class< U >::value >::type* = nullptr >
+   void write_five( FIFO &port )
+   {
+      for( int i( 0 ); i < 5; i++ )
+      {
+         port.template allocate< T >( make_item< T >( next++ ) );
+         port.send();
+      }
+   }
+
+   const std::int64_t count;
+   std::int64_t       next = 0;
+};
+
+template < class T > class consumer : public raft::kernel
+{
+public:
+   consumer() : raft::kernel()
+   {
+      input.template addPort< T >( "0" );
+   }
+
+   virtual raft::kstatus run()
+   {
+      if( ! producer_done )
+      {
+         return( raft::proceed );
+      }
+      auto &port( input[ "0" ] );
+      high_water = std::max( high_water, port.high_water_mark() );
+      const auto avail( std::min< std::size_t >( port.size(), 100 ) );
+      if( avail == 0 )
+      {
+         return( raft::proceed );
+      }
+      if( round++ % 2 == 0 )
+      {
+         /** bigger than a segment, has to span several **/
+         auto range( port.template peek_range< T >( avail ) );
+         for( std::size_t i( 0 ); i < avail; i++ )
+         {
+            check( range[ i ].ele );
+         }
+         port.unpeek();
+         port.recycle( avail );
+      }
+      else
+      {
+         for( std::size_t i( 0 ); i < avail; i++ )
+         {
+            T item;
+            port.pop( item );
+            check( item );
+         }
+      }
+      return( raft::proceed );
+   }
+
+   void check( const T &item )
+   {
+      if( item != make_item< T >( expected++ ) )
+      {
+         failed = true;
+      }
+   }
+
+   std::int64_t expected   = 0;
+   std::size_t  high_water = 0;
+   bool         failed     = false;
+private:
+   std::size_t  round      = 0;
+};
+
+template < class T > bool run_test( const std::int64_t count,
+                                    const std::size_t segment )
+{
+   producer_done = false;
+   producer< T > p( count );
+   consumer< T > c;
+   raft::map m;
+   m.link< raft::order::in, Type::Infinite >( &p, &c, segment );
+   m.exe();
+   if( c.failed || c.expected != count )
+   {
+      std::cerr << "items out of order, got " << c.expected <<
+         " of " << count << "\n";
+      return( false );
+   }
+   /** sampled once per segment **/
+   if( c.high_water + segment < static_cast< std::size_t >( count ) )
+   {
+      std::cerr << "high water mark too low, " << c.high_water << "\n";
+      return( false );
+   }
+   return( true );
+}
+
+int
+main()
+{
+   if( ! run_test< std::int64_t >( 100000, 64 ) )
+   {
+      return( EXIT_FAILURE );
+   }
+   if( ! run_test< std::string >( 20000, 32 ) )
+   {
+      return( EXIT_FAILURE );
+   }
+   return( EXIT_SUCCESS );
+}
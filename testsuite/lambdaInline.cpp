@@ -0,0 +1,141 @@
+#include <atomic>
+#include <cassert>
+#include <iostream>
+#include <cstdint>
+#include <cstdlib>
+#include <memory>
+#include <raft>
+
+/**
+ * lambda kernels built with make_lambdak. A source with two
+ * outputs that uses port handles feeds a scaling kernel and a
+ * clone of it, which both feed a sink. Each clone has to get its
+ * own ports and its own copy of the lambda's state. A lambdak
+ * (std::function) has to clone into a working kernel too, and one
+ * whose lambda can't be copied has to throw rather than clone.
+ */
+static const std::int64_t total( 100000 );
+
+int
+main()
+{
+   using type_t = std::int64_t;
+   auto src( raft::make_lambdak< type_t >( 0, 2,
+      [ next = type_t( 0 ) ]( raft::port_handles< type_t > &input,
+                              raft::port_handles< type_t > &output ) mutable
+      {
+         UNUSED( input );
+         assert( input.size() == 0 && output.size() == 2 );
+         output[ 0 ].push( next );
+         output[ 1 ].push( next );
+         next++;
+         return( next == total ? raft::stop : raft::proceed );
+      } ) );
+
+   std::atomic< type_t > calls( 0 );
+   auto scale( raft::make_lambdak< type_t >( 1, 1,
+      [ &calls, seen = type_t( 0 ) ]( Port &input, Port &output ) mutable
+      {
+         type_t v;
+         input[ "0" ].pop( v );
+         /** each copy counts its own items **/
+         if( v != seen++ )
+         {
+            return( raft::stop );
+         }
+         output[ "0" ].push( v * 3 );
+         calls++;
+         return( raft::proceed );
+      } ) );
+   auto *dup( scale.clone() );
+
+   type_t sums[ 2 ] = { 0, 0 };
+   auto sink( raft::make_lambdak< type_t >( 2, 0,
+      [ &sums ]( raft::port_handles< type_t > &input,
+                 raft::port_handles< type_t > &output )
+      {
+         UNUSED( output );
+         assert( output.size() == 0 );
+         for( std::size_t i( 0 ); i < input.size(); i++ )
+         {
+            if( input[ i ].size() > 0 )
+            {
+               type_t v;
+               input[ i ].pop( v );
+               sums[ i ] += v;
+            }
+         }
+         return( raft::proceed );
+      } ) );
+
+   raft::map m;
+   m.link( &src, "0", &scale, "0" );
+   m.link( &src, "1", dup, "0" );
+   m.link( &scale, "0", &sink, "0" );
+   m.link( dup, "0", &sink, "1" );
+   m.exe();
+
+   const type_t expected( 3 * total * ( total - 1 ) / 2 );
+   if( sums[ 0 ] != expected || sums[ 1 ] != expected || calls != 2 * total )
+   {
+      std::cerr << "clone lost items, got " << sums[ 0 ] << " and " <<
+         sums[ 1 ] << " of " << expected << "\n";
+      return( EXIT_FAILURE );
+   }
+
+   /** same again through a clone of a lambdak **/
+   raft::lambdak< type_t > fn( 1, 1,
+      []( Port &input, Port &output )
+      {
+         type_t v;
+         input[ "0" ].pop( v );
+         output[ "0" ].push( v * 3 );
+         return( raft::proceed );
+      } );
+   auto *fn_dup( fn.clone() );
+   auto src2( raft::make_lambdak< type_t >( 0, 1,
+      [ next = type_t( 0 ) ]( Port &input, Port &output ) mutable
+      {
+         UNUSED( input );
+         output[ "0" ].push( next++ );
+         return( next == total ? raft::stop : raft::proceed );
+      } ) );
+   type_t sum( 0 );
+   auto sink2( raft::make_lambdak< type_t >( 1, 0,
+      [ &sum ]( raft::port_handles< type_t > &input,
+                raft::port_handles< type_t > &output )
+      {
+         UNUSED( output );
+         sum += input[ 0 ].peek();
+         input[ 0 ].unpeek();
+         input[ 0 ].recycle();
+         return( raft::proceed );
+      } ) );
+   raft::map m2;
+   m2 += src2 >> *fn_dup >> sink2;
+   m2.exe();
+   if( sum != expected )
+   {
+      std::cerr << "lambdak clone lost items, got " << sum << " of " <<
+         expected << "\n";
+      return( EXIT_FAILURE );
+   }
+
+   auto move_only( raft::make_lambdak< type_t >( 1, 0,
+      [ p = std::unique_ptr< type_t >( new type_t( 0 ) ) ]( Port &input, Port &output )
+      {
+         UNUSED( input );
+         UNUSED( output );
+         return( raft::stop );
+      } ) );
+   try
+   {
+      delete move_only.clone();
+      std::cerr << "kernel with a move only lambda was cloned\n";
+      return( EXIT_FAILURE );
+   }
+   catch( CloneNotImplementedException & )
+   {
+   }
+   return( EXIT_SUCCESS );
+}
@@ -0,0 +1,129 @@
+#include <cassert>
+#include <iostream>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <algorithm>
+#include <raft>
+#include "mirrormem.hpp"
+
+using type_t = std::int64_t;
+
+/** odd sized batches so both sides regularly run past the end **/
+class producer : public raft::kernel
+{
+public:
+   producer( const type_t count ) : raft::kernel(), count( count )
+   {
+      output.addPort< type_t >( "0" );
+   }
+
+   virtual raft::kstatus run()
+   {
+      const auto n( std::min< type_t >( 7, count - next ) );
+      auto range( output[ "0" ].allocate_span< type_t >( n ) );
+      if( ! range.contiguous() )
+      {
+         split = true;
+      }
+      for( auto &item : range.first )
+      {
+         item = next++;
+      }
+      for( auto &item : range.second )
+      {
+         item = next++;
+      }
+      output[ "0" ].send_range();
+      return( next == count ? raft::stop : raft::proceed );
+   }
+
+   bool split = false;
+private:
+   const type_t count;
+   type_t       next = 0;
+};
+
+class consumer : public raft::kernel
+{
+public:
+   consumer() : raft::kernel()
+   {
+      input.addPort< type_t >( "0" );
+   }
+
+   virtual raft::kstatus run()
+   {
+      auto &port( input[ "0" ] );
+      const auto avail( std::min< std::size_t >( port.size(), 5 ) );
+      if( avail == 0 )
+      {
+         return( raft::proceed );
+      }
+      const auto range( port.peek_span< type_t >( avail ) );
+      if( ! range.contiguous() )
+      {
+         split = true;
+      }
+      for( std::size_t i( 0 ); i < avail; i++ )
+      {
+         if( range[ i ] != expected++ )
+         {
+            failed = true;
+         }
+      }
+      port.unpeek();
+      port.recycle( avail );
+      return( raft::proceed );
+   }
+
+   type_t expected = 0;
+   bool   failed   = false;
+   bool   split    = false;
+};
+
+int
+main()
+{
+   const bool mirror_available( raft::mirror::granularity() != 0 );
+   if( mirror_available )
+   {
+      /** both halves have to be the same memory **/
+      const auto length( raft::mirror::granularity() );
+      auto * const ptr( 
+         reinterpret_cast< std::uint8_t* >( raft::mirror::alloc( length ) ) );
+      if( ptr == nullptr )
+      {
+         std::cerr << "failed to allocate mirrored memory\n";
+         return( EXIT_FAILURE );
+      }
+      ptr[ 0 ] = 0x1;
+      ptr[ length + 1 ] = 0x2;
+      if( ptr[ length ] != 0x1 || ptr[ 1 ] != 0x2 )
+      {
+         std::cerr << "mirrored halves don't alias\n";
+         return( EXIT_FAILURE );
+      }
+      raft::mirror::free( ptr, length );
+   }
+
+   const type_t count( 100000 );
+   producer p( count );
+   consumer c;
+   raft::map m;
+   m.link< raft::order::in, Type::Mirrored >( &p, &c, 8 );
+   m.exe();
+   if( c.failed || c.expected != count )
+   {
+      std::cerr << "items out of order, got " << c.expected <<
+         " of " << count << "\n";
+      return( EXIT_FAILURE );
+   }
+   /** a mirrored store never needs a second span **/
+   if( mirror_available && ( p.split || c.split ) )
+   {
+      std::cerr << "mirrored range was split\n";
+      return( EXIT_FAILURE );
+   }
+   return( EXIT_SUCCESS );
+}
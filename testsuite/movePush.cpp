@@ -0,0 +1,136 @@
+#include <cassert>
+#include <iostream>
+#include <cstdint>
+#include <cstdlib>
+#include <string>
+#include <raft>
+#include "edgecheck.tcc"
+
+/**
+ * records that own heap memory, counts how often they're
+ * copied. Pushing rvalues or emplacing must never copy one.
+ */
+template < std::size_t PAD > struct record
+{
+   record() = default;
+
+   record( const std::int64_t seq ) : seq( seq ),
+                                      text( 64, 'a' + seq % 26 )
+   {
+   }
+
+   record( const record &other ) : seq( other.seq ),
+                                   text( other.text )
+   {
+      copies++;
+   }
+
+   record( record &&other ) = default;
+
+   record& operator = ( const record &other )
+   {
+      seq  = other.seq;
+      text = other.text;
+      copies++;
+      return( *this );
+   }
+
+   record& operator = ( record &&other ) = default;
+
+   std::int64_t seq = 0;
+   std::string  text;
+   char         pad[ PAD ];
+
+   static std::size_t copies;
+};
+
+template < std::size_t PAD > std::size_t record< PAD >::copies = 0;
+
+/** fits in a cache line, stored in line **/
+using small_t = record< 1 >;
+/** doesn't, stored through the slab pool **/
+using big_t   = record< 128 >;
+
+template < class T > class producer : public raft::kernel
+{
+public:
+   producer( const std::int64_t count ) : raft::kernel(), count( count )
+   {
+      output.addPort< T >( "0" );
+   }
+
+   virtual raft::kstatus run()
+   {
+      /** alternate between the two ways of handing items over **/
+      if( next % 2 == 0 )
+      {
+         T item( next );
+         output[ "0" ].push( std::move( item ) );
+      }
+      else
+      {
+         output[ "0" ].template emplace< T >( next );
+      }
+      next++;
+      return( next == count ? raft::stop : raft::proceed );
+   }
+
+private:
+   const std::int64_t count;
+   std::int64_t       next = 0;
+};
+
+template < class T > class consumer : public raft::kernel
+{
+public:
+   consumer() : raft::kernel()
+   {
+      input.addPort< T >( "0" );
+   }
+
+   virtual raft::kstatus run()
+   {
+      T item;
+      input[ "0" ].pop( item );
+      seq.check( item.seq == seq.expected &&
+                 item.text == std::string( 64, 'a' + seq.expected % 26 ) );
+      return( raft::proceed );
+   }
+
+   raft::test::sequence seq;
+};
+
+template < class T, Type::RingBufferType type > bool run( const char *name )
+{
+   const std::int64_t count( 10000 );
+   T::copies = 0;
+   producer< T > p( count );
+   consumer< T > c;
+   raft::map m;
+   /** fixed size, a resize would copy everything in the queue **/
+   m.link< raft::order::in, type >( &p, &c, 64 );
+   m.exe();
+   if( ! c.seq.complete( name, count ) )
+   {
+      return( false );
+   }
+   if( T::copies != 0 )
+   {
+      std::cerr << name << ": " << T::copies << " copies made\n";
+      return( false );
+   }
+   return( true );
+}
+
+int
+main()
+{
+   if( ! run< small_t, Type::Heap >( "heap inline" ) ||
+       ! run< big_t,   Type::Heap >( "heap external" ) ||
+       ! run< small_t, Type::Infinite >( "infinite inline" ) ||
+       ! run< big_t,   Type::Infinite >( "infinite external" ) )
+   {
+      return( EXIT_FAILURE );
+   }
+   return( EXIT_SUCCESS );
+}
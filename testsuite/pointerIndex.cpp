@@ -0,0 +1,67 @@
+#include <cassert>
+#include <iostream>
+#include <cstdint>
+#include <cstdlib>
+#include "defs.hpp"
+#include "pointer.hpp"
+
+/**
+ * check - walk read and write pointers for a buffer of
+ * size cap far enough to wrap several times and make
+ * sure the index and positions agree with a plain 
+ * counter.
+ */
+static bool check( const std::size_t cap )
+{
+   Pointer write( cap ), read( cap );
+   std::uint64_t count( 0 );
+   for( std::size_t i( 0 ); i < cap * 5 + 3; i++ )
+   {
+      if( Pointer::val( write ) != count % cap )
+      {
+         return( false );
+      }
+      Pointer::inc( write );
+      count++;
+      if( i % 3 == 0 )
+      {
+         Pointer::incBy( write, 2 );
+         count += 2;
+      }
+      /** keep the reader cap - 1 behind **/
+      while( Pointer::position( write ) - Pointer::position( read ) >= cap )
+      {
+         Pointer::inc( read );
+      }
+      if( Pointer::val( read ) != Pointer::position( read ) % cap )
+      {
+         return( false );
+      }
+   }
+   /** full buffer, write pointer starts a lap ahead **/
+   Pointer full_write( cap, 1 ), full_read( cap );
+   if( Pointer::position( full_write ) - Pointer::position( full_read ) != cap ||
+       Pointer::val( full_write ) != Pointer::val( full_read ) )
+   {
+      return( false );
+   }
+   return( true );
+}
+
+int
+main()
+{
+   static_assert( Pointer::is_pow2( 64 ), "64 is a power of two" );
+   static_assert( ! Pointer::is_pow2( 10 ), "10 isn't a power of two" );
+   static_assert( ! Pointer::is_pow2( 0 ), "0 isn't a power of two" );
+   /** power of two takes the masked path, others the modulo **/
+   for( const std::size_t cap : { 1, 2, 8, 64, 3, 10, 100 } )
+   {
+      if( ! check( cap ) )
+      {
+         std::cerr << "failed for capacity " << cap << "\n";
+         return( EXIT_FAILURE );
+      }
+   }
+   return( EXIT_SUCCESS );
+}
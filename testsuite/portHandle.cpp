@@ -0,0 +1,133 @@
+#include <cassert>
+#include <chrono>
+#include <iostream>
+#include <cstdint>
+#include <cstdlib>
+#include <thread>
+#include <raft>
+
+/**
+ * typed port handles, made once in the constructors and used in
+ * run() in place of input[ "0" ] / output[ "0" ]. The consumer
+ * is held back at the start and then sped up so dynalloc
+ * resizes the ring under the handles.
+ */
+static const std::int64_t total( 200000 );
+
+class producer : public raft::kernel
+{
+public:
+   producer() : raft::kernel()
+   {
+      output.addPort< std::int64_t >( "0" );
+      out = output.handle< std::int64_t >( "0" );
+   }
+
+   virtual raft::kstatus run()
+   {
+      out.push( next++ );
+      return( next == total ? raft::stop : raft::proceed );
+   }
+
+private:
+   raft::port_handle< std::int64_t > out;
+   std::int64_t next = 0;
+};
+
+class consumer : public raft::kernel
+{
+public:
+   consumer() : raft::kernel()
+   {
+      input.addPort< std::int64_t >( "0" );
+      in = input.handle< std::int64_t >( "0" );
+      /** wrong type or name has to throw when the handle is made **/
+      try
+      {
+         input.handle< float >( "0" );
+      }
+      catch( PortTypeMismatchException & )
+      {
+         threw_type = true;
+      }
+      try
+      {
+         input.handle< std::int64_t >( "1" );
+      }
+      catch( PortNotFoundException & )
+      {
+         threw_name = true;
+      }
+   }
+
+   virtual raft::kstatus run()
+   {
+      if( expected == 0 )
+      {
+         first_cap = in->capacity();
+      }
+      if( expected < 50 )
+      {
+         std::this_thread::sleep_for( std::chrono::milliseconds( 4 ) );
+      }
+      std::int64_t v( -1 );
+      if( expected % 2 == 0 )
+      {
+         in.pop( v );
+      }
+      else
+      {
+         v = in.peek();
+         in.unpeek();
+         in.recycle();
+      }
+      if( v != expected )
+      {
+         failed = true;
+      }
+      expected++;
+      last_cap = in->capacity();
+      return( raft::proceed );
+   }
+
+   raft::port_handle< std::int64_t > in;
+   std::int64_t expected   = 0;
+   std::size_t  first_cap  = 0;
+   std::size_t  last_cap   = 0;
+   bool         failed     = false;
+   bool         threw_type = false;
+   bool         threw_name = false;
+};
+
+int
+main()
+{
+   producer p;
+   consumer c;
+
+   raft::map m;
+   /** keep dynalloc from shrinking it back before the end **/
+   raft::shrink_policy policy;
+   policy.holdoff = 1000000;
+   m.set_shrink( policy );
+   m.link( &p, &c );
+   m.exe();
+   if( ! c.threw_type || ! c.threw_name )
+   {
+      std::cerr << "handle with the wrong type or name didn't throw\n";
+      return( EXIT_FAILURE );
+   }
+   if( c.failed || c.expected != total )
+   {
+      std::cerr << "items lost or out of order, got " << c.expected <<
+         " of " << total << "\n";
+      return( EXIT_FAILURE );
+   }
+   if( c.last_cap <= c.first_cap )
+   {
+      std::cerr << "ring wasn't resized under the handles, capacity " <<
+         c.first_cap << " -> " << c.last_cap << "\n";
+      return( EXIT_FAILURE );
+   }
+   return( EXIT_SUCCESS );
+}
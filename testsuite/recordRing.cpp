@@ -0,0 +1,155 @@
+#include <cassert>
+#include <iostream>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <raft>
+#include "edgecheck.tcc"
+
+/**
+ * variable length records on a raft::bytes port, every record
+ * has to come out whole, in order and with its signal whichever
+ * way it was written or read. Lengths run from empty to a few
+ * hundred bytes so records keep landing on the end of the store.
+ * The ring counts records rather than bytes, each one costs
+ * its bytes plus a header, and typed calls are refused.
+ */
+static const std::int64_t total( 100000 );
+
+static std::string record_for( const std::int64_t i )
+{
+   const auto length( static_cast< std::size_t >( ( i * 37 ) % 301 ) );
+   return( std::string( length, static_cast< char >( 'a' + i % 26 ) ) );
+}
+
+static raft::signal signal_for( const std::int64_t i )
+{
+   return( i % 11 == 0 ? static_cast< raft::signal >( raft::eof + 1 + i % 5 ) :
+                         raft::none );
+}
+
+class producer : public raft::kernel
+{
+public:
+   producer() : raft::kernel()
+   {
+      output.addPort< raft::bytes >( "0" );
+   }
+
+   virtual raft::kstatus run()
+   {
+      const auto rec( record_for( next ) );
+      if( next % 2 == 0 )
+      {
+         output[ "0" ].push_bytes( rec, signal_for( next ) );
+      }
+      else
+      {
+         /** ask for more than needed, send what was written **/
+         auto span( output[ "0" ].allocate_bytes( rec.size() + 16 ) );
+         std::memcpy( span.data(), rec.data(), rec.size() );
+         output[ "0" ].send_bytes( rec.size(), signal_for( next ) );
+      }
+      next++;
+      return( next == total ? raft::stop : raft::proceed );
+   }
+
+private:
+   std::int64_t next = 0;
+};
+
+class consumer : public raft::kernel
+{
+public:
+   consumer() : raft::kernel()
+   {
+      input.addPort< raft::bytes >( "0" );
+   }
+
+   virtual raft::kstatus run()
+   {
+      auto &port( input[ "0" ] );
+      raft::signal sig;
+      if( seq.expected % 3 == 0 )
+      {
+         std::string rec;
+         port.pop_record( rec, &sig );
+         check( rec.data(), rec.size(), sig );
+      }
+      else
+      {
+         const auto rec( port.peek_record( &sig ) );
+         check( rec.data(), rec.size(), sig );
+         port.unpeek();
+         port.recycle();
+      }
+      return( raft::proceed );
+   }
+
+   void check( const char *data, const std::size_t length, const raft::signal sig )
+   {
+      const auto want( record_for( seq.expected ) );
+      seq.check( length == want.size() &&
+                 std::memcmp( data, want.data(), length ) == 0 &&
+                 sig == signal_for( seq.expected ) );
+   }
+
+   raft::test::sequence seq;
+};
+
+template < raft::wait::strategy W > bool run( const char *name )
+{
+   producer p;
+   consumer c;
+   raft::map m;
+   m.link< raft::order::in, Type::Heap, W >( &p, &c );
+   m.exe();
+   return( c.seq.complete( name, total ) );
+}
+
+static bool framing()
+{
+   RecordRing ring( RECORD_RING_MIN_BYTES );
+   const auto cap( ring.capacity() );
+   ring.push_bytes( std::string( 100, 'x' ), raft::none );
+   ring.push_bytes( std::string(), raft::eof );
+   ring.push_bytes( std::string( 7, 'y' ), raft::none );
+   const auto records( ring.size() );
+   const auto used( cap - ring.space_avail() );
+   bool typed_refused( false );
+   try
+   {
+      ring.push( std::int64_t( 1 ) );
+   }
+   catch( PortTypeMismatchException & )
+   {
+      typed_refused = true;
+   }
+   std::string rec;
+   raft::signal sig( raft::none );
+   ring.pop_record( rec );
+   ring.pop_record( rec, &sig );
+   const bool empty_kept( rec.empty() && sig == raft::eof );
+   if( records != 3 || used < 107 + 3 * sizeof( std::uint32_t ) || 
+       ! typed_refused || ! empty_kept )
+   {
+      std::cerr << "framing: " << records << " records in " << used << 
+         " bytes, typed push " << ( typed_refused ? "" : "not " ) << 
+         "refused, empty record " << ( empty_kept ? "" : "not " ) << "kept\n";
+      return( false );
+   }
+   return( true );
+}
+
+int
+main()
+{
+   if( ! run< raft::wait::spin_yield >( "spin_yield" ) ||
+       ! run< raft::wait::park >( "park" ) ||
+       ! framing() )
+   {
+      return( EXIT_FAILURE );
+   }
+   return( EXIT_SUCCESS );
+}
@@ -0,0 +1,85 @@
+#include <atomic>
+#include <cassert>
+#include <chrono>
+#include <iostream>
+#include <cstdint>
+#include <cstdlib>
+#include <thread>
+#include <raft>
+
+/**
+ * resize a ring over and over, growing and shrinking it, while
+ * both ends use raft::wait::park. The endpoints stall every so
+ * often so the other end runs dry (or fills the ring) and parks,
+ * which takes it offline for the resize protocol, so resizes
+ * keep racing threads coming back online. Items must come out
+ * whole and in order.
+ */
+template < Type::RingBufferType type > static bool 
+stress( const char * const name )
+{
+   using type_t = std::int64_t;
+   const type_t count( 50000 );
+   auto *fifo( RingBuffer< type_t, type, false >::make_new_fifo( 
+      4, 64, nullptr ) );
+   fifo->set_wait_strategy( raft::wait::park );
+   volatile bool exit_alloc( false );
+   std::atomic< bool > done( false );
+   std::thread producer( [&]()
+   {
+      for( type_t i( 0 ); i < count; i++ )
+      {
+         if( i % 2000 == 0 )
+         {
+            std::this_thread::sleep_for( std::chrono::microseconds( 200 ) );
+         }
+         fifo->push( i );
+      }
+   } );
+   bool ok( true );
+   std::thread consumer( [&]()
+   {
+      for( type_t i( 0 ); i < count; i++ )
+      {
+         if( i % 3000 == 0 )
+         {
+            std::this_thread::sleep_for( std::chrono::microseconds( 200 ) );
+         }
+         type_t val;
+         fifo->pop( val );
+         if( val != i )
+         {
+            ok = false;
+         }
+      }
+      done = true;
+   } );
+   std::size_t resizes( 0 );
+   while( ! done )
+   {
+      const std::size_t sizes[] = { 8, 64, 16, 256, 4 };
+      fifo->resize( sizes[ resizes++ % 5 ], 64, exit_alloc );
+      /** back to back resizes would starve the endpoints on one core **/
+      std::this_thread::sleep_for( std::chrono::microseconds( 50 ) );
+   }
+   producer.join();
+   consumer.join();
+   delete( fifo );
+   if( ! ok || resizes == 0 )
+   {
+      std::cerr << name << ": items lost or out of order across " << 
+         resizes << " resizes\n";
+      return( false );
+   }
+   return( true );
+}
+
+int
+main()
+{
+   if( ! stress< Type::Heap >( "heap" ) || ! stress< Type::SPSC >( "spsc" ) )
+   {
+      return( EXIT_FAILURE );
+   }
+   return( EXIT_SUCCESS );
+}
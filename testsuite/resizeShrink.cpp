@@ -0,0 +1,55 @@
+#include <cassert>
+#include <iostream>
+#include <cstdint>
+#include <cstdlib>
+#include <thread>
+#include <raft>
+
+/**
+ * shrink a partially filled ring buffer the way dynalloc
+ * does for an idle edge, items must survive in order. A
+ * shrink below the number of queued items must leave the
+ * buffer as it was.
+ */
+template < Type::RingBufferType type > static bool 
+shrink()
+{
+   using type_t = std::int64_t;
+   const std::int64_t count( 10 );
+   auto *fifo( RingBuffer< type_t, type, false >::make_new_fifo( 
+      64, 64, nullptr ) );
+   volatile bool exit_alloc( false );
+   /** producer thread exits before the resize so it never holds it up **/
+   std::thread producer( [&]()
+   {
+      for( std::int64_t i( 0 ); i < count; i++ )
+      {
+         fifo->push( i );
+      }
+   } );
+   producer.join();
+   bool ok( true );
+   fifo->resize( 16, 64, exit_alloc );
+   ok = ok && fifo->capacity() == 16 && fifo->size() == count;
+   fifo->resize( 4, 64, exit_alloc );
+   ok = ok && fifo->capacity() == 16 && fifo->size() == count;
+   for( std::int64_t i( 0 ); ok && i < count; i++ )
+   {
+      type_t val;
+      fifo->pop( val );
+      ok = ( val == i );
+   }
+   delete( fifo );
+   return( ok );
+}
+
+int
+main()
+{
+   if( ! shrink< Type::Heap >() || ! shrink< Type::SPSC >() )
+   {
+      std::cerr << "shrink lost items or resized a buffer too small to hold them\n";
+      return( EXIT_FAILURE );
+   }
+   return( EXIT_SUCCESS );
+}
@@ -0,0 +1,75 @@
+#include <cassert>
+#include <iostream>
+#include <cstdint>
+#include <cstdlib>
+#include <thread>
+#include <raft>
+
+/**
+ * stress - drive a single ring buffer directly with a
+ * producer and a consumer thread while a third thread keeps
+ * resizing it the same way dynalloc would. Any lost, duplicated
+ * or re-ordered item is a failure.
+ */
+template < Type::RingBufferType type > static bool 
+stress( const std::int64_t count )
+{
+   using type_t = std::int64_t;
+   auto *fifo( RingBuffer< type_t, type, false >::make_new_fifo( 
+      4, 64, nullptr ) );
+   volatile bool exit_alloc( false );
+   bool          failed( false );
+
+   std::thread producer( [&]()
+   {
+      for( std::int64_t i( 0 ); i < count; i++ )
+      {
+         fifo->push( i, i == count - 1 ? raft::eof : raft::none );
+      }
+   } );
+   std::thread consumer( [&]()
+   {
+      for( std::int64_t i( 0 ); i < count; i++ )
+      {
+         type_t val;
+         fifo->pop( val );
+         if( val != i )
+         {
+            failed = true;
+            break;
+         }
+      }
+      exit_alloc = true;
+   } );
+   std::thread resizer( [&]()
+   {
+      std::size_t cap( 4 );
+      while( ! exit_alloc && cap < ( 1 << 16 ) )
+      {
+         cap *= 2;
+         fifo->resize( cap, 64, exit_alloc );
+         std::this_thread::yield();
+      }
+   } );
+   producer.join();
+   consumer.join();
+   resizer.join();
+   delete( fifo );
+   return( ! failed );
+}
+
+int
+main( int argc, char **argv )
+{
+   std::int64_t count( 200000 );
+   if( argc == 2 )
+   {
+      count = atoi( argv[ 1 ] );
+   }
+   if( ! stress< Type::Heap >( count ) || ! stress< Type::SPSC >( count ) )
+   {
+      std::cerr << "items out of order after resize\n";
+      return( EXIT_FAILURE );
+   }
+   return( EXIT_SUCCESS );
+}
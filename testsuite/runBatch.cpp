@@ -0,0 +1,156 @@
+#include <cassert>
+#include <iostream>
+#include <cstdint>
+#include <cstdlib>
+#include <vector>
+#include <raft>
+
+/**
+ * kernel_batch filters, one single input that pops everything
+ * it's told is ready with pop_range and passes on the items
+ * under a threshold with insert, and one that adds two inputs
+ * with sched_behav set to raft::all_port. Items have to come
+ * out whole and in order, and the filter should have been run
+ * fewer times than it had items.
+ */
+static const std::int64_t total( 100000 );
+static const std::int64_t limit( 1000 );
+
+class source : public raft::kernel
+{
+public:
+   source() : raft::kernel()
+   {
+      output.addPort< std::int64_t >( "a", "b" );
+   }
+
+   virtual raft::kstatus run()
+   {
+      output[ "a" ].push( next );
+      output[ "b" ].push( next * 2 );
+      next++;
+      return( next == total ? raft::stop : raft::proceed );
+   }
+
+private:
+   std::int64_t next = 0;
+};
+
+class below : public raft::kernel_batch
+{
+public:
+   below() : raft::kernel_batch()
+   {
+      input.addPort< std::int64_t >( "0" );
+      output.addPort< std::int64_t >( "0" );
+   }
+
+   virtual raft::kstatus run_batch( const raft::ready &avail )
+   {
+      const auto n( avail[ "0" ] );
+      assert( n > 0 && n == avail.min() && n == avail.total() );
+      in.resize( n );
+      input[ "0" ].pop_range( in.data(), n );
+      out.clear();
+      for( const auto v : in )
+      {
+         if( v % limit < limit / 2 )
+         {
+            out.emplace_back( v );
+         }
+      }
+      output[ "0" ].insert( out.data(), out.size() );
+      calls++;
+      items += n;
+      return( raft::proceed );
+   }
+
+   std::int64_t calls = 0;
+   std::int64_t items = 0;
+
+private:
+   std::vector< std::int64_t > in;
+   std::vector< std::int64_t > out;
+};
+
+class add : public raft::kernel_batch
+{
+public:
+   add() : raft::kernel_batch()
+   {
+      input.addPort< std::int64_t >( "a", "b" );
+      output.addPort< std::int64_t >( "0" );
+      sched_behav = raft::all_port;
+   }
+
+   virtual raft::kstatus run_batch( const raft::ready &avail )
+   {
+      assert( avail.ports() == 2 && avail.min() > 0 );
+      for( std::size_t i( 0 ); i < avail.min(); i++ )
+      {
+         std::int64_t a, b;
+         input[ "a" ].pop( a );
+         input[ "b" ].pop( b );
+         output[ "0" ].push( a + b );
+      }
+      return( raft::proceed );
+   }
+};
+
+class sink : public raft::kernel
+{
+public:
+   sink() : raft::kernel()
+   {
+      input.addPort< std::int64_t >( "0" );
+   }
+
+   virtual raft::kstatus run()
+   {
+      std::int64_t v;
+      input[ "0" ].pop( v );
+      /** skip what the filter drops **/
+      while( next % limit >= limit / 2 )
+      {
+         next += 3;
+      }
+      if( v != next )
+      {
+         failed = true;
+      }
+      next += 3;
+      count++;
+      return( raft::proceed );
+   }
+
+   std::int64_t next   = 0;
+   std::int64_t count  = 0;
+   bool         failed = false;
+};
+
+int
+main()
+{
+   source s;
+   add    a;
+   below  f;
+   sink   d;
+   raft::map m;
+   m.link( &s, "a", &a, "a" );
+   m.link( &s, "b", &a, "b" );
+   m += a >> f >> d;
+   m.exe();
+   std::int64_t kept( 0 );
+   for( std::int64_t i( 0 ); i < total; i++ )
+   {
+      kept += ( ( 3 * i ) % limit < limit / 2 ? 1 : 0 );
+   }
+   if( d.failed || f.items != total || d.count != kept )
+   {
+      std::cerr << "items lost or out of order, " << d.count << " of " <<
+         kept << " through the filter\n";
+      return( EXIT_FAILURE );
+   }
+   std::cout << f.items << " items in " << f.calls << " run_batch calls\n";
+   return( EXIT_SUCCESS );
+}
@@ -0,0 +1,197 @@
+#include <cassert>
+#include <iostream>
+#include <cstdint>
+#include <cstdlib>
+#include <atomic>
+#include <thread>
+#include <vector>
+#include <raft>
+
+/** bigger than a cache line so it takes the ext_alloc path **/
+struct record
+{
+   record( const std::int64_t v = 0 ) : value( v )
+   {
+      live++;
+   }
+
+   record( const record &other ) : value( other.value )
+   {
+      live++;
+   }
+
+   record& operator = ( const record &other )
+   {
+      value = other.value;
+      return( *this );
+   }
+
+   ~record()
+   {
+      live--;
+   }
+
+   std::int64_t               value;
+   char                       pad[ L1D_CACHE_LINE_SIZE * 4 ];
+   static std::atomic< std::int64_t > live;
+};
+
+std::atomic< std::int64_t > record::live = { 0 };
+
+static_assert( ext_alloc< record >::value, "record must be externally allocated" );
+
+/**
+ * slots freed on one thread must come back to the thread that
+ * allocates, otherwise a producer/consumer pair keeps adding slabs.
+ * Once they're all back only SLAB_POOL_IDLE_SLABS idle slabs may
+ * be kept (plus what the allocating thread still has cached).
+ */
+static bool
+cross_thread_reuse()
+{
+   const std::size_t count( 2000 );
+   std::vector< record* > items;
+   auto burst( [&]()
+   {
+      for( std::size_t i( 0 ); i < count; i++ )
+      {
+         items.push_back( raft::slab_pool< record >::make( i ) );
+      }
+      std::thread consumer( [&]()
+      {
+         for( auto *item : items )
+         {
+            raft::slab_pool< record >::destroy( item );
+         }
+      } );
+      consumer.join();
+      items.clear();
+   } );
+   const auto before( raft::slab_pool< record >::slabs() );
+   for( std::size_t i( 0 ); i < count; i++ )
+   {
+      items.push_back( raft::slab_pool< record >::make( i ) );
+      if( reinterpret_cast< std::uintptr_t >( items.back() ) % 
+            L1D_CACHE_LINE_SIZE != 0 )
+      {
+         return( false );
+      }
+   }
+   const auto peak( raft::slab_pool< record >::slabs() );
+   for( auto *item : items )
+   {
+      raft::slab_pool< record >::destroy( item );
+   }
+   items.clear();
+   for( int round( 0 ); round < 4; round++ )
+   {
+      burst();
+      if( raft::slab_pool< record >::slabs() > peak )
+      {
+         std::cerr << "slab_pool: burst " << round << " added slabs\n";
+         return( false );
+      }
+   }
+   const auto idle( raft::slab_pool< record >::slabs() );
+   if( peak - before <= SLAB_POOL_IDLE_SLABS + 2 || 
+       idle > before + SLAB_POOL_IDLE_SLABS + 2 )
+   {
+      std::cerr << "slab_pool: " << idle << " slabs kept after a burst of " << 
+         ( peak - before ) << "\n";
+      return( false );
+   }
+   return( true );
+}
+
+class producer : public raft::kernel
+{
+public:
+   producer( const std::int64_t count ) : raft::kernel(), count( count )
+   {
+      output.addPort< record >( "0" );
+   }
+
+   virtual raft::kstatus run()
+   {
+      for( std::int64_t i( 0 ); i < count; i++ )
+      {
+         record r( i );
+         output[ "0" ].push( r, i == count - 1 ? raft::eof : raft::none );
+      }
+      return( raft::stop );
+   }
+private:
+   const std::int64_t count;
+};
+
+/** forwards the peeked item, no copy is made **/
+class forward : public raft::kernel
+{
+public:
+   forward() : raft::kernel()
+   {
+      input.addPort< record >( "0" );
+      output.addPort< record >( "0" );
+   }
+
+   virtual raft::kstatus run()
+   {
+      auto &r( input[ "0" ].peek< record >() );
+      output[ "0" ].push( r );
+      input[ "0" ].recycle();
+      return( raft::proceed );
+   }
+};
+
+class consumer : public raft::kernel
+{
+public:
+   consumer() : raft::kernel()
+   {
+      input.addPort< record >( "0" );
+   }
+
+   virtual raft::kstatus run()
+   {
+      record r;
+      input[ "0" ].pop( r );
+      if( r.value != expected++ )
+      {
+         failed = true;
+      }
+      return( raft::proceed );
+   }
+
+   std::int64_t expected = 0;
+   bool         failed   = false;
+};
+
+int
+main()
+{
+   if( ! cross_thread_reuse() )
+   {
+      std::cerr << "slab_pool didn't reuse or free slots released on another thread\n";
+      return( EXIT_FAILURE );
+   }
+   const std::int64_t count( 10000 );
+   producer p( count );
+   forward  f;
+   consumer c;
+   {
+      raft::map m;
+      m += p >> f >> c;
+      m.exe();
+   }
+   if( c.failed || c.expected != count )
+   {
+      std::cerr << "items out of order\n";
+      return( EXIT_FAILURE );
+   }
+   if( record::live != 0 )
+   {
+      std::cerr << record::live << " records never destroyed\n";
+      return( EXIT_FAILURE );
+   }
+   return( EXIT_SUCCESS );
+}
@@ -0,0 +1,120 @@
+#include <cassert>
+#include <iostream>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <algorithm>
+#include <raft>
+
+using type_t = std::int64_t;
+
+/**
+ * odd sized batches so that both sides regularly
+ * straddle the end of the store.
+ */
+class producer : public raft::kernel
+{
+public:
+   producer( const type_t count ) : raft::kernel(), count( count )
+   {
+      output.addPort< type_t >( "0" );
+   }
+
+   virtual raft::kstatus run()
+   {
+      const auto n( std::min< type_t >( 7, count - next ) );
+      auto range( output[ "0" ].allocate_span< type_t >( n ) );
+      if( range.size() != static_cast< std::size_t >( n ) )
+      {
+         std::cerr << "allocate_span returned wrong size\n";
+         exit( EXIT_FAILURE );
+      }
+      if( ! range.contiguous() )
+      {
+         wrapped = true;
+      }
+      for( auto &item : range.first )
+      {
+         item = next++;
+      }
+      for( auto &item : range.second )
+      {
+         item = next++;
+      }
+      output[ "0" ].send_range();
+      return( next == count ? raft::stop : raft::proceed );
+   }
+
+   bool wrapped = false;
+private:
+   const type_t count;
+   type_t       next = 0;
+};
+
+class consumer : public raft::kernel
+{
+public:
+   consumer() : raft::kernel()
+   {
+      input.addPort< type_t >( "0" );
+   }
+
+   virtual raft::kstatus run()
+   {
+      auto &port( input[ "0" ] );
+      const auto avail( std::min< std::size_t >( port.size(), 5 ) );
+      if( avail == 0 )
+      {
+         return( raft::proceed );
+      }
+      const auto range( port.peek_span< type_t >( avail ) );
+      if( ! range.contiguous() )
+      {
+         wrapped = true;
+      }
+      /** copy out the way a kernel would, straight from the store **/
+      type_t buffer[ 5 ];
+      std::memcpy( buffer, range.first.ptr,
+                   range.first.size() * sizeof( type_t ) );
+      std::memcpy( buffer + range.first.size(), range.second.ptr,
+                   range.second.size() * sizeof( type_t ) );
+      for( std::size_t i( 0 ); i < avail; i++ )
+      {
+         if( buffer[ i ] != expected || range[ i ] != expected )
+         {
+            failed = true;
+         }
+         expected++;
+      }
+      port.unpeek();
+      port.recycle( avail );
+      return( raft::proceed );
+   }
+
+   type_t expected = 0;
+   bool   failed   = false;
+   bool   wrapped  = false;
+};
+
+int
+main()
+{
+   const type_t count( 100000 );
+   producer p( count );
+   consumer c;
+   raft::map m;
+   m += p >> c;
+   m.exe();
+   if( c.failed || c.expected != count )
+   {
+      std::cerr << "items out of order, got " << c.expected <<
+         " of " << count << "\n";
+      return( EXIT_FAILURE );
+   }
+   if( ! p.wrapped || ! c.wrapped )
+   {
+      std::cerr << "ranges never wrapped, test didn't cover split spans\n";
+      return( EXIT_FAILURE );
+   }
+   return( EXIT_SUCCESS );
+}
@@ -0,0 +1,253 @@
+#include <cassert>
+#include <iostream>
+#include <cstdint>
+#include <cstdlib>
+#include <vector>
+#include <string>
+#include <raft>
+#include "edgecheck.tcc"
+
+/**
+ * signals ride in a side queue, every item has to come out
+ * with exactly the signal it went in with whichever way it's
+ * read. With a signal on every item the side queue fills up
+ * and the slots have to take over. On a ring of its own the
+ * signals have to be in the side queue, and only them, the
+ * slots aren't even allocated till it overflows.
+ */
+static const std::int64_t total( 50000 );
+
+static raft::signal signal_for( const std::int64_t i, const std::int64_t every )
+{
+   if( i % every != 0 )
+   {
+      return( raft::none );
+   }
+   return( static_cast< raft::signal >( raft::eof + 1 + i % 7 ) );
+}
+
+class producer : public raft::kernel
+{
+public:
+   producer( const std::int64_t every ) : raft::kernel(), every( every )
+   {
+      output.addPort< std::int64_t >( "0" );
+   }
+
+   virtual raft::kstatus run()
+   {
+      if( next % 3 == 0 )
+      {
+         auto &item( output[ "0" ].allocate< std::int64_t >() );
+         item = next;
+         output[ "0" ].send( signal_for( next, every ) );
+      }
+      else
+      {
+         output[ "0" ].push( next, signal_for( next, every ) );
+      }
+      next++;
+      return( next == total ? raft::stop : raft::proceed );
+   }
+
+private:
+   const std::int64_t every;
+   std::int64_t       next = 0;
+};
+
+class consumer : public raft::kernel
+{
+public:
+   consumer( const std::int64_t every ) : raft::kernel(), every( every )
+   {
+      input.addPort< std::int64_t >( "0" );
+   }
+
+   virtual raft::kstatus run()
+   {
+      auto &port( input[ "0" ] );
+      switch( round++ % 4 )
+      {
+         case( 0 ):
+         {
+            std::int64_t item;
+            raft::signal sig;
+            port.pop( item, &sig );
+            check( item, sig );
+         }
+         break;
+         case( 1 ):
+         {
+            raft::signal sig;
+            auto &item( port.peek< std::int64_t >( &sig ) );
+            check( item, sig );
+            port.unpeek();
+            port.recycle();
+         }
+         break;
+         case( 2 ):
+         {
+            if( port.size() < 4 )
+            {
+               std::int64_t item;
+               raft::signal sig;
+               port.pop( item, &sig );
+               check( item, sig );
+               break;
+            }
+            auto range( port.peek_range< std::int64_t >( 4 ) );
+            for( std::size_t i( 0 ); i < 4; i++ )
+            {
+               check( range[ i ].ele, range[ i ].sig );
+            }
+            port.unpeek();
+            port.recycle( 4 );
+         }
+         break;
+         default:
+         {
+            const std::size_t n( std::min< std::int64_t >( 9, total - seq.expected ) );
+            std::vector< std::int64_t > items( n );
+            std::vector< raft::signal > sigs( n );
+            port.pop_range( items.data(), n, sigs.data() );
+            for( std::size_t i( 0 ); i < n; i++ )
+            {
+               check( items[ i ], sigs[ i ] );
+            }
+         }
+      }
+      return( raft::proceed );
+   }
+
+   void check( const std::int64_t item, const raft::signal sig )
+   {
+      seq.check( item == seq.expected && 
+                 sig == signal_for( seq.expected, every ) );
+   }
+
+   raft::test::sequence seq;
+
+private:
+   const std::int64_t every;
+   std::size_t        round = 0;
+};
+
+static bool run( const std::int64_t every, const std::size_t buffer )
+{
+   producer p( every );
+   consumer c( every );
+   raft::map m;
+   m.link< raft::order::in, Type::Heap >( &p, &c, buffer );
+   m.exe();
+   const auto name( "signal every " + std::to_string( every ) );
+   return( c.seq.complete( name.c_str(), total ) );
+}
+
+/** signal_ring - lets the test ask the side queue **/
+class signal_ring : public RingBuffer< std::int64_t, Type::Heap, false >
+{
+public:
+   signal_ring( const std::size_t n = 64 ) : 
+      RingBuffer< std::int64_t, Type::Heap, false >( n, 64 )
+   {
+   }
+
+   /** queued - true if the side queue holds a signal not yet popped **/
+   bool queued()
+   {
+      return( (this)->has_signal() );
+   }
+
+   /** slotted - true once the buffer has had to allocate its slots **/
+   bool slotted()
+   {
+      return( (this)->datamanager.get()->signal != nullptr );
+   }
+};
+
+/**
+ * side_queue - plain items leave the side queue empty, a 
+ * signalled one is in it till it's popped, even with plain
+ * items in front of it.
+ */
+static bool side_queue()
+{
+   signal_ring ring;
+   const auto sig_at = []( const std::int64_t i )
+   {
+      return( i == 4 ? static_cast< raft::signal >( raft::eof + 1 ) : raft::none );
+   };
+   for( std::int64_t i( 0 ); i < 4; i++ )
+   {
+      ring.push( i, sig_at( i ) );
+   }
+   const bool plain( ring.queued() );
+   ring.push( std::int64_t( 4 ), sig_at( 4 ) );
+   const bool signalled( ring.queued() );
+   raft::test::sequence seq;
+   bool behind( true );
+   for( std::int64_t i( 0 ); i < 5; i++ )
+   {
+      behind = behind && ring.queued();
+      std::int64_t item;
+      raft::signal sig;
+      ring.pop( item, &sig );
+      seq.check( item == i && sig == sig_at( i ) );
+   }
+   const bool taken( ! ring.queued() );
+   if( plain || ! signalled || ! behind || ! taken || ring.slotted() )
+   {
+      std::cerr << "side queue: holds " << ( plain ? "plain items" : 
+         "the wrong signals" ) << " or has slots\n";
+      return( false );
+   }
+   return( seq.complete( "side queue", 5 ) );
+}
+
+/**
+ * overflow - more signals in flight than the side queue holds,
+ * the rest go to the slots, every item still comes out with 
+ * its own whether popped or peeked.
+ */
+static bool overflow()
+{
+   const std::int64_t n( SIGNAL_QUEUE_SIZE * 2 );
+   signal_ring ring( n );
+   for( std::int64_t i( 0 ); i < n; i++ )
+   {
+      ring.push( i, signal_for( i, 1 ) );
+   }
+   const bool slotted( ring.slotted() );
+   raft::test::sequence seq;
+   {
+      auto range( ring.peek_range< std::int64_t >( n ) );
+      for( std::int64_t i( 0 ); i < n; i++ )
+      {
+         seq.check( range[ i ].ele == i && range[ i ].sig == signal_for( i, 1 ) );
+      }
+   }
+   for( std::int64_t i( 0 ); i < n; i++ )
+   {
+      std::int64_t item;
+      raft::signal sig;
+      ring.pop( item, &sig );
+      seq.check( item == i && sig == signal_for( i, 1 ) );
+   }
+   if( ! slotted || ring.queued() )
+   {
+      std::cerr << "overflow: slots never used or signals left over\n";
+      return( false );
+   }
+   return( seq.complete( "overflow", n * 2 ) );
+}
+
+int
+main()
+{
+   /** sparse, then a signal on every item in a queue much bigger than the side queue **/
+   if( ! run( 10, 64 ) || ! run( 1, 1024 ) || ! side_queue() || ! overflow() )
+   {
+      return( EXIT_FAILURE );
+   }
+   return( EXIT_SUCCESS );
+}
@@ -0,0 +1,81 @@
+#include <cassert>
+#include <iostream>
+#include <cstdint>
+#include <cstdlib>
+#include <raft>
+#include <raftio>
+#include "generate.tcc"
+
+template < typename T > class passthrough : public raft::kernel
+{
+public:
+   passthrough() : raft::kernel()
+   {
+      input.addPort< T >( "in" );
+      output.addPort< T >( "out" );
+   }
+
+   virtual raft::kstatus run()
+   {
+      T val;
+      raft::signal sig( raft::none );
+      input[ "in" ].pop( val, &sig );
+      output[ "out" ].push( val, sig );
+      return( raft::proceed );
+   }
+};
+
+template < typename T > class check : public raft::kernel
+{
+public:
+   check( const std::int64_t count ) : raft::kernel(),
+                                       expected( count - 1 )
+   {
+      input.addPort< T >( "in" );
+   }
+
+   virtual raft::kstatus run()
+   {
+      T val;
+      input[ "in" ].pop( val );
+      /** generate counts down, any loss or re-order shows up here **/
+      if( val != expected )
+      {
+         std::cerr << "expected " << expected << ", got " << val << "\n";
+         exit( EXIT_FAILURE );
+      }
+      expected--;
+      return( raft::proceed );
+   }
+
+   std::int64_t expected;
+};
+
+int
+main( int argc, char **argv )
+{
+   std::int64_t count( 10000 );
+   if( argc == 2 )
+   {
+      count = atoi( argv[ 1 ] );
+   }
+   using type_t = std::int64_t;
+   using gen    = raft::test::generate< type_t >;
+   gen a( count );
+   passthrough< type_t > p;
+   check< type_t > c( count );
+
+   raft::map m;
+   /** small fixed size so the indices wrap many times **/
+   m.link< raft::order::in, Type::SPSC >( &a, &p, 8 );
+   /** this one can be resized by the allocator **/
+   m.link< raft::order::in, Type::SPSC >( &p, &c );
+   m.exe();
+   if( c.expected != -1 )
+   {
+      std::cerr << "received " << ( count - 1 - c.expected ) 
+         << " of " << count << " items\n";
+      return( EXIT_FAILURE );
+   }
+   return( EXIT_SUCCESS );
+}
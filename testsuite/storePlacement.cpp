@@ -0,0 +1,177 @@
+#include <cassert>
+#include <iostream>
+#include <cstdint>
+#include <cstdlib>
+#include <raft>
+#include "edgecheck.tcc"
+
+/**
+ * stores placed on huge pages and/or the consumer's node,
+ * whatever the machine can actually do (explicit huge pages
+ * are rarely reserved, single node boxes skip the binding)
+ * the edge has to work exactly like a plain one. A store big
+ * enough for huge pages has to actually be mapped on them, 
+ * before and after a resize, and one for the consumer has to
+ * be on the node of the consumer's core. Whatever the kernel
+ * can't tell us isn't checked, if that's everything the test
+ * is skipped.
+ */
+static const std::int64_t total( 200000 );
+
+/** placement checks actually made, see main **/
+static int checked( 0 );
+
+/**
+ * huge_ok - false if the store at ptr should be on huge pages
+ * and the kernel says it isn't.
+ */
+static bool huge_ok( const void * const ptr, const char *name )
+{
+   const auto state( raft::placemem::huge_pages( ptr ) );
+   if( state < 0 )
+   {
+      return( true );
+   }
+   checked++;
+   if( state == 0 )
+   {
+      std::cerr << name << ": store isn't on huge pages\n";
+      return( false );
+   }
+   return( true );
+}
+
+/** placed_ring - exposes how much of the store was mapped **/
+template < Type::RingBufferType type > class placed_ring :
+   public RingBuffer< std::int64_t, type, false >
+{
+public:
+   placed_ring( const std::size_t n ) : 
+      RingBuffer< std::int64_t, type, false >( n, 64 )
+   {
+   }
+
+   std::size_t mapped()
+   {
+      return( (this)->datamanager.get()->length_mapped );
+   }
+
+   const void* store()
+   {
+      return( (this)->datamanager.get()->store );
+   }
+};
+
+template < Type::RingBufferType type > bool mapped( const raft::placement &place,
+                                                    const char *name )
+{
+   /** what Allocate::set_placement does for the edge **/
+   placed_ring< type > ring( 1 << 18 );
+   ring.set_placement( place );
+   const auto before( ring.mapped() );
+   const bool huge_before( huge_ok( ring.store(), name ) );
+   volatile bool exit_alloc( false );
+   ring.resize( 1 << 19, 64, exit_alloc );
+   const auto after( ring.mapped() );
+   if( before < ( 1 << 18 ) * sizeof( std::int64_t ) || 
+       after  < ( 1 << 19 ) * sizeof( std::int64_t ) )
+   {
+      std::cerr << name << ": store wasn't mapped, " << before << 
+         " bytes, " << after << " bytes after resize\n";
+      return( false );
+   }
+   return( huge_before && huge_ok( ring.store(), name ) );
+}
+
+/** placed_sink - looks up where the store is on its first run **/
+class placed_sink : public raft::test::sink< std::int64_t >
+{
+public:
+   virtual raft::kstatus run()
+   {
+      if( ! looked )
+      {
+         auto &port( input[ "0" ] );
+         store = &port.peek< std::int64_t >();
+         store_node = raft::placemem::node_of( store );
+         port.unpeek();
+         core_node  = raft::placemem::node_of( 
+            static_cast< int >( (this)->getCoreAssignment() ) );
+         looked = true;
+      }
+      return( raft::test::sink< std::int64_t >::run() );
+   }
+
+   const void *store      = nullptr;
+   int         store_node = -1;
+   int         core_node  = -1;
+   bool        looked     = false;
+};
+
+template < Type::RingBufferType type > bool run( const raft::placement &place,
+                                                 const std::size_t buffer,
+                                                 const char *name )
+{
+   raft::test::source< std::int64_t > p( total );
+   placed_sink c;
+   raft::map m;
+   m.link< raft::order::in, type >( &p, &c, buffer, raft::batch(), place );
+   /** the consumer needs a core for raft::numa::consumer **/
+   m.exe< partition_basic >();
+   if( ! c.seq.complete( name, total ) )
+   {
+      return( false );
+   }
+   if( place.page != raft::pages::base &&
+       buffer * sizeof( std::int64_t ) >= HUGE_PAGE_MIN_STORE &&
+       ! huge_ok( c.store, name ) )
+   {
+      return( false );
+   }
+   if( place.policy != raft::numa::consumer || 
+       raft::placemem::nodes() < 2 || 
+       c.core_node < 0 || c.store_node < 0 )
+   {
+      return( true );
+   }
+   checked++;
+   if( c.store_node != c.core_node )
+   {
+      std::cerr << name << ": store on node " << c.store_node << 
+         ", consumer on node " << c.core_node << "\n";
+      return( false );
+   }
+   return( true );
+}
+
+int
+main()
+{
+   /** 1 << 18 items is a 2MB store, big enough for huge pages **/
+   const raft::placement thp( raft::pages::transparent, raft::numa::consumer );
+   const raft::placement huge( raft::pages::huge );
+   const raft::placement local( raft::numa::consumer );
+   if( ! run< Type::Heap >( thp,   1 << 18, "heap transparent" ) ||
+       ! run< Type::SPSC >( thp,   1 << 18, "spsc transparent" ) ||
+       ! run< Type::Heap >( huge,  1 << 18, "heap huge" ) ||
+       ! run< Type::SPSC >( local, 64,      "spsc local" ) ||
+       ! run< Type::Heap >( thp,   64,      "heap small" ) )
+   {
+      return( EXIT_FAILURE );
+   }
+#if defined __linux
+   if( ! mapped< Type::Heap >( thp,  "heap transparent" ) ||
+       ! mapped< Type::SPSC >( thp,  "spsc transparent" ) ||
+       ! mapped< Type::Heap >( huge, "heap huge" ) )
+   {
+      return( EXIT_FAILURE );
+   }
+#endif
+   if( checked == 0 )
+   {
+      std::cerr << "nothing about the placement could be checked here, skipped\n";
+      /** see SKIP_RETURN_CODE in CMakeLists.txt **/
+      return( 77 );
+   }
+   return( EXIT_SUCCESS );
+}
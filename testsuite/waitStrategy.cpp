@@ -0,0 +1,111 @@
+#include <cassert>
+#include <iostream>
+#include <cstdint>
+#include <cstdlib>
+#include <chrono>
+#include <thread>
+#include <raft>
+
+using type_t = std::int64_t;
+
+/**
+ * the producer stalls every so often so the consumer runs dry
+ * and has to wait, the consumer stalls too so the (tiny) queue
+ * fills and the producer has to wait. Each strategy must get
+ * every item through in order and wake up for the last one.
+ */
+class producer : public raft::kernel
+{
+public:
+   producer( const type_t count ) : raft::kernel(), count( count )
+   {
+      output.addPort< type_t >( "0" );
+   }
+
+   virtual raft::kstatus run()
+   {
+      if( next % 1000 == 0 )
+      {
+         std::this_thread::sleep_for( std::chrono::milliseconds( 2 ) );
+      }
+      output[ "0" ].push( next++ );
+      return( next == count ? raft::stop : raft::proceed );
+   }
+
+private:
+   const type_t count;
+   type_t       next = 0;
+};
+
+class consumer : public raft::kernel
+{
+public:
+   consumer() : raft::kernel()
+   {
+      input.addPort< type_t >( "0" );
+   }
+
+   virtual raft::kstatus run()
+   {
+      type_t item;
+      input[ "0" ].pop( item );
+      if( item != expected++ )
+      {
+         failed = true;
+      }
+      if( expected % 1500 == 0 )
+      {
+         std::this_thread::sleep_for( std::chrono::milliseconds( 2 ) );
+      }
+      return( raft::proceed );
+   }
+
+   type_t expected = 0;
+   bool   failed   = false;
+};
+
+static bool check( const consumer &c, const type_t count, const char *name )
+{
+   if( c.failed || c.expected != count )
+   {
+      std::cerr << name << ": items out of order, got " << c.expected <<
+         " of " << count << "\n";
+      return( false );
+   }
+   return( true );
+}
+
+template < raft::wait::strategy W > bool per_edge( const type_t count,
+                                                   const char *name )
+{
+   producer p( count );
+   consumer c;
+   raft::map m;
+   m.link< raft::order::in, Type::Heap, W >( &p, &c, 4 );
+   m.exe();
+   return( check( c, count, name ) );
+}
+
+int
+main()
+{
+   const type_t count( 20000 );
+   if( ! per_edge< raft::wait::spin >( count, "spin" ) ||
+       ! per_edge< raft::wait::spin_yield >( count, "spin_yield" ) ||
+       ! per_edge< raft::wait::park >( count, "park" ) )
+   {
+      return( EXIT_FAILURE );
+   }
+   /** whole map parks, edge inherits it **/
+   producer p( count );
+   consumer c;
+   raft::map m;
+   m.set_wait( raft::wait::park );
+   m += p >> c;
+   m.exe();
+   if( ! check( c, count, "map park" ) )
+   {
+      return( EXIT_FAILURE );
+   }
+   return( EXIT_SUCCESS );
+}